@@ -0,0 +1,67 @@
+// Test UDP packet rates with and without sendmmsg/recvmmsg batching.
+'use strict';
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const PORT = common.PORT;
+
+// `num` is the number of datagrams to queue up each time, either with one
+// send() call per datagram or with a single sendBatch() call.
+const bench = common.createBenchmark(main, {
+  len: [64, 1024],
+  num: [32],
+  api: ['send', 'sendBatch'],
+  recvBatchSize: [1, 32],
+  type: ['send', 'recv'],
+  dur: [5]
+});
+
+function main({ dur, len, num, api, recvBatchSize, type }) {
+  const chunk = Buffer.allocUnsafe(len);
+  const batch = [];
+  for (var i = 0; i < num; i++)
+    batch.push({ msg: chunk, port: PORT, address: '127.0.0.1' });
+  var sent = 0;
+  var received = 0;
+  const socket = dgram.createSocket({ type: 'udp4', recvBatchSize });
+
+  function onsend() {
+    if (sent++ % num === 0) {
+      for (var i = 0; i < num; i++) {
+        socket.send(chunk, PORT, '127.0.0.1', onsend);
+      }
+    }
+  }
+
+  // Batches may complete synchronously. Queue the next one from a fresh
+  // event loop turn, so that the receive side and the timer that ends the
+  // benchmark get to run.
+  function onsendbatch(err) {
+    if (err === null)
+      sent += num;
+    setImmediate(sendbatch);
+  }
+
+  function sendbatch() {
+    socket.sendBatch(batch, onsendbatch);
+  }
+
+  socket.on('listening', function() {
+    bench.start();
+    if (api === 'send')
+      onsend();
+    else
+      sendbatch();
+
+    setTimeout(function() {
+      bench.end(type === 'send' ? sent : received);
+      process.exit(0);
+    }, dur * 1000);
+  });
+
+  socket.on('message', function() {
+    received++;
+  });
+
+  socket.bind(PORT);
+}
@@ -0,0 +1,58 @@
+// Test UDP packet rates over loopback with and without GSO/GRO offload.
+'use strict';
+
+const common = require('../common.js');
+const dgram = require('dgram');
+const PORT = common.PORT;
+
+// Each round puts `segments` datagrams of `len` bytes on the wire, with one
+// send() per datagram or, with GSO, a single send() of all of them.
+const bench = common.createBenchmark(main, {
+  len: [1200],
+  segments: [16],
+  offload: ['none', 'gso', 'gro', 'gso+gro'],
+  type: ['send', 'recv'],
+  dur: [5]
+});
+
+function main({ dur, len, segments, offload, type }) {
+  const gso = offload.includes('gso');
+  const chunk = Buffer.allocUnsafe(gso ? len * segments : len);
+  var sent = 0;
+  var received = 0;
+  const socket = dgram.createSocket({
+    type: 'udp4',
+    gsoSegmentSize: gso ? len : 0,
+    gro: offload.includes('gro')
+  });
+
+  var outstanding = 0;
+  function onsend() {
+    sent += gso ? segments : 1;
+    if (--outstanding === 0)
+      sendRound();
+  }
+
+  function sendRound() {
+    const sends = gso ? 1 : segments;
+    outstanding = sends;
+    for (var i = 0; i < sends; i++)
+      socket.send(chunk, PORT, '127.0.0.1', onsend);
+  }
+
+  socket.on('listening', function() {
+    bench.start();
+    sendRound();
+
+    setTimeout(function() {
+      bench.end(type === 'send' ? sent : received);
+      process.exit(0);
+    }, dur * 1000);
+  });
+
+  socket.on('message', function(msg, rinfo) {
+    received += Math.ceil(msg.length / (rinfo.segmentSize || msg.length));
+  });
+
+  socket.bind(PORT);
+}
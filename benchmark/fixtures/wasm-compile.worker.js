@@ -0,0 +1,43 @@
+'use strict';
+
+/* global WebAssembly */
+
+const { parentPort, workerData } = require('worker_threads');
+
+function leb128(value) {
+  const bytes = [];
+  do {
+    let byte = value & 0x7f;
+    value >>>= 7;
+    if (value !== 0)
+      byte |= 0x80;
+    bytes.push(byte);
+  } while (value !== 0);
+  return bytes;
+}
+
+function section(id, contents) {
+  return [id, ...leb128(contents.length), ...contents];
+}
+
+// A module with |count| functions that each return 42.
+function buildModule(count) {
+  const types = section(1, [1, 0x60, 0, 1, 0x7f]);
+  const functions = section(3, [...leb128(count), ...new Array(count).fill(0)]);
+  const body = [0, 0x41, 42, 0x0b];
+  const bodies = [];
+  for (let i = 0; i < count; i++)
+    bodies.push(...leb128(body.length), ...body);
+  const code = section(10, [...leb128(count), ...bodies]);
+  return new Uint8Array([
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00,
+    ...types, ...functions, ...code
+  ]);
+}
+
+const bytes = buildModule(workerData.functions);
+
+parentPort.on('message', () => {
+  WebAssembly.compile(bytes).then(() => parentPort.postMessage('done'));
+});
+parentPort.postMessage('ready');
@@ -0,0 +1,58 @@
+// Measures setting up the headers of an IncomingMessage the way the parser
+// hands them over, lazily from a Buffer of values or eagerly from strings,
+// and then using them. `read` picks how much of the headers is used: nothing,
+// one lookup, or repeated lookups after which the cost of the header object's
+// shape dominates.
+'use strict';
+const common = require('../common.js');
+
+const bench = common.createBenchmark(main, {
+  lazy: [0, 1],
+  read: ['none', 'once', 'repeated'],
+  len: [8, 32],
+  n: [1e5]
+}, { flags: ['--expose-internals', '--no-warnings'] });
+
+function main({ lazy, read, len, n }) {
+  const {
+    IncomingMessage,
+    setLazyHeaders
+  } = require('_http_incoming');
+
+  const names = ['Host', 'Content-Type'];
+  for (var i = 2; i < len; i++)
+    names.push(`X-Filler${i}`);
+  const values = names.map((name, i) => `value ${i} of ${name}`);
+  const rawHeaders = [];
+  for (i = 0; i < names.length; i++)
+    rawHeaders.push(names[i], values[i]);
+
+  // The parser's layout: the offsets of the values, then the values.
+  const offsetsLength = (names.length + 1) * 4;
+  const buffer = Buffer.alloc(offsetsLength +
+                              values.reduce((n, v) => n + v.length, 0));
+  const offsets = new Uint32Array(buffer.buffer, buffer.byteOffset,
+                                  names.length + 1);
+  for (i = 0; i < values.length; i++) {
+    buffer.latin1Write(values[i], offsetsLength + offsets[i]);
+    offsets[i + 1] = offsets[i] + values[i].length;
+  }
+
+  const lookups = read === 'repeated' ? 10 : read === 'once' ? 1 : 0;
+  var length = 0;
+
+  bench.start();
+  for (i = 0; i < n; i++) {
+    const msg = new IncomingMessage(null);
+    if (lazy)
+      setLazyHeaders(msg, names, buffer, rawHeaders.length);
+    else
+      msg._addHeaderLines(rawHeaders, rawHeaders.length);
+    for (var j = 0; j < lookups; j++)
+      length += msg.headers.host.length + msg.headers['content-type'].length;
+  }
+  bench.end(n);
+
+  if (lookups > 0 && length === 0)
+    throw new Error('Headers were not read');
+}
@@ -0,0 +1,41 @@
+'use strict';
+
+const common = require('../common.js');
+const http = require('http');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  pipeline: [1, 16, 64],
+  batch: [0, 1],
+  n: [1e5]
+});
+
+function main({ pipeline, batch, n }) {
+  const chunk = Buffer.from(
+    'GET /hello HTTP/1.1\r\nHost: localhost\r\nAccept: */*\r\n\r\n'
+      .repeat(pipeline));
+
+  let conn;
+  let received = 0;
+  const options = { batchPipelinedRequests: batch === 1 };
+  const server = http.createServer(options, (req, res) => {
+    res.end();
+    if (++received % pipeline !== 0)
+      return;
+    if (received >= n) {
+      bench.end(received);
+      conn.destroy();
+      server.close();
+    } else {
+      conn.write(chunk);
+    }
+  });
+
+  server.listen(common.PORT, () => {
+    conn = net.connect(common.PORT, () => {
+      bench.start();
+      conn.write(chunk);
+    });
+    conn.resume();
+  });
+}
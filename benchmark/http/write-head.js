@@ -0,0 +1,35 @@
+'use strict';
+
+const common = require('../common.js');
+const { ServerResponse } = require('http');
+
+const bench = common.createBenchmark(main, {
+  fields: [2, 10, 50],
+  api: ['writeHead', 'setHeader'],
+  n: [1e5]
+});
+
+// writeHead: writeHead(status, {...}), the fields are validated while the
+// header is serialized.
+// setHeader: setHeader(...) for each field, then writeHead(status).
+function main({ fields, api, n }) {
+  const req = { method: 'GET', httpVersionMajor: 1, httpVersionMinor: 1 };
+  const headers = {};
+  for (var i = 0; i < fields; i++)
+    headers[`X-Header-${i}`] = `some header value ${i}`;
+  const names = Object.keys(headers);
+
+  bench.start();
+  for (i = 0; i < n; i++) {
+    const res = new ServerResponse(req);
+    res.sendDate = false;
+    if (api === 'writeHead') {
+      res.writeHead(200, headers);
+    } else {
+      for (var j = 0; j < names.length; j++)
+        res.setHeader(names[j], headers[names[j]]);
+      res.writeHead(200);
+    }
+  }
+  bench.end(n);
+}
@@ -0,0 +1,107 @@
+// Measures how often cluster workers that share a listening socket wake up
+// for every connection they accept. Without exclusive accepts every incoming
+// connection wakes up all idle workers while only one of them gets it.
+//
+// The reported number is wakeups per accepted connection, lower is better.
+'use strict';
+
+const cluster = require('cluster');
+const net = require('net');
+
+if (cluster.isMaster) {
+  const common = require('../common.js');
+  const bench = common.createBenchmark(main, {
+    workers: [4, 8],
+    exclusive: ['true', 'false'],
+    concurrency: [1, 32],
+    conns: [5000]
+  });
+
+  function main({ workers, exclusive, concurrency, conns }) {
+    cluster.schedulingPolicy = cluster.SCHED_NONE;
+    cluster.setupMaster({ args: [String(exclusive === 'true')] });
+
+    var port;
+    var start;
+    var ready = 0;
+    for (var i = 0; i < workers; i++) {
+      cluster.fork().on('message', function onReady(msg) {
+        if (msg.cmd !== 'ready')
+          return;
+        this.removeListener('message', onReady);
+        port = msg.port;
+        if (++ready === workers)
+          run();
+      });
+    }
+
+    function run() {
+      var started = 0;
+      var finished = 0;
+      for (var id in cluster.workers)
+        cluster.workers[id].send({ cmd: 'start' });
+
+      start = process.hrtime();
+      for (var i = 0; i < concurrency; i++)
+        connect();
+
+      function connect() {
+        if (started === conns)
+          return;
+        started++;
+        net.connect(port).on('close', () => {
+          if (++finished === conns)
+            collect();
+          else
+            connect();
+        }).resume();
+      }
+    }
+
+    function collect() {
+      const elapsed = process.hrtime(start);
+      var wakeups = 0;
+      var accepts = 0;
+      var pending = workers;
+      for (var id in cluster.workers) {
+        const worker = cluster.workers[id];
+        worker.on('message', (msg) => {
+          if (msg.cmd !== 'stats')
+            return;
+          wakeups += msg.wakeups;
+          accepts += msg.accepts;
+          worker.disconnect();
+          if (--pending === 0)
+            bench.report(wakeups / accepts, elapsed);
+        });
+        worker.send({ cmd: 'stats' });
+      }
+    }
+  }
+} else {
+  const { performance } = require('perf_hooks');
+  const exclusiveAccept = process.argv[2] === 'true';
+  var accepts = 0;
+  var iterations = 0;
+
+  const server = net.createServer((socket) => {
+    accepts++;
+    socket.end();
+  });
+
+  server.listen({ port: 0, exclusiveAccept }, () => {
+    process.send({ cmd: 'ready', port: server.address().port });
+  });
+
+  process.on('message', (msg) => {
+    if (msg.cmd === 'start') {
+      iterations = performance.eventLoopPhases().iterations;
+    } else if (msg.cmd === 'stats') {
+      process.send({
+        cmd: 'stats',
+        accepts,
+        wakeups: performance.eventLoopPhases().iterations - iterations
+      });
+    }
+  });
+}
@@ -0,0 +1,56 @@
+// Measures small reads spread over many connections, which is what a server
+// with mostly idle keep-alive connections sees.
+'use strict';
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  conns: [100, 1000],
+  len: [64, 1024],
+  n: [1e5]
+});
+
+function main({ conns, len, n }) {
+  const chunk = Buffer.alloc(len, 'x');
+  const clients = [];
+  var received = 0;
+  var sent = 0;
+  var connected = 0;
+
+  const server = net.createServer((socket) => {
+    socket.on('data', (data) => {
+      received += data.length;
+      // Wait for each chunk to arrive, so that every chunk is one read.
+      if (received % len === 0)
+        next();
+    });
+  });
+
+  function next() {
+    if (sent === n) {
+      if (received === n * len)
+        done();
+      return;
+    }
+    clients[sent++ % conns].write(chunk);
+  }
+
+  function done() {
+    bench.end(n);
+    for (const client of clients)
+      client.destroy();
+    server.close();
+  }
+
+  server.listen(common.PORT, () => {
+    for (var i = 0; i < conns; i++) {
+      const client = net.connect(common.PORT, () => {
+        if (++connected === conns) {
+          bench.start();
+          next();
+        }
+      });
+      clients.push(client);
+    }
+  });
+}
@@ -0,0 +1,28 @@
+// Measures re-arming the idle timeouts of many sockets, which happens on
+// every read and write.
+'use strict';
+const common = require('../common.js');
+const net = require('net');
+
+const bench = common.createBenchmark(main, {
+  sockets: [1e3, 1e5],
+  timeout: [5000, 120000],
+  n: [1e6]
+});
+
+function main({ sockets, timeout, n }) {
+  const list = [];
+  for (var i = 0; i < sockets; i++) {
+    const socket = new net.Socket();
+    socket.setTimeout(timeout);
+    list.push(socket);
+  }
+
+  bench.start();
+  for (i = 0; i < n; i++)
+    list[i % sockets]._unrefTimer();
+  bench.end(n);
+
+  for (i = 0; i < sockets; i++)
+    list[i].setTimeout(0);
+}
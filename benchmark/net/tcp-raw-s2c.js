@@ -22,7 +22,11 @@ function main({ dur, len, type }) {
     TCPConnectWrap,
     constants: TCPConstants
   } = common.binding('tcp_wrap');
-  const { WriteWrap } = common.binding('stream_wrap');
+  const {
+    WriteWrap,
+    streamBaseState,
+    kReadBytesOrError
+  } = common.binding('stream_wrap');
   const PORT = common.PORT;
 
   const serverHandle = new TCP(TCPConstants.SERVER);
@@ -117,7 +121,7 @@ function main({ dur, len, type }) {
 
         // Don't slice the buffer. The point of this is to isolate, not
         // simulate real traffic.
-        bytes += buffer.byteLength;
+        bytes += streamBaseState[kReadBytesOrError];
       };
 
       clientHandle.readStart();
@@ -3,7 +3,8 @@ const common = require('../common.js');
 const bench = common.createBenchmark(main, {
   dur: [5],
   type: ['buf', 'asc', 'utf'],
-  size: [2, 1024, 1024 * 1024]
+  size: [2, 1024, 1024 * 1024],
+  kernel: [0, 1]
 });
 
 const path = require('path');
@@ -12,7 +13,7 @@ const cert_dir = path.resolve(__dirname, '../../test/fixtures');
 var options;
 const tls = require('tls');
 
-function main({ dur, type, size }) {
+function main({ dur, type, size, kernel }) {
   var encoding;
   var server;
   var chunk;
@@ -42,7 +43,11 @@ function main({ dur, type, size }) {
   server = tls.createServer(options, onConnection);
   var conn;
   server.listen(common.PORT, function() {
-    const opt = { port: common.PORT, rejectUnauthorized: false };
+    const opt = {
+      port: common.PORT,
+      rejectUnauthorized: false,
+      kernelTLS: kernel === 1
+    };
     conn = tls.connect(opt, function() {
       setTimeout(done, dur * 1000);
       bench.start();
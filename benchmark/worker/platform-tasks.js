@@ -0,0 +1,62 @@
+'use strict';
+
+// Compiling WebAssembly in many workers at once keeps V8's background
+// compile tasks, which all go through the platform's worker task queue,
+// busy from several threads.
+
+const common = require('../common.js');
+const path = require('path');
+const bench = common.createBenchmark(main, {
+  workers: [1, 4, 16],
+  functions: [100],
+  n: [100]
+});
+
+const workerPath =
+  path.resolve(__dirname, '..', 'fixtures', 'wasm-compile.worker.js');
+
+function main(conf) {
+  const { Worker } = require('worker_threads');
+
+  const n = +conf.n;
+  const workers = +conf.workers;
+  var readies = 0;
+  var rounds = 0;
+  var done = 0;
+
+  const workerObjs = [];
+
+  for (var i = 0; i < workers; ++i) {
+    const worker = new Worker(workerPath, {
+      workerData: { functions: +conf.functions }
+    });
+    workerObjs.push(worker);
+    worker.on('message', onMessage);
+  }
+
+  function onMessage(msg) {
+    if (msg === 'ready') {
+      if (++readies === workers) {
+        bench.start();
+        compile();
+      }
+      return;
+    }
+    if (++done === workers) {
+      done = 0;
+      compile();
+    }
+  }
+
+  function compile() {
+    if (rounds++ === n) {
+      bench.end(n * workers);
+      for (const worker of workerObjs) {
+        worker.unref();
+      }
+      return;
+    }
+    for (const worker of workerObjs)
+      worker.postMessage('compile');
+  }
+}
@@ -234,11 +234,25 @@ typedef struct uv_cpu_info_s uv_cpu_info_t;
 typedef struct uv_interface_address_s uv_interface_address_t;
 typedef struct uv_dirent_s uv_dirent_t;
 typedef struct uv_passwd_s uv_passwd_t;
+typedef struct uv_loop_metrics_s uv_loop_metrics_t;
+typedef struct uv_work_timing_s uv_work_timing_t;
 
 typedef enum {
-  UV_LOOP_BLOCK_SIGNAL
+  UV_LOOP_BLOCK_SIGNAL,
+  UV_METRICS_IDLE_TIME
 } uv_loop_option;
 
+typedef enum {
+  UV_LOOP_PHASE_TIMERS,
+  UV_LOOP_PHASE_PENDING,
+  UV_LOOP_PHASE_PREPARE,
+  UV_LOOP_PHASE_POLL_WAIT,
+  UV_LOOP_PHASE_POLL,
+  UV_LOOP_PHASE_CHECK,
+  UV_LOOP_PHASE_CLOSING,
+  UV_LOOP_PHASE_MAX
+} uv_loop_phase;
+
 typedef enum {
   UV_RUN_DEFAULT = 0,
   UV_RUN_ONCE,
@@ -277,6 +291,15 @@ UV_EXTERN void uv_loop_delete(uv_loop_t*);
 UV_EXTERN size_t uv_loop_size(void);
 UV_EXTERN int uv_loop_alive(const uv_loop_t* loop);
 UV_EXTERN int uv_loop_configure(uv_loop_t* loop, uv_loop_option option, ...);
+
+struct uv_loop_metrics_s {
+  uint64_t iterations;
+  uint64_t phase_time[UV_LOOP_PHASE_MAX];  /* Nanoseconds. */
+};
+
+UV_EXTERN uint64_t uv_metrics_idle_time(uv_loop_t* loop);
+UV_EXTERN int uv_loop_metrics(const uv_loop_t* loop,
+                              uv_loop_metrics_t* metrics);
 UV_EXTERN int uv_loop_fork(uv_loop_t* loop);
 
 UV_EXTERN int uv_run(uv_loop_t*, uv_run_mode mode);
@@ -517,6 +540,7 @@ UV_EXTERN int uv_is_readable(const uv_stream_t* handle);
 UV_EXTERN int uv_is_writable(const uv_stream_t* handle);
 
 UV_EXTERN int uv_stream_set_blocking(uv_stream_t* handle, int blocking);
+UV_EXTERN int uv_stream_set_exclusive_accept(uv_stream_t* handle, int enable);
 
 UV_EXTERN int uv_is_closing(const uv_handle_t* handle);
 
@@ -540,10 +564,25 @@ UV_EXTERN int uv_tcp_keepalive(uv_tcp_t* handle,
                                int enable,
                                unsigned int delay);
 UV_EXTERN int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable);
+UV_EXTERN int uv_tcp_zerocopy(uv_tcp_t* handle,
+                              int enable,
+                              unsigned int min_size);
+UV_EXTERN int uv_tcp_fastopen(uv_tcp_t* handle, unsigned int qlen);
+UV_EXTERN int uv_tcp_fastopen_connect(uv_tcp_t* handle, int enable);
+UV_EXTERN int uv_tcp_defer_accept(uv_tcp_t* handle, unsigned int timeout);
+UV_EXTERN int uv_tcp_accept_backlog(const uv_tcp_t* handle,
+                                    unsigned int* count);
 
 enum uv_tcp_flags {
   /* Used with uv_tcp_bind, when an IPv6 address is used. */
-  UV_TCP_IPV6ONLY = 1
+  UV_TCP_IPV6ONLY = 1,
+  /*
+   * Used with uv_tcp_bind. Lets several handles, usually in different
+   * processes, listen on the same address and port. The kernel distributes
+   * incoming connections among them. Only supported where the kernel does
+   * that load balancing: Linux 3.9+, FreeBSD 12+ and DragonFly BSD.
+   */
+  UV_TCP_REUSEPORT = 2
 };
 
 UV_EXTERN int uv_tcp_bind(uv_tcp_t* handle,
@@ -589,7 +628,29 @@ enum uv_udp_flags {
    * (provided they all set the flag) but only the last one to bind will receive
    * any traffic, in effect "stealing" the port from the previous listener.
    */
-  UV_UDP_REUSEADDR = 4
+  UV_UDP_REUSEADDR = 4,
+  /*
+   * Indicates that the message was received by recvmmsg, so the buffer provided
+   * must not be freed by the recv_cb callback.
+   */
+  UV_UDP_MMSG_CHUNK = 8,
+  /*
+   * Indicates that the buffer provided has been fully utilized by recvmmsg and
+   * that it should now be freed by the recv_cb callback. When this flag is set
+   * in uv_udp_recv_cb, nread will always be 0 and addr will always be NULL.
+   */
+  UV_UDP_MMSG_FREE = 16,
+  /*
+   * Indicates if SO_REUSEPORT will be set when binding the handle, so that
+   * the kernel distributes the datagrams among all handles bound to the same
+   * address and port. Platform support is the same as for UV_TCP_REUSEPORT.
+   */
+  UV_UDP_REUSEPORT = 32,
+  /*
+   * Indicates that recvmmsg should be used, if available. Used in
+   * uv_udp_init_ex.
+   */
+  UV_UDP_RECVMMSG = 256
 };
 
 typedef void (*uv_udp_send_cb)(uv_udp_send_t* req, int status);
@@ -643,6 +704,9 @@ UV_EXTERN int uv_udp_set_multicast_interface(uv_udp_t* handle,
                                              const char* interface_addr);
 UV_EXTERN int uv_udp_set_broadcast(uv_udp_t* handle, int on);
 UV_EXTERN int uv_udp_set_ttl(uv_udp_t* handle, int ttl);
+UV_EXTERN int uv_udp_set_gso(uv_udp_t* handle, unsigned int segment_size);
+UV_EXTERN int uv_udp_set_gro(uv_udp_t* handle, int on);
+UV_EXTERN size_t uv_udp_get_gro_segment_size(const uv_udp_t* handle);
 UV_EXTERN int uv_udp_send(uv_udp_send_t* req,
                           uv_udp_t* handle,
                           const uv_buf_t bufs[],
@@ -653,6 +717,12 @@ UV_EXTERN int uv_udp_try_send(uv_udp_t* handle,
                               const uv_buf_t bufs[],
                               unsigned int nbufs,
                               const struct sockaddr* addr);
+UV_EXTERN int uv_udp_try_send2(uv_udp_t* handle,
+                               unsigned int count,
+                               uv_buf_t* bufs[/*count*/],
+                               unsigned int nbufs[/*count*/],
+                               struct sockaddr* addrs[/*count*/],
+                               unsigned int flags);
 UV_EXTERN int uv_udp_recv_start(uv_udp_t* handle,
                                 uv_alloc_cb alloc_cb,
                                 uv_udp_recv_cb recv_cb);
@@ -1015,8 +1085,38 @@ UV_EXTERN int uv_queue_work(uv_loop_t* loop,
                             uv_work_cb work_cb,
                             uv_after_work_cb after_work_cb);
 
+/*
+ * Threadpool identifiers. Ids from UV_THREADPOOL_USER up to
+ * UV_THREADPOOL_MAX - 1 are free for the embedder to assign.
+ */
+#define UV_THREADPOOL_MAX 8
+
+typedef enum {
+  UV_THREADPOOL_DEFAULT = 0,
+  UV_THREADPOOL_FS,
+  UV_THREADPOOL_DNS,
+  UV_THREADPOOL_USER
+} uv_threadpool_id;
+
+UV_EXTERN int uv_threadpool_set_size(unsigned int pool, unsigned int size);
+UV_EXTERN int uv_queue_work_in(uv_loop_t* loop,
+                               uv_work_t* req,
+                               unsigned int pool,
+                               uv_work_cb work_cb,
+                               uv_after_work_cb after_work_cb);
+
 UV_EXTERN int uv_cancel(uv_req_t* req);
 
+struct uv_work_timing_s {
+  uint64_t submit_time;
+  uint64_t start_time;
+  uint64_t end_time;
+  uint64_t done_time;
+};
+
+UV_EXTERN int uv_req_get_work_timing(const uv_req_t* req,
+                                     uv_work_timing_t* timing);
+
 
 struct uv_cpu_times_s {
   uint64_t user;
@@ -1584,9 +1684,11 @@ struct uv_loop_s {
   unsigned int active_handles;
   void* handle_queue[2];
   union {
-    void* unused[2];
+    void* unused;
     unsigned int count;
   } active_reqs;
+  /* Internal storage for future extensions. */
+  void* internal_fields;
   /* Internal flag to signal loop stop. */
   unsigned int stop_flag;
   UV_LOOP_PRIVATE_FIELDS
@@ -457,7 +457,8 @@ typedef struct {
   uv_udp_recv_cb recv_cb;                                                     \
   uv_alloc_cb alloc_cb;                                                       \
   LPFN_WSARECV func_wsarecv;                                                  \
-  LPFN_WSARECVFROM func_wsarecvfrom;
+  LPFN_WSARECVFROM func_wsarecvfrom;                                          \
+  size_t gro_segment_size;
 
 #define uv_pipe_server_fields                                                 \
   int pending_instances;                                                      \
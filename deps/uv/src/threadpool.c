@@ -26,24 +26,72 @@
 #endif
 
 #include <stdlib.h>
+#include <string.h>  /* memset */
 
 #define MAX_THREADPOOL_SIZE 128
 
+/* The timestamps behind uv_req_get_work_timing().  They live in the reserved
+ * fields of the request, which work requests do not use otherwise, so that
+ * struct uv__work and the public request structs keep their size.  To fit on
+ * 32-bit platforms, only the submit time is stored in full; every later stage
+ * is stored as 1 + the microseconds since the last stage reached before it,
+ * and 0 for a stage that was not reached.
+ */
+typedef struct {
+  uint32_t submit_time[2];  /* uv_hrtime(), low and high half; 0 if not
+                               submitted to the threadpool. */
+  uint32_t stage_us[3];     /* enum uv__work_stage */
+} uv__work_timing_t;
+
+STATIC_ASSERT(sizeof(uv__work_timing_t) <= sizeof(((uv_req_t*) 0)->reserved));
+
+#define uv__work_timing(req) ((uv__work_timing_t*) (req)->reserved)
+
+/* Every worker owns a queue that is protected by its own lock.  Submitters
+ * hand new work to an idle worker when there is one and otherwise spread it
+ * over the busy workers' queues.  A worker that runs out of work steals from
+ * its peers before it goes to sleep, so no work sits in a queue while another
+ * thread is idle.  Only the worker that receives an item is woken up.
+ *
+ * To avoid deadlock with uv_cancel() it's crucial that a worker never holds
+ * more than one of the locks below, or any of them and the loop-local mutex,
+ * at the same time.  uv__work_cancel() takes all of them in a fixed order.
+ */
+struct uv__worker {
+  uv_thread_t thread;
+  uv_mutex_t mutex;
+  uv_cond_t cond;
+  QUEUE wq;
+  QUEUE idle_queue;  /* Protected by |pool->idle_mutex|. */
+  struct uv__threadpool* pool;
+  uv_sem_t* started;
+  int wakeup;        /* Protected by |mutex|. */
+  int exiting;       /* Protected by |mutex|. */
+};
+
+/* Pools other than the default one only get threads of their own when they
+ * have been given a size with uv_threadpool_set_size(), otherwise their work
+ * runs on the default pool.
+ */
+struct uv__threadpool {
+  uv_mutex_t idle_mutex;
+  uv_mutex_t slow_io_mutex;
+  unsigned int slow_io_work_running;
+  unsigned int nthreads;
+  struct uv__worker* workers;
+  QUEUE idle_workers;
+  QUEUE slow_io_pending_wq;
+};
+
 static uv_once_t once = UV_ONCE_INIT;
-static uv_cond_t cond;
-static uv_mutex_t mutex;
-static unsigned int idle_threads;
-static unsigned int slow_io_work_running;
-static unsigned int nthreads;
-static uv_thread_t* threads;
-static uv_thread_t default_threads[4];
-static QUEUE exit_message;
-static QUEUE wq;
-static QUEUE run_slow_work_message;
-static QUEUE slow_io_pending_wq;
-
-static unsigned int slow_work_thread_threshold(void) {
-  return (nthreads + 1) / 2;
+static int started;
+static unsigned int pool_sizes[UV_THREADPOOL_MAX];
+static struct uv__threadpool pools[UV_THREADPOOL_MAX];
+static struct uv__threadpool* pool_map[UV_THREADPOOL_MAX];
+static struct uv__worker default_workers[4];
+
+static unsigned int slow_work_thread_threshold(struct uv__threadpool* pool) {
+  return (pool->nthreads + 1) / 2;
 }
 
 static void uv__cancelled(struct uv__work* w) {
@@ -51,73 +99,205 @@ static void uv__cancelled(struct uv__work* w) {
 }
 
 
-/* To avoid deadlock with uv_cancel() it's crucial that the worker
- * never holds the global mutex and the loop-local mutex at the same time.
+/* Take the oldest item off |wk|'s queue, or NULL if there is none. */
+static QUEUE* pop_work(struct uv__worker* wk) {
+  QUEUE* q;
+
+  uv_mutex_lock(&wk->mutex);
+
+  if (QUEUE_EMPTY(&wk->wq)) {
+    uv_mutex_unlock(&wk->mutex);
+    return NULL;
+  }
+
+  q = QUEUE_HEAD(&wk->wq);
+  QUEUE_REMOVE(q);
+  QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is executing. */
+  uv_mutex_unlock(&wk->mutex);
+
+  return q;
+}
+
+
+/* Slow I/O work may only occupy up to half the threads at any time so that it
+ * can't starve the faster work items.
  */
-static void worker(void* arg) {
-  struct uv__work* w;
+static QUEUE* pop_slow_work(struct uv__threadpool* pool) {
   QUEUE* q;
-  int is_slow_work;
 
-  uv_sem_post((uv_sem_t*) arg);
-  arg = NULL;
+  uv_mutex_lock(&pool->slow_io_mutex);
 
-  uv_mutex_lock(&mutex);
-  for (;;) {
-    /* `mutex` should always be locked at this point. */
-
-    /* Keep waiting while either no work is present or only slow I/O
-       and we're at the threshold for that. */
-    while (QUEUE_EMPTY(&wq) ||
-           (QUEUE_HEAD(&wq) == &run_slow_work_message &&
-            QUEUE_NEXT(&run_slow_work_message) == &wq &&
-            slow_io_work_running >= slow_work_thread_threshold())) {
-      idle_threads += 1;
-      uv_cond_wait(&cond, &mutex);
-      idle_threads -= 1;
+  if (QUEUE_EMPTY(&pool->slow_io_pending_wq) ||
+      pool->slow_io_work_running >= slow_work_thread_threshold(pool)) {
+    uv_mutex_unlock(&pool->slow_io_mutex);
+    return NULL;
+  }
+
+  q = QUEUE_HEAD(&pool->slow_io_pending_wq);
+  QUEUE_REMOVE(q);
+  QUEUE_INIT(q);
+  pool->slow_io_work_running++;
+  uv_mutex_unlock(&pool->slow_io_mutex);
+
+  return q;
+}
+
+
+static QUEUE* steal_work(struct uv__worker* self) {
+  struct uv__threadpool* pool;
+  unsigned int base;
+  unsigned int i;
+  QUEUE* q;
+
+  pool = self->pool;
+  base = self - pool->workers;
+
+  for (i = 1; i < pool->nthreads; i++) {
+    q = pop_work(&pool->workers[(base + i) % pool->nthreads]);
+    if (q != NULL)
+      return q;
+  }
+
+  return NULL;
+}
+
+
+/* Regular and slow I/O work take turns so neither can starve the other.  A
+ * thread that just woke up runs the work it was handed first.
+ */
+static QUEUE* find_work(struct uv__worker* self,
+                        int slow_first,
+                        int* is_slow_work) {
+  QUEUE* q;
+
+  if (slow_first) {
+    q = pop_slow_work(self->pool);
+    if (q != NULL) {
+      *is_slow_work = 1;
+      return q;
     }
+  }
 
-    q = QUEUE_HEAD(&wq);
-    if (q == &exit_message) {
-      uv_cond_signal(&cond);
-      uv_mutex_unlock(&mutex);
-      break;
+  q = pop_work(self);
+
+  if (q == NULL)
+    q = steal_work(self);
+
+  if (q == NULL && !slow_first) {
+    q = pop_slow_work(self->pool);
+    if (q != NULL) {
+      *is_slow_work = 1;
+      return q;
     }
+  }
+
+  *is_slow_work = 0;
+  return q;
+}
+
+
+/* Returns an idle worker and takes it off the idle list, or NULL when all
+ * workers are busy.  The caller is responsible for waking it up.
+ */
+static struct uv__worker* pop_idle_worker(struct uv__threadpool* pool) {
+  struct uv__worker* wk;
+  QUEUE* q;
+
+  wk = NULL;
+  uv_mutex_lock(&pool->idle_mutex);
 
+  if (!QUEUE_EMPTY(&pool->idle_workers)) {
+    q = QUEUE_HEAD(&pool->idle_workers);
     QUEUE_REMOVE(q);
-    QUEUE_INIT(q);  /* Signal uv_cancel() that the work req is executing. */
-
-    is_slow_work = 0;
-    if (q == &run_slow_work_message) {
-      /* If we're at the slow I/O threshold, re-schedule until after all
-         other work in the queue is done. */
-      if (slow_io_work_running >= slow_work_thread_threshold()) {
-        QUEUE_INSERT_TAIL(&wq, q);
-        continue;
-      }
+    QUEUE_INIT(q);
+    wk = QUEUE_DATA(q, struct uv__worker, idle_queue);
+  }
 
-      /* If we encountered a request to run slow I/O work but there is none
-         to run, that means it's cancelled => Start over. */
-      if (QUEUE_EMPTY(&slow_io_pending_wq))
-        continue;
+  uv_mutex_unlock(&pool->idle_mutex);
+
+  return wk;
+}
 
-      is_slow_work = 1;
-      slow_io_work_running++;
 
-      q = QUEUE_HEAD(&slow_io_pending_wq);
-      QUEUE_REMOVE(q);
-      QUEUE_INIT(q);
+static void wake_worker(struct uv__worker* wk) {
+  uv_mutex_lock(&wk->mutex);
 
-      /* If there is more slow I/O work, schedule it to be run as well. */
-      if (!QUEUE_EMPTY(&slow_io_pending_wq)) {
-        QUEUE_INSERT_TAIL(&wq, &run_slow_work_message);
-        if (idle_threads > 0)
-          uv_cond_signal(&cond);
+  /* Coalesce wakeups, one signal per sleep is enough. */
+  if (!wk->wakeup) {
+    wk->wakeup = 1;
+    uv_cond_signal(&wk->cond);
+  }
+
+  uv_mutex_unlock(&wk->mutex);
+}
+
+
+static void wake_idle_worker(struct uv__threadpool* pool) {
+  struct uv__worker* wk;
+
+  wk = pop_idle_worker(pool);
+  if (wk != NULL)
+    wake_worker(wk);
+}
+
+
+static void worker(void* arg) {
+  struct uv__threadpool* pool;
+  struct uv__worker* self;
+  struct uv__work* w;
+  QUEUE* q;
+  int is_slow_work;
+  int more_slow_work;
+  int slow_first;
+
+  self = arg;
+  pool = self->pool;
+  uv_sem_post(self->started);
+  arg = NULL;
+
+  is_slow_work = 0;
+  slow_first = 0;
+
+  for (;;) {
+    q = find_work(self, slow_first, &is_slow_work);
+
+    if (q == NULL) {
+      /* Advertise ourselves as idle, then look once more.  Work that was
+       * posted in the meantime is either visible now or was handed to us.
+       */
+      uv_mutex_lock(&pool->idle_mutex);
+      QUEUE_INSERT_HEAD(&pool->idle_workers, &self->idle_queue);
+      uv_mutex_unlock(&pool->idle_mutex);
+
+      q = find_work(self, 0, &is_slow_work);
+
+      if (q == NULL) {
+        uv_mutex_lock(&self->mutex);
+        while (QUEUE_EMPTY(&self->wq) && !self->wakeup && !self->exiting)
+          uv_cond_wait(&self->cond, &self->mutex);
+        self->wakeup = 0;
+        uv_mutex_unlock(&self->mutex);
       }
-    }
 
-    uv_mutex_unlock(&mutex);
+      /* No-op if whoever woke us up already took us off the list. */
+      uv_mutex_lock(&pool->idle_mutex);
+      QUEUE_REMOVE(&self->idle_queue);
+      QUEUE_INIT(&self->idle_queue);
+      uv_mutex_unlock(&pool->idle_mutex);
+
+      if (q == NULL) {
+        uv_mutex_lock(&self->mutex);
+        if (self->exiting) {
+          uv_mutex_unlock(&self->mutex);
+          break;
+        }
+        uv_mutex_unlock(&self->mutex);
+        slow_first = 0;
+        continue;
+      }
+    }
 
+    slow_first = !is_slow_work;
     w = QUEUE_DATA(q, struct uv__work, wq);
     w->work(w);
 
@@ -128,101 +308,169 @@ static void worker(void* arg) {
     uv_async_send(&w->loop->wq_async);
     uv_mutex_unlock(&w->loop->wq_mutex);
 
-    /* Lock `mutex` since that is expected at the start of the next
-     * iteration. */
-    uv_mutex_lock(&mutex);
     if (is_slow_work) {
-      /* `slow_io_work_running` is protected by `mutex`. */
-      slow_io_work_running--;
+      uv_mutex_lock(&pool->slow_io_mutex);
+      pool->slow_io_work_running--;
+      more_slow_work = !QUEUE_EMPTY(&pool->slow_io_pending_wq);
+      uv_mutex_unlock(&pool->slow_io_mutex);
+
+      /* Let an idle thread pick up the next slow I/O work item right away. */
+      if (more_slow_work)
+        wake_idle_worker(pool);
     }
   }
 }
 
 
-static void post(QUEUE* q, enum uv__work_kind kind) {
-  uv_mutex_lock(&mutex);
+static void post(struct uv__threadpool* pool,
+                 QUEUE* q,
+                 enum uv__work_kind kind,
+                 unsigned int hint) {
+  struct uv__worker* wk;
+  int runnable;
+
   if (kind == UV__WORK_SLOW_IO) {
     /* Insert into a separate queue. */
-    QUEUE_INSERT_TAIL(&slow_io_pending_wq, q);
-    if (!QUEUE_EMPTY(&run_slow_work_message)) {
-      /* Running slow I/O tasks is already scheduled => Nothing to do here.
-         The worker that runs said other task will schedule this one as well. */
-      uv_mutex_unlock(&mutex);
-      return;
-    }
-    q = &run_slow_work_message;
+    uv_mutex_lock(&pool->slow_io_mutex);
+    QUEUE_INSERT_TAIL(&pool->slow_io_pending_wq, q);
+    runnable = pool->slow_io_work_running < slow_work_thread_threshold(pool);
+    uv_mutex_unlock(&pool->slow_io_mutex);
+
+    if (runnable)
+      wake_idle_worker(pool);
+
+    return;
+  }
+
+  wk = pop_idle_worker(pool);
+
+  if (wk == NULL) {
+    /* Everyone is busy.  The first worker to finish will find it, either in
+     * its own queue or by stealing it.
+     */
+    wk = &pool->workers[hint % pool->nthreads];
+    uv_mutex_lock(&wk->mutex);
+    QUEUE_INSERT_TAIL(&wk->wq, q);
+    uv_mutex_unlock(&wk->mutex);
+
+    /* A worker may have gone idle after we looked, but before the work was
+     * inserted, in which case its last look missed it.  It has advertised
+     * itself by now, so wake it up.  Workers that go idle later will see
+     * the work when they look again.
+     */
+    wake_idle_worker(pool);
+    return;
   }
 
-  QUEUE_INSERT_TAIL(&wq, q);
-  if (idle_threads > 0)
-    uv_cond_signal(&cond);
-  uv_mutex_unlock(&mutex);
+  uv_mutex_lock(&wk->mutex);
+  QUEUE_INSERT_TAIL(&wk->wq, q);
+  if (!wk->wakeup) {
+    wk->wakeup = 1;
+    uv_cond_signal(&wk->cond);
+  }
+  uv_mutex_unlock(&wk->mutex);
 }
 
 
 #ifndef _WIN32
-UV_DESTRUCTOR(static void cleanup(void)) {
+static void cleanup_pool(struct uv__threadpool* pool) {
   unsigned int i;
 
-  if (nthreads == 0)
+  if (pool->nthreads == 0)
     return;
 
-  post(&exit_message, UV__WORK_CPU);
+  for (i = 0; i < pool->nthreads; i++) {
+    uv_mutex_lock(&pool->workers[i].mutex);
+    pool->workers[i].exiting = 1;
+    uv_cond_signal(&pool->workers[i].cond);
+    uv_mutex_unlock(&pool->workers[i].mutex);
+  }
 
-  for (i = 0; i < nthreads; i++)
-    if (uv_thread_join(threads + i))
+  for (i = 0; i < pool->nthreads; i++)
+    if (uv_thread_join(&pool->workers[i].thread))
       abort();
 
-  if (threads != default_threads)
-    uv__free(threads);
+  for (i = 0; i < pool->nthreads; i++) {
+    uv_mutex_destroy(&pool->workers[i].mutex);
+    uv_cond_destroy(&pool->workers[i].cond);
+  }
+
+  if (pool->workers != default_workers)
+    uv__free(pool->workers);
+
+  uv_mutex_destroy(&pool->idle_mutex);
+  uv_mutex_destroy(&pool->slow_io_mutex);
+
+  pool->workers = NULL;
+  pool->nthreads = 0;
+}
+
 
-  uv_mutex_destroy(&mutex);
-  uv_cond_destroy(&cond);
+UV_DESTRUCTOR(static void cleanup(void)) {
+  unsigned int i;
 
-  threads = NULL;
-  nthreads = 0;
+  for (i = 0; i < ARRAY_SIZE(pools); i++)
+    cleanup_pool(&pools[i]);
 }
 #endif
 
 
-static void init_threads(void) {
+static void init_pool(struct uv__threadpool* pool, unsigned int nthreads) {
+  struct uv__worker* wk;
   unsigned int i;
-  const char* val;
   uv_sem_t sem;
 
-  nthreads = ARRAY_SIZE(default_threads);
-  val = getenv("UV_THREADPOOL_SIZE");
-  if (val != NULL)
-    nthreads = atoi(val);
-  if (nthreads == 0)
-    nthreads = 1;
   if (nthreads > MAX_THREADPOOL_SIZE)
     nthreads = MAX_THREADPOOL_SIZE;
 
-  threads = default_threads;
-  if (nthreads > ARRAY_SIZE(default_threads)) {
-    threads = uv__malloc(nthreads * sizeof(threads[0]));
-    if (threads == NULL) {
-      nthreads = ARRAY_SIZE(default_threads);
-      threads = default_threads;
-    }
+  if (pool == &pools[UV_THREADPOOL_DEFAULT] &&
+      nthreads <= ARRAY_SIZE(default_workers)) {
+    pool->workers = default_workers;
+  } else {
+    pool->workers = uv__malloc(nthreads * sizeof(pool->workers[0]));
+  }
+
+  if (pool->workers == NULL) {
+    if (pool != &pools[UV_THREADPOOL_DEFAULT])
+      abort();
+    nthreads = ARRAY_SIZE(default_workers);
+    pool->workers = default_workers;
   }
 
-  if (uv_cond_init(&cond))
+  pool->nthreads = nthreads;
+
+  if (uv_mutex_init(&pool->idle_mutex))
     abort();
 
-  if (uv_mutex_init(&mutex))
+  if (uv_mutex_init(&pool->slow_io_mutex))
     abort();
 
-  QUEUE_INIT(&wq);
-  QUEUE_INIT(&slow_io_pending_wq);
-  QUEUE_INIT(&run_slow_work_message);
+  QUEUE_INIT(&pool->idle_workers);
+  QUEUE_INIT(&pool->slow_io_pending_wq);
+  pool->slow_io_work_running = 0;
 
   if (uv_sem_init(&sem, 0))
     abort();
 
+  for (i = 0; i < nthreads; i++) {
+    wk = &pool->workers[i];
+
+    if (uv_mutex_init(&wk->mutex))
+      abort();
+
+    if (uv_cond_init(&wk->cond))
+      abort();
+
+    QUEUE_INIT(&wk->wq);
+    QUEUE_INIT(&wk->idle_queue);
+    wk->pool = pool;
+    wk->started = &sem;
+    wk->wakeup = 0;
+    wk->exiting = 0;
+  }
+
   for (i = 0; i < nthreads; i++)
-    if (uv_thread_create(threads + i, worker, &sem))
+    if (uv_thread_create(&pool->workers[i].thread, worker, &pool->workers[i]))
       abort();
 
   for (i = 0; i < nthreads; i++)
@@ -232,6 +480,36 @@ static void init_threads(void) {
 }
 
 
+static void init_threads(void) {
+  unsigned int nthreads;
+  unsigned int i;
+  const char* val;
+
+  nthreads = pool_sizes[UV_THREADPOOL_DEFAULT];
+  if (nthreads == 0) {
+    nthreads = ARRAY_SIZE(default_workers);
+    val = getenv("UV_THREADPOOL_SIZE");
+    if (val != NULL)
+      nthreads = atoi(val);
+    if (nthreads == 0)
+      nthreads = 1;
+  }
+
+  init_pool(&pools[UV_THREADPOOL_DEFAULT], nthreads);
+  pool_map[UV_THREADPOOL_DEFAULT] = &pools[UV_THREADPOOL_DEFAULT];
+
+  for (i = 1; i < ARRAY_SIZE(pools); i++) {
+    pool_map[i] = &pools[UV_THREADPOOL_DEFAULT];
+    if (pool_sizes[i] != 0) {
+      init_pool(&pools[i], pool_sizes[i]);
+      pool_map[i] = &pools[i];
+    }
+  }
+
+  started = 1;
+}
+
+
 #ifndef _WIN32
 static void reset_once(void) {
   uv_once_t child_once = UV_ONCE_INIT;
@@ -243,8 +521,8 @@ static void reset_once(void) {
 static void init_once(void) {
 #ifndef _WIN32
   /* Re-initialize the threadpool after fork.
-   * Note that this discards the global mutex and condition as well
-   * as the work queue.
+   * Note that this discards the global mutexes and conditions as well
+   * as the work queues.
    */
   if (pthread_atfork(NULL, NULL, &reset_once))
     abort();
@@ -253,23 +531,98 @@ static void init_once(void) {
 }
 
 
+/* Returns the time of the last stage reached before `stage`, or 0 if the
+ * request was not submitted to the threadpool.
+ */
+static uint64_t uv__work_timing_get(const uv__work_timing_t* t, int stage) {
+  uint64_t time;
+  int i;
+
+  time = t->submit_time[0] | (uint64_t) t->submit_time[1] << 32;
+  if (time == 0)
+    return 0;
+
+  for (i = 0; i < stage; i++)
+    if (t->stage_us[i] != 0)
+      time += (uint64_t) (t->stage_us[i] - 1) * 1000;
+
+  return time;
+}
+
+
+void uv__work_timing_clear(uv_req_t* req) {
+  memset(uv__work_timing(req), 0, sizeof(uv__work_timing_t));
+}
+
+
+static void uv__work_timing_submit(uv_req_t* req) {
+  uv__work_timing_t* t;
+  uint64_t now;
+
+  t = uv__work_timing(req);
+  now = uv_hrtime();
+  uv__work_timing_clear(req);
+  t->submit_time[0] = (uint32_t) now;
+  t->submit_time[1] = (uint32_t) (now >> 32);
+}
+
+
+void uv__work_timing_mark(uv_req_t* req, enum uv__work_stage stage) {
+  uv__work_timing_t* t;
+  uint64_t last;
+  uint64_t us;
+
+  t = uv__work_timing(req);
+  last = uv__work_timing_get(t, stage);
+  if (last == 0)
+    return;  /* Run synchronously, not on the threadpool. */
+
+  us = (uv_hrtime() - last) / 1000;
+  if (us >= UINT32_MAX)
+    us = UINT32_MAX - 1;
+  t->stage_us[stage] = (uint32_t) us + 1;
+}
+
+
 void uv__work_submit(uv_loop_t* loop,
+                     uv_req_t* req,
                      struct uv__work* w,
+                     unsigned int pool,
                      enum uv__work_kind kind,
                      void (*work)(struct uv__work* w),
                      void (*done)(struct uv__work* w, int status)) {
+  uv__loop_internal_fields_t* lfields;
+
   uv_once(&once, init_once);
   w->loop = loop;
   w->work = work;
   w->done = done;
-  post(&w->wq, kind);
+  uv__work_timing_submit(req);
+
+  /* Spread a loop's work round-robin over the workers' queues.  The counter
+   * is only touched from the loop's own thread.
+   */
+  lfields = uv__get_internal_fields(loop);
+  post(pool_map[pool], &w->wq, kind, lfields->threadpool_next++);
 }
 
 
+/* The work request doesn't remember which pool it was posted to so lock the
+ * queues of all of them.
+ */
 static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
+  struct uv__threadpool* pool;
+  unsigned int i;
+  unsigned int k;
   int cancelled;
 
-  uv_mutex_lock(&mutex);
+  for (k = 0; k < ARRAY_SIZE(pools); k++) {
+    pool = &pools[k];
+    for (i = 0; i < pool->nthreads; i++)
+      uv_mutex_lock(&pool->workers[i].mutex);
+    if (pool->nthreads != 0)
+      uv_mutex_lock(&pool->slow_io_mutex);
+  }
   uv_mutex_lock(&w->loop->wq_mutex);
 
   cancelled = !QUEUE_EMPTY(&w->wq) && w->work != NULL;
@@ -277,7 +630,13 @@ static int uv__work_cancel(uv_loop_t* loop, uv_req_t* req, struct uv__work* w) {
     QUEUE_REMOVE(&w->wq);
 
   uv_mutex_unlock(&w->loop->wq_mutex);
-  uv_mutex_unlock(&mutex);
+  for (k = ARRAY_SIZE(pools); k > 0; k--) {
+    pool = &pools[k - 1];
+    if (pool->nthreads != 0)
+      uv_mutex_unlock(&pool->slow_io_mutex);
+    for (i = pool->nthreads; i > 0; i--)
+      uv_mutex_unlock(&pool->workers[i - 1].mutex);
+  }
 
   if (!cancelled)
     return UV_EBUSY;
@@ -318,7 +677,9 @@ void uv__work_done(uv_async_t* handle) {
 static void uv__queue_work(struct uv__work* w) {
   uv_work_t* req = container_of(w, uv_work_t, work_req);
 
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_START);
   req->work_cb(req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_END);
 }
 
 
@@ -326,6 +687,7 @@ static void uv__queue_done(struct uv__work* w, int err) {
   uv_work_t* req;
 
   req = container_of(w, uv_work_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_DONE);
   uv__req_unregister(req->loop, req);
 
   if (req->after_work_cb == NULL)
@@ -339,7 +701,20 @@ int uv_queue_work(uv_loop_t* loop,
                   uv_work_t* req,
                   uv_work_cb work_cb,
                   uv_after_work_cb after_work_cb) {
-  if (work_cb == NULL)
+  return uv_queue_work_in(loop,
+                          req,
+                          UV_THREADPOOL_DEFAULT,
+                          work_cb,
+                          after_work_cb);
+}
+
+
+int uv_queue_work_in(uv_loop_t* loop,
+                     uv_work_t* req,
+                     unsigned int pool,
+                     uv_work_cb work_cb,
+                     uv_after_work_cb after_work_cb) {
+  if (work_cb == NULL || pool >= UV_THREADPOOL_MAX)
     return UV_EINVAL;
 
   uv__req_init(loop, req, UV_WORK);
@@ -347,7 +722,9 @@ int uv_queue_work(uv_loop_t* loop,
   req->work_cb = work_cb;
   req->after_work_cb = after_work_cb;
   uv__work_submit(loop,
+                  (uv_req_t*) req,
                   &req->work_req,
+                  pool,
                   UV__WORK_CPU,
                   uv__queue_work,
                   uv__queue_done);
@@ -355,30 +732,74 @@ int uv_queue_work(uv_loop_t* loop,
 }
 
 
-int uv_cancel(uv_req_t* req) {
-  struct uv__work* wreq;
-  uv_loop_t* loop;
+int uv_threadpool_set_size(unsigned int pool, unsigned int size) {
+  if (pool >= UV_THREADPOOL_MAX || size > MAX_THREADPOOL_SIZE)
+    return UV_EINVAL;
+
+  /* The pools are sized once, when the first work request is submitted. */
+  if (started)
+    return UV_EBUSY;
 
+  pool_sizes[pool] = size;
+  return 0;
+}
+
+
+static struct uv__work* uv__req_work(const uv_req_t* req, uv_loop_t** loop) {
   switch (req->type) {
   case UV_FS:
-    loop =  ((uv_fs_t*) req)->loop;
-    wreq = &((uv_fs_t*) req)->work_req;
-    break;
+    *loop =  ((uv_fs_t*) req)->loop;
+    return &((uv_fs_t*) req)->work_req;
   case UV_GETADDRINFO:
-    loop =  ((uv_getaddrinfo_t*) req)->loop;
-    wreq = &((uv_getaddrinfo_t*) req)->work_req;
-    break;
+    *loop =  ((uv_getaddrinfo_t*) req)->loop;
+    return &((uv_getaddrinfo_t*) req)->work_req;
   case UV_GETNAMEINFO:
-    loop = ((uv_getnameinfo_t*) req)->loop;
-    wreq = &((uv_getnameinfo_t*) req)->work_req;
-    break;
+    *loop = ((uv_getnameinfo_t*) req)->loop;
+    return &((uv_getnameinfo_t*) req)->work_req;
   case UV_WORK:
-    loop =  ((uv_work_t*) req)->loop;
-    wreq = &((uv_work_t*) req)->work_req;
-    break;
+    *loop =  ((uv_work_t*) req)->loop;
+    return &((uv_work_t*) req)->work_req;
   default:
-    return UV_EINVAL;
+    return NULL;
   }
+}
+
+
+int uv_cancel(uv_req_t* req) {
+  struct uv__work* wreq;
+  uv_loop_t* loop;
+
+  wreq = uv__req_work(req, &loop);
+  if (wreq == NULL)
+    return UV_EINVAL;
 
   return uv__work_cancel(loop, req, wreq);
 }
+
+
+int uv_req_get_work_timing(const uv_req_t* req, uv_work_timing_t* timing) {
+  const uv__work_timing_t* t;
+  uv_loop_t* loop;
+
+  if (timing == NULL)
+    return UV_EINVAL;
+
+  if (uv__req_work(req, &loop) == NULL)
+    return UV_EINVAL;
+
+  memset(timing, 0, sizeof(*timing));
+
+  /* Requests that were run synchronously never went through the threadpool. */
+  t = uv__work_timing(req);
+  timing->submit_time = uv__work_timing_get(t, UV__WORK_START);
+  if (timing->submit_time == 0)
+    return 0;
+
+  if (t->stage_us[UV__WORK_START] != 0)
+    timing->start_time = uv__work_timing_get(t, UV__WORK_END);
+  if (t->stage_us[UV__WORK_END] != 0)
+    timing->end_time = uv__work_timing_get(t, UV__WORK_DONE);
+  if (t->stage_us[UV__WORK_DONE] != 0)
+    timing->done_time = uv__work_timing_get(t, UV__WORK_DONE + 1);
+  return 0;
+}
@@ -129,6 +129,10 @@ void uv_close(uv_handle_t* handle, uv_close_cb close_cb) {
     break;
 
   case UV_TCP:
+    /* The kernel may still send from the buffers of zero-copy writes, the
+     * stream code itself closes the handle once it is done with them. */
+    if (uv__stream_zerocopy_linger((uv_stream_t*)handle))
+      return;
     uv__tcp_close((uv_tcp_t*)handle);
     break;
 
@@ -357,19 +361,29 @@ int uv_run(uv_loop_t* loop, uv_run_mode mode) {
     uv__update_time(loop);
 
   while (r != 0 && loop->stop_flag == 0) {
+    uv__metrics_start(loop);
     uv__update_time(loop);
     uv__run_timers(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_TIMERS);
     ran_pending = uv__run_pending(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_PENDING);
     uv__run_idle(loop);
     uv__run_prepare(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_PREPARE);
 
     timeout = 0;
     if ((mode == UV_RUN_ONCE && !ran_pending) || mode == UV_RUN_DEFAULT)
       timeout = uv_backend_timeout(loop);
 
+    /* The backend charges the time it spends blocked to
+     * UV_LOOP_PHASE_POLL_WAIT itself.
+     */
     uv__io_poll(loop, timeout);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_POLL);
     uv__run_check(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_CHECK);
     uv__run_closing_handles(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_CLOSING);
 
     if (mode == UV_RUN_ONCE) {
       /* UV_RUN_ONCE implies forward progress: at least one callback must have
@@ -382,6 +396,7 @@ int uv_run(uv_loop_t* loop, uv_run_mode mode) {
        */
       uv__update_time(loop);
       uv__run_timers(loop);
+      uv__metrics_phase(loop, UV_LOOP_PHASE_TIMERS);
     }
 
     r = uv__loop_alive(loop);
@@ -409,6 +424,31 @@ int uv_is_active(const uv_handle_t* handle) {
 }
 
 
+/* Lets other sockets bind to the same address and port, and share the
+ * incoming connections or datagrams with them.
+ */
+int uv__sock_reuseport(int fd) {
+  int on;
+
+  on = 1;
+#if defined(__FreeBSD__) && defined(SO_REUSEPORT_LB)
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT_LB, &on, sizeof(on)))
+    return UV__ERR(errno);
+#elif (defined(__linux__) || defined(__DragonFly__)) && defined(SO_REUSEPORT)
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)))
+    return UV__ERR(errno);
+#else
+  /* Elsewhere, SO_REUSEPORT does not balance the load, one of the sockets
+   * gets everything.
+   */
+  (void) on;
+  return UV_ENOTSUP;
+#endif
+
+  return 0;
+}
+
+
 /* Open a socket in non-blocking close-on-exec mode, atomically if possible. */
 int uv__socket(int domain, int type, int protocol) {
   int sockfd;
@@ -827,8 +867,9 @@ void uv__io_init(uv__io_t* w, uv__io_cb cb, int fd) {
 
 
 void uv__io_start(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
-  assert(0 == (events & ~(POLLIN | POLLOUT | UV__POLLRDHUP | UV__POLLPRI)));
-  assert(0 != events);
+  assert(0 == (events & ~(POLLIN | POLLOUT | UV__POLLRDHUP | UV__POLLPRI |
+                          UV__POLLEXCLUSIVE)));
+  assert(0 != (events & ~UV__POLLEXCLUSIVE));
   assert(w->fd >= 0);
   assert(w->fd < INT_MAX);
 
@@ -855,7 +896,8 @@ void uv__io_start(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
 
 
 void uv__io_stop(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
-  assert(0 == (events & ~(POLLIN | POLLOUT | UV__POLLRDHUP | UV__POLLPRI)));
+  assert(0 == (events & ~(POLLIN | POLLOUT | UV__POLLRDHUP | UV__POLLPRI |
+                          UV__POLLEXCLUSIVE)));
   assert(0 != events);
 
   if (w->fd == -1)
@@ -869,7 +911,9 @@ void uv__io_stop(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
 
   w->pevents &= ~events;
 
-  if (w->pevents == 0) {
+  /* UV__POLLEXCLUSIVE only qualifies the other events. */
+  if ((w->pevents & ~UV__POLLEXCLUSIVE) == 0) {
+    w->pevents = 0;
     QUEUE_REMOVE(&w->watcher_queue);
     QUEUE_INIT(&w->watcher_queue);
 
@@ -878,6 +922,14 @@ void uv__io_stop(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
       assert(loop->nfds > 0);
       loop->watchers[w->fd] = NULL;
       loop->nfds--;
+
+      /* Disarm exclusive watchers right away instead of lazily.  A stale
+       * registration would keep taking wakeups that another process sharing
+       * the file descriptor could have acted on.
+       */
+      if (w->events & UV__POLLEXCLUSIVE)
+        uv__platform_invalidate_fd(loop, w->fd);
+
       w->events = 0;
     }
   }
@@ -88,6 +88,7 @@ extern char *mkdtemp(char *template); /* See issue #740 on AIX < 7 */
     req->new_path = NULL;                                                     \
     req->bufs = NULL;                                                         \
     req->cb = cb;                                                             \
+    uv__work_timing_clear((uv_req_t*) req);                                   \
   }                                                                           \
   while (0)
 
@@ -129,7 +130,9 @@ extern char *mkdtemp(char *template); /* See issue #740 on AIX < 7 */
     if (cb != NULL) {                                                         \
       uv__req_register(loop, req);                                            \
       uv__work_submit(loop,                                                   \
+                      (uv_req_t*) req,                                        \
                       &req->work_req,                                         \
+                      UV_THREADPOOL_FS,                                       \
                       UV__WORK_FAST_IO,                                       \
                       uv__fs_work,                                            \
                       uv__fs_done);                                           \
@@ -1076,7 +1079,7 @@ static int uv__fs_fstat(int fd, uv_stat_t *buf) {
   return ret;
 }
 
-static size_t uv__fs_buf_offset(uv_buf_t* bufs, size_t size) {
+size_t uv__fs_buf_offset(uv_buf_t* bufs, size_t size) {
   size_t offset;
   /* Figure out which bufs are done */
   for (offset = 0; size > 0 && bufs[offset].len <= size; ++offset)
@@ -1142,6 +1145,7 @@ static void uv__fs_work(struct uv__work* w) {
   ssize_t r;
 
   req = container_of(w, uv_fs_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_START);
   retry_on_eintr = !(req->fs_type == UV_FS_CLOSE ||
                      req->fs_type == UV_FS_READ);
 
@@ -1199,6 +1203,8 @@ static void uv__fs_work(struct uv__work* w) {
                  req->fs_type == UV_FS_LSTAT)) {
     req->ptr = &req->statbuf;
   }
+
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_END);
 }
 
 
@@ -1206,6 +1212,7 @@ static void uv__fs_done(struct uv__work* w, int status) {
   uv_fs_t* req;
 
   req = container_of(w, uv_fs_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_DONE);
   uv__req_unregister(req->loop, req);
 
   if (status == UV_ECANCELED) {
@@ -1305,6 +1312,9 @@ int uv_fs_lchown(uv_loop_t* loop,
 int uv_fs_fdatasync(uv_loop_t* loop, uv_fs_t* req, uv_file file, uv_fs_cb cb) {
   INIT(FDATASYNC);
   req->file = file;
+  if (cb != NULL)
+    if (uv__iou_fs_fsync_or_fdatasync(loop, req, UV__IORING_FSYNC_DATASYNC))
+      return 0;
   POST;
 }
 
@@ -1312,6 +1322,9 @@ int uv_fs_fdatasync(uv_loop_t* loop, uv_fs_t* req, uv_file file, uv_fs_cb cb) {
 int uv_fs_fstat(uv_loop_t* loop, uv_fs_t* req, uv_file file, uv_fs_cb cb) {
   INIT(FSTAT);
   req->file = file;
+  if (cb != NULL)
+    if (uv__iou_fs_statx(loop, req, /* is_fstat */ 1, /* is_lstat */ 0))
+      return 0;
   POST;
 }
 
@@ -1319,6 +1332,9 @@ int uv_fs_fstat(uv_loop_t* loop, uv_fs_t* req, uv_file file, uv_fs_cb cb) {
 int uv_fs_fsync(uv_loop_t* loop, uv_fs_t* req, uv_file file, uv_fs_cb cb) {
   INIT(FSYNC);
   req->file = file;
+  if (cb != NULL)
+    if (uv__iou_fs_fsync_or_fdatasync(loop, req, /* no flags */ 0))
+      return 0;
   POST;
 }
 
@@ -1352,6 +1368,9 @@ int uv_fs_futime(uv_loop_t* loop,
 int uv_fs_lstat(uv_loop_t* loop, uv_fs_t* req, const char* path, uv_fs_cb cb) {
   INIT(LSTAT);
   PATH;
+  if (cb != NULL)
+    if (uv__iou_fs_statx(loop, req, /* is_fstat */ 0, /* is_lstat */ 1))
+      return 0;
   POST;
 }
 
@@ -1401,6 +1420,9 @@ int uv_fs_open(uv_loop_t* loop,
   PATH;
   req->flags = flags;
   req->mode = mode;
+  if (cb != NULL)
+    if (uv__iou_fs_open(loop, req))
+      return 0;
   POST;
 }
 
@@ -1429,6 +1451,11 @@ int uv_fs_read(uv_loop_t* loop, uv_fs_t* req,
   memcpy(req->bufs, bufs, nbufs * sizeof(*bufs));
 
   req->off = off;
+
+  if (cb != NULL)
+    if (uv__iou_fs_read_or_write(loop, req, /* is_read */ 1))
+      return 0;
+
   POST;
 }
 
@@ -1502,6 +1529,9 @@ int uv_fs_sendfile(uv_loop_t* loop,
 int uv_fs_stat(uv_loop_t* loop, uv_fs_t* req, const char* path, uv_fs_cb cb) {
   INIT(STAT);
   PATH;
+  if (cb != NULL)
+    if (uv__iou_fs_statx(loop, req, /* is_fstat */ 0, /* is_lstat */ 0))
+      return 0;
   POST;
 }
 
@@ -1565,6 +1595,11 @@ int uv_fs_write(uv_loop_t* loop,
   memcpy(req->bufs, bufs, nbufs * sizeof(*bufs));
 
   req->off = off;
+
+  if (cb != NULL)
+    if (uv__iou_fs_read_or_write(loop, req, /* is_read */ 0))
+      return 0;
+
   POST;
 }
 
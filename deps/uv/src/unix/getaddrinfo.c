@@ -101,8 +101,10 @@ static void uv__getaddrinfo_work(struct uv__work* w) {
   int err;
 
   req = container_of(w, uv_getaddrinfo_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_START);
   err = getaddrinfo(req->hostname, req->service, req->hints, &req->addrinfo);
   req->retcode = uv__getaddrinfo_translate_error(err);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_END);
 }
 
 
@@ -110,6 +112,7 @@ static void uv__getaddrinfo_done(struct uv__work* w, int status) {
   uv_getaddrinfo_t* req;
 
   req = container_of(w, uv_getaddrinfo_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_DONE);
   uv__req_unregister(req->loop, req);
 
   /* See initialization in uv_getaddrinfo(). */
@@ -205,12 +208,15 @@ int uv_getaddrinfo(uv_loop_t* loop,
 
   if (cb) {
     uv__work_submit(loop,
+                    (uv_req_t*) req,
                     &req->work_req,
+                    UV_THREADPOOL_DNS,
                     UV__WORK_SLOW_IO,
                     uv__getaddrinfo_work,
                     uv__getaddrinfo_done);
     return 0;
   } else {
+    uv__work_timing_clear((uv_req_t*) req);
     uv__getaddrinfo_work(&req->work_req);
     uv__getaddrinfo_done(&req->work_req, 0);
     return req->retcode;
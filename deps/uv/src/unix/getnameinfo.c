@@ -34,6 +34,7 @@ static void uv__getnameinfo_work(struct uv__work* w) {
   socklen_t salen;
 
   req = container_of(w, uv_getnameinfo_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_START);
 
   if (req->storage.ss_family == AF_INET)
     salen = sizeof(struct sockaddr_in);
@@ -50,6 +51,7 @@ static void uv__getnameinfo_work(struct uv__work* w) {
                     sizeof(req->service),
                     req->flags);
   req->retcode = uv__getaddrinfo_translate_error(err);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_END);
 }
 
 static void uv__getnameinfo_done(struct uv__work* w, int status) {
@@ -58,6 +60,7 @@ static void uv__getnameinfo_done(struct uv__work* w, int status) {
   char* service;
 
   req = container_of(w, uv_getnameinfo_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_DONE);
   uv__req_unregister(req->loop, req);
   host = service = NULL;
 
@@ -108,12 +111,15 @@ int uv_getnameinfo(uv_loop_t* loop,
 
   if (getnameinfo_cb) {
     uv__work_submit(loop,
+                    (uv_req_t*) req,
                     &req->work_req,
+                    UV_THREADPOOL_DNS,
                     UV__WORK_SLOW_IO,
                     uv__getnameinfo_work,
                     uv__getnameinfo_done);
     return 0;
   } else {
+    uv__work_timing_clear((uv_req_t*) req);
     uv__getnameinfo_work(&req->work_req);
     uv__getnameinfo_done(&req->work_req, 0);
     return req->retcode;
@@ -117,6 +117,73 @@ int uv__pthread_sigmask(int how, const sigset_t* set, sigset_t* oset);
 # define UV__POLLPRI 0
 #endif
 
+/* Wake up only one of the epoll instances that wait on the file descriptor.
+ * EPOLLEXCLUSIVE, linux >= 4.5.  Never reported back, only registered.
+ */
+#if defined(__linux__)
+# define UV__POLLEXCLUSIVE 0x10000000
+#else
+# define UV__POLLEXCLUSIVE 0
+#endif
+
+/* MSG_ZEROCOPY, linux >= 4.14. */
+#if defined(__linux__)
+# ifndef SO_ZEROCOPY
+#  define SO_ZEROCOPY 60
+# endif
+# ifndef MSG_ZEROCOPY
+#  define MSG_ZEROCOPY 0x4000000
+# endif
+# ifndef SO_EE_ORIGIN_ZEROCOPY
+#  define SO_EE_ORIGIN_ZEROCOPY 5
+# endif
+#endif
+
+/* TCP_FASTOPEN_CONNECT, linux >= 4.11. */
+#if defined(__linux__)
+# ifndef TCP_FASTOPEN
+#  define TCP_FASTOPEN 23
+# endif
+# ifndef TCP_FASTOPEN_CONNECT
+#  define TCP_FASTOPEN_CONNECT 30
+# endif
+#endif
+
+/* State of a TCP handle that sends large writes with MSG_ZEROCOPY. Lives in
+ * the otherwise unused handle->u.reserved[0], so uv_tcp_t does not grow.
+ */
+typedef struct {
+  int enabled;
+  unsigned int min_size;
+  /* Number of zero-copy sends so far, and how many of them the kernel is
+   * done with. Both wrap around.
+   */
+  unsigned int sent;
+  unsigned int completed;
+  /* Finished write requests that wait for the kernel to release their
+   * buffers, in order.
+   */
+  void* pending_queue[2];
+  /* Bounds how long uv_close() waits for the kernel, see
+   * uv__stream_zerocopy_linger(). Initialized only once it is used.
+   */
+  int lingering;
+  uv_timer_t linger_timer;
+} uv__tcp_zerocopy_t;
+
+/* How long uv_close() waits for the kernel to release the buffers of
+ * zero-copy sends when SO_LINGER is not set, in milliseconds.
+ */
+#define UV__ZEROCOPY_LINGER_TIMEOUT 10000
+
+#define uv__tcp_zerocopy(handle)                                              \
+  ((uv__tcp_zerocopy_t*) ((uv_handle_t*) (handle))->u.reserved[0])
+
+/* The events a listening stream waits for. */
+#define UV__ACCEPT_EVENTS(stream)                                             \
+  (POLLIN |                                                                   \
+   (((stream)->flags & UV_HANDLE_EXCLUSIVE_ACCEPT) ? UV__POLLEXCLUSIVE : 0))
+
 #if !defined(O_CLOEXEC) && defined(__FreeBSD__)
 /*
  * It may be that we are just missing `__POSIX_VISIBLE >= 200809`.
@@ -185,6 +252,7 @@ int uv__nonblock_fcntl(int fd, int set);
 int uv__close(int fd); /* preserves errno */
 int uv__close_nocheckstdio(int fd);
 int uv__socket(int domain, int type, int protocol);
+int uv__sock_reuseport(int fd);
 ssize_t uv__recvmsg(int fd, struct msghdr *msg, int flags);
 void uv__make_close_pending(uv_handle_t* handle);
 int uv__getiovmax(void);
@@ -215,6 +283,8 @@ void uv__stream_init(uv_loop_t* loop, uv_stream_t* stream,
     uv_handle_type type);
 int uv__stream_open(uv_stream_t*, int fd, int flags);
 void uv__stream_destroy(uv_stream_t* stream);
+int uv__stream_zerocopy_linger(uv_stream_t* stream);
+void uv__stream_zerocopy_destroy(uv_stream_t* stream);
 #if defined(__APPLE__)
 int uv__stream_try_select(uv_stream_t* stream, int* fd);
 #endif /* defined(__APPLE__) */
@@ -320,8 +390,24 @@ UV_UNUSED(static char* uv__basename_r(const char* path)) {
   return s + 1;
 }
 
+size_t uv__fs_buf_offset(uv_buf_t* bufs, size_t size);
+
 #if defined(__linux__)
 int uv__inotify_fork(uv_loop_t* loop, void* old_watchers);
+int uv__iou_fs_fsync_or_fdatasync(uv_loop_t* loop,
+                                  uv_fs_t* req,
+                                  uint32_t fsync_flags);
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req);
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read);
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat);
+#else
+#define uv__iou_fs_fsync_or_fdatasync(loop, req, fsync_flags) 0
+#define uv__iou_fs_open(loop, req) 0
+#define uv__iou_fs_read_or_write(loop, req, is_read) 0
+#define uv__iou_fs_statx(loop, req, is_fstat, is_lstat) 0
 #endif
 
 #endif /* UV_UNIX_INTERNAL_H_ */
@@ -211,6 +211,8 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     if (pset != NULL)
       pthread_sigmask(SIG_BLOCK, pset, NULL);
 
+    uv__metrics_phase(loop, UV_LOOP_PHASE_POLL);
+
     nfds = kevent(loop->backend_fd,
                   events,
                   nevents,
@@ -218,6 +220,8 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
                   ARRAY_SIZE(events),
                   timeout == -1 ? NULL : &spec);
 
+    SAVE_ERRNO(uv__metrics_phase(loop, UV_LOOP_PHASE_POLL_WAIT));
+
     if (pset != NULL)
       pthread_sigmask(SIG_UNBLOCK, pset, NULL);
 
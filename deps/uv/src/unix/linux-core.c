@@ -35,9 +35,11 @@
 
 #include <net/if.h>
 #include <sys/epoll.h>
+#include <sys/mman.h>
 #include <sys/param.h>
 #include <sys/prctl.h>
 #include <sys/sysinfo.h>
+#include <sys/sysmacros.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <time.h>
@@ -74,6 +76,23 @@
 # define CLOCK_BOOTTIME 7
 #endif
 
+STATIC_ASSERT(120 == sizeof(struct uv__io_uring_params));
+STATIC_ASSERT(64 == sizeof(struct uv__io_uring_sqe));
+STATIC_ASSERT(16 == sizeof(struct uv__io_uring_cqe));
+STATIC_ASSERT(256 == sizeof(struct uv__statx));
+
+/* Bounds for the number of events that one epoll_wait() call returns.  The
+ * minimum is what used to be a fixed-size array on the stack, the maximum
+ * keeps the buffer below 1 MB.
+ */
+#define UV__EPOLL_BATCH_MIN 1024
+#define UV__EPOLL_BATCH_MAX 65536
+
+/* Number of consecutive polls that use less than a quarter of the buffer
+ * before it is halved again.
+ */
+#define UV__EPOLL_BATCH_DECAY 256
+
 static int read_models(unsigned int numcpus, uv_cpu_info_t* ci);
 static int read_times(FILE* statfile_fp,
                       unsigned int numcpus,
@@ -83,8 +102,18 @@ static unsigned long read_cpufreq(unsigned int cpunum);
 
 
 int uv__platform_loop_init(uv_loop_t* loop) {
+  struct uv__epoll_batch* batch;
+  int err;
   int fd;
 
+  batch = &uv__get_internal_fields(loop)->epoll_batch;
+  batch->events = uv__malloc(UV__EPOLL_BATCH_MIN * sizeof(struct epoll_event));
+  batch->size = UV__EPOLL_BATCH_MIN;
+  batch->underused = 0;
+
+  if (batch->events == NULL)
+    return UV_ENOMEM;
+
   fd = epoll_create1(EPOLL_CLOEXEC);
 
   /* epoll_create1() can fail either because it's not implemented (old kernel)
@@ -101,19 +130,33 @@ int uv__platform_loop_init(uv_loop_t* loop) {
   loop->inotify_fd = -1;
   loop->inotify_watchers = NULL;
 
-  if (fd == -1)
-    return UV__ERR(errno);
+  /* The io_uring instance is created lazily on first use. */
+  uv__get_internal_fields(loop)->iou.ringfd = -2;
+
+  if (fd == -1) {
+    err = UV__ERR(errno);
+    uv__free(batch->events);
+    batch->events = NULL;
+    return err;
+  }
 
   return 0;
 }
 
 
 int uv__io_fork(uv_loop_t* loop) {
+  struct uv__iou* iou;
   int err;
   void* old_watchers;
 
   old_watchers = loop->inotify_watchers;
 
+  /* The child doesn't get the completions of the requests that the parent
+   * has in the ring, stop waiting for them.
+   */
+  iou = &uv__get_internal_fields(loop)->iou;
+  loop->active_reqs.count -= iou->in_flight;
+
   uv__close(loop->backend_fd);
   loop->backend_fd = -1;
   uv__platform_loop_delete(loop);
@@ -126,7 +169,19 @@ int uv__io_fork(uv_loop_t* loop) {
 }
 
 
+static void uv__iou_delete(struct uv__iou* iou);
+
+
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  struct uv__epoll_batch* batch;
+
+  uv__iou_delete(&uv__get_internal_fields(loop)->iou);
+
+  batch = &uv__get_internal_fields(loop)->epoll_batch;
+  uv__free(batch->events);
+  batch->events = NULL;
+  batch->size = 0;
+
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -187,6 +242,555 @@ int uv__io_check_fd(uv_loop_t* loop, int fd) {
 }
 
 
+static int uv__use_io_uring(void) {
+  /* Opt-in for now, the threadpool remains the default. */
+  static int use_io_uring = -1;
+  const char* val;
+  int use;
+
+  use = __atomic_load_n(&use_io_uring, __ATOMIC_RELAXED);
+
+  if (use == -1) {
+    val = getenv("UV_USE_IO_URING");
+    use = val != NULL && atoi(val) > 0;
+    __atomic_store_n(&use_io_uring, use, __ATOMIC_RELAXED);
+  }
+
+  return use;
+}
+
+
+static void uv__iou_init(int epollfd, struct uv__iou* iou, uint32_t entries) {
+  struct uv__io_uring_params params;
+  struct epoll_event e;
+  size_t cqlen;
+  size_t sqlen;
+  size_t maxlen;
+  size_t sqelen;
+  uint32_t i;
+  char* sq;
+  char* sqe;
+  int ringfd;
+
+  /* Don't try again if anything below fails, the threadpool takes over. */
+  iou->ringfd = -1;
+
+  if (!uv__use_io_uring())
+    return;
+
+  sq = MAP_FAILED;
+  sqe = MAP_FAILED;
+  maxlen = 0;
+  sqelen = 0;
+
+  memset(&params, 0, sizeof(params));
+  ringfd = uv__io_uring_setup(entries, &params);
+  if (ringfd == -1)
+    return;
+
+  /* All three features are linux >= 5.6, which is also the first version that
+   * implements IORING_OP_OPENAT and IORING_OP_STATX.  Without NODROP we could
+   * lose completions when the completion queue overflows and without
+   * RW_CUR_POS we can't express "read from the current file position".
+   */
+  if (!(params.features & UV__IORING_FEAT_SINGLE_MMAP))
+    goto fail;
+
+  if (!(params.features & UV__IORING_FEAT_NODROP))
+    goto fail;
+
+  if (!(params.features & UV__IORING_FEAT_RW_CUR_POS))
+    goto fail;
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen =
+      params.cq_off.cqes + params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  maxlen = sqlen < cqlen ? cqlen : sqlen;
+  sqelen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+
+  sq = mmap(0,
+            maxlen,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE,
+            ringfd,
+            UV__IORING_OFF_SQ_RING);
+
+  sqe = mmap(0,
+             sqelen,
+             PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE,
+             ringfd,
+             UV__IORING_OFF_SQES);
+
+  if (sq == MAP_FAILED || sqe == MAP_FAILED)
+    goto fail;
+
+  /* The ring file descriptor becomes readable when there are completions
+   * to reap, that's all we need to know.
+   */
+  memset(&e, 0, sizeof(e));
+  e.events = POLLIN;
+  e.data.fd = ringfd;
+
+  if (epoll_ctl(epollfd, EPOLL_CTL_ADD, ringfd, &e))
+    goto fail;
+
+  iou->sqhead = (uint32_t*) (sq + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (sq + params.sq_off.tail);
+  iou->sqmask = *(uint32_t*) (sq + params.sq_off.ring_mask);
+  iou->sqarray = (uint32_t*) (sq + params.sq_off.array);
+  iou->sqflags = (uint32_t*) (sq + params.sq_off.flags);
+  iou->cqhead = (uint32_t*) (sq + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (sq + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (sq + params.cq_off.ring_mask);
+  iou->sq = sq;
+  iou->cqe = sq + params.cq_off.cqes;
+  iou->sqe = sqe;
+  iou->maxlen = maxlen;
+  iou->sqelen = sqelen;
+  iou->ringfd = ringfd;
+  iou->unsubmitted = 0;
+  iou->in_flight = 0;
+
+  for (i = 0; i <= iou->sqmask; i++)
+    iou->sqarray[i] = i;  /* Slot -> sqe identity mapping. */
+
+  return;
+
+fail:
+  if (sq != MAP_FAILED)
+    munmap(sq, maxlen);
+
+  if (sqe != MAP_FAILED)
+    munmap(sqe, sqelen);
+
+  uv__close(ringfd);
+}
+
+
+static void uv__iou_delete(struct uv__iou* iou) {
+  if (iou->ringfd >= 0) {
+    munmap(iou->sq, iou->maxlen);
+    munmap(iou->sqe, iou->sqelen);
+    uv__close(iou->ringfd);
+  }
+
+  /* Start over lazily, uv__io_fork() calls uv__platform_loop_init() next. */
+  iou->ringfd = -2;
+  iou->unsubmitted = 0;
+  iou->in_flight = 0;
+}
+
+
+/* Hand queued submissions to the kernel.  Called right before the event loop
+ * goes to sleep so all requests made in one loop iteration share a syscall.
+ */
+static void uv__iou_flush(struct uv__iou* iou) {
+  int rc;
+
+  while (iou->unsubmitted > 0) {
+    rc = uv__io_uring_enter(iou->ringfd, iou->unsubmitted, 0, 0);
+
+    if (rc > 0) {
+      iou->unsubmitted -= rc;
+      continue;
+    }
+
+    if (rc == -1 && errno == EINTR)
+      continue;
+
+    /* Out of kernel memory or the completion queue has overflowed.  Retry
+     * after the next batch of completions has been reaped.
+     */
+    if (rc == -1 && (errno == EAGAIN || errno == EBUSY))
+      return;
+
+    abort();
+  }
+}
+
+
+static struct uv__io_uring_sqe* uv__iou_get_sqe(struct uv__iou* iou,
+                                                uv_loop_t* loop,
+                                                uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t mask;
+
+  if (iou->ringfd == -2)
+    uv__iou_init(loop->backend_fd, iou, 64);
+
+  if (iou->ringfd == -1)
+    return NULL;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  mask = iou->sqmask;
+
+  if (tail - head > mask) {
+    /* Submission queue is full. Make room, or punt to the threadpool. */
+    uv__iou_flush(iou);
+    head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+    if (tail - head > mask)
+      return NULL;
+  }
+
+  sqe = iou->sqe;
+  sqe = &sqe[tail & mask];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+
+  /* Pacify uv_cancel(), the request is not on any threadpool queue. */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  QUEUE_INIT(&req->work_req.wq);
+
+  uv__req_register(loop, req);
+  iou->in_flight++;
+
+  return sqe;
+}
+
+
+static void uv__iou_submit(struct uv__iou* iou) {
+  __atomic_store_n(iou->sqtail, *iou->sqtail + 1, __ATOMIC_RELEASE);
+  iou->unsubmitted++;
+}
+
+
+int uv__iou_fs_fsync_or_fdatasync(uv_loop_t* loop,
+                                  uv_fs_t* req,
+                                  uint32_t fsync_flags) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->opcode = UV__IORING_OP_FSYNC;
+  sqe->rw_flags = fsync_flags;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->fd = AT_FDCWD;
+  sqe->len = req->mode;
+  sqe->opcode = UV__IORING_OP_OPENAT;
+  sqe->rw_flags = req->flags | O_CLOEXEC;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  /* Reads are capped like in uv__fs_read(), writes that exceed IOV_MAX
+   * need uv__fs_write_all()'s retry loop and go to the threadpool.
+   */
+  if (req->nbufs > (unsigned int) uv__getiovmax()) {
+    if (!is_read)
+      return 0;
+    req->nbufs = uv__getiovmax();
+  }
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->bufs;
+  sqe->fd = req->file;
+  sqe->len = req->nbufs;
+  sqe->off = req->off < 0 ? (uint64_t) -1 : (uint64_t) req->off;
+  sqe->opcode = is_read ? UV__IORING_OP_READV : UV__IORING_OP_WRITEV;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+  struct uv__iou* iou;
+
+  statxbuf = uv__malloc(sizeof(*statxbuf));
+  if (statxbuf == NULL)
+    return 0;
+
+  iou = &uv__get_internal_fields(loop)->iou;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  req->ptr = statxbuf;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->off = (uintptr_t) statxbuf;  /* addr2 */
+  sqe->fd = AT_FDCWD;
+  sqe->len = 0x7FF;  /* STATX_BASIC_STATS */
+  sqe->opcode = UV__IORING_OP_STATX;
+
+  if (is_fstat) {
+    sqe->addr = (uintptr_t) "";
+    sqe->fd = req->file;
+    sqe->rw_flags |= 0x1000;  /* AT_EMPTY_PATH */
+  }
+
+  if (is_lstat)
+    sqe->rw_flags |= AT_SYMLINK_NOFOLLOW;
+
+  uv__iou_submit(iou);
+
+  return 1;
+}
+
+
+static void uv__statx_to_stat(const struct uv__statx* statxbuf,
+                              uv_stat_t* buf) {
+  buf->st_dev = makedev(statxbuf->stx_dev_major, statxbuf->stx_dev_minor);
+  buf->st_mode = statxbuf->stx_mode;
+  buf->st_nlink = statxbuf->stx_nlink;
+  buf->st_uid = statxbuf->stx_uid;
+  buf->st_gid = statxbuf->stx_gid;
+  buf->st_rdev = makedev(statxbuf->stx_rdev_major, statxbuf->stx_rdev_minor);
+  buf->st_ino = statxbuf->stx_ino;
+  buf->st_size = statxbuf->stx_size;
+  buf->st_blksize = statxbuf->stx_blksize;
+  buf->st_blocks = statxbuf->stx_blocks;
+  buf->st_atim.tv_sec = statxbuf->stx_atime.tv_sec;
+  buf->st_atim.tv_nsec = statxbuf->stx_atime.tv_nsec;
+  buf->st_mtim.tv_sec = statxbuf->stx_mtime.tv_sec;
+  buf->st_mtim.tv_nsec = statxbuf->stx_mtime.tv_nsec;
+  buf->st_ctim.tv_sec = statxbuf->stx_ctime.tv_sec;
+  buf->st_ctim.tv_nsec = statxbuf->stx_ctime.tv_nsec;
+  /* Same as uv__to_stat() so both code paths report identical results. */
+  buf->st_birthtim.tv_sec = statxbuf->stx_ctime.tv_sec;
+  buf->st_birthtim.tv_nsec = statxbuf->stx_ctime.tv_nsec;
+  buf->st_flags = 0;
+  buf->st_gen = 0;
+}
+
+
+static void uv__iou_fs_statx_post(uv_fs_t* req) {
+  struct uv__statx* statxbuf;
+
+  statxbuf = req->ptr;
+  req->ptr = NULL;
+
+  if (req->result == 0) {
+    uv__statx_to_stat(statxbuf, &req->statbuf);
+    req->ptr = &req->statbuf;
+  }
+
+  uv__free(statxbuf);
+}
+
+
+/* Writes can be short, e.g. when the disk fills up or a signal interrupts
+ * them.  Like uv__fs_write_all(), submit the rest until all of it is written
+ * or an error happens.  Returns 1 when the request went back into the ring;
+ * otherwise req->result holds the bytes written so far, or the error.
+ */
+static int uv__iou_fs_write_more(uv_loop_t* loop,
+                                 uv_fs_t* req,
+                                 int32_t res) {
+  unsigned int done;
+
+  if (res <= 0) {
+    if (req->result == 0)
+      req->result = res;
+    return 0;
+  }
+
+  req->result += res;
+  if (req->off >= 0)
+    req->off += res;
+
+  /* Shift the unwritten buffers to the front, req->bufs may need freeing. */
+  done = uv__fs_buf_offset(req->bufs, res);
+  req->nbufs -= done;
+  if (req->nbufs == 0)
+    return 0;
+
+  memmove(req->bufs, req->bufs + done, req->nbufs * sizeof(*req->bufs));
+
+  /* If the ring has no room, report the short write like write(2) would. */
+  return uv__iou_fs_read_or_write(loop, req, /* is_read */ 0);
+}
+
+
+static void uv__poll_io_uring(uv_loop_t* loop, struct uv__iou* iou) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__io_uring_cqe* e;
+  uv_fs_t* req;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t mask;
+  uint32_t flags;
+  uint32_t i;
+  int rc;
+
+  for (;;) {
+    head = *iou->cqhead;
+    tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+    mask = iou->cqmask;
+    cqe = iou->cqe;
+
+    for (i = head; i != tail; i++) {
+      e = &cqe[i & mask];
+
+      req = (uv_fs_t*) (uintptr_t) e->user_data;
+      assert(req->type == UV_FS);
+
+      uv__req_unregister(loop, req);
+      iou->in_flight--;
+
+      /* io_uring stores error codes as negative numbers, same as libuv. */
+      if (req->fs_type != UV_FS_WRITE)
+        req->result = e->res;
+      else if (uv__iou_fs_write_more(loop, req, e->res))
+        continue;
+
+      switch (req->fs_type) {
+        case UV_FS_READ:
+        case UV_FS_WRITE:
+          if (req->bufs != req->bufsml)
+            uv__free(req->bufs);
+          req->bufs = NULL;
+          req->nbufs = 0;
+          break;
+        case UV_FS_FSTAT:
+        case UV_FS_LSTAT:
+        case UV_FS_STAT:
+          uv__iou_fs_statx_post(req);
+          break;
+        default:
+          break;
+      }
+
+      req->cb(req);
+    }
+
+    __atomic_store_n(iou->cqhead, tail, __ATOMIC_RELEASE);
+
+    /* Completions that didn't fit in the completion queue are held back by
+     * the kernel until we ask for them.
+     */
+    flags = __atomic_load_n(iou->sqflags, __ATOMIC_ACQUIRE);
+    if (!(flags & UV__IORING_SQ_CQ_OVERFLOW))
+      break;
+
+    do
+      rc = uv__io_uring_enter(iou->ringfd, 0, 0, UV__IORING_ENTER_GETEVENTS);
+    while (rc == -1 && errno == EINTR);
+
+    if (rc == -1)
+      abort();
+  }
+}
+
+
+/* EPOLLEXCLUSIVE can only be set with EPOLL_CTL_ADD, so a file descriptor
+ * that is still registered from before is removed and added again instead
+ * of modified.  Kernels that predate the flag reject it with EINVAL; those
+ * get a normal registration.  w->events keeps the flag in either case so
+ * the watcher is not registered again on every uv__io_start().
+ */
+static void uv__epoll_ctl_exclusive(int epfd,
+                                    int op,
+                                    int fd,
+                                    struct epoll_event* e) {
+  if (op == EPOLL_CTL_MOD)
+    if (epoll_ctl(epfd, EPOLL_CTL_DEL, fd, e))
+      abort();
+
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, e) == 0)
+    return;
+
+  if (errno == EEXIST) {
+    if (epoll_ctl(epfd, EPOLL_CTL_DEL, fd, e))
+      abort();
+    if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, e) == 0)
+      return;
+  }
+
+  if (errno != EINVAL)
+    abort();
+
+  e->events &= ~UV__POLLEXCLUSIVE;
+  if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, e))
+    abort();
+}
+
+
+/* Size the next epoll_wait() call after how much of the buffer this one used.
+ * A full buffer means more events are likely pending, so double it; many
+ * mostly empty polls in a row mean the burst is over, so halve it.  Failing
+ * to reallocate is harmless, the loop keeps using the current buffer.
+ */
+static void uv__epoll_batch_adjust(struct uv__epoll_batch* batch, int nfds) {
+  unsigned int size;
+  void* events;
+
+  size = batch->size;
+
+  if ((unsigned int) nfds == size) {
+    batch->underused = 0;
+    if (size >= UV__EPOLL_BATCH_MAX)
+      return;
+    size *= 2;
+  } else if ((unsigned int) nfds < size / 4 && size > UV__EPOLL_BATCH_MIN) {
+    if (++batch->underused < UV__EPOLL_BATCH_DECAY)
+      return;
+    batch->underused = 0;
+    size /= 2;
+  } else {
+    batch->underused = 0;
+    return;
+  }
+
+  events = uv__realloc(batch->events, size * sizeof(struct epoll_event));
+  if (events == NULL)
+    return;
+
+  batch->events = events;
+  batch->size = size;
+}
+
+
 void uv__io_poll(uv_loop_t* loop, int timeout) {
   /* A bug in kernels < 2.6.37 makes timeouts larger than ~30 minutes
    * effectively infinite on 32 bits architectures.  To avoid blocking
@@ -197,9 +801,11 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
    * that being the largest value I have seen in the wild (and only once.)
    */
   static const int max_safe_timeout = 1789569;
-  struct epoll_event events[1024];
+  struct uv__epoll_batch* batch;
+  struct epoll_event* events;
   struct epoll_event* pe;
   struct epoll_event e;
+  struct uv__iou* iou;
   int real_timeout;
   QUEUE* q;
   uv__io_t* w;
@@ -209,12 +815,16 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   int have_signals;
   int nevents;
   int count;
+  int full;
   int nfds;
   int fd;
   int op;
   int i;
 
-  if (loop->nfds == 0) {
+  iou = &uv__get_internal_fields(loop)->iou;
+  batch = &uv__get_internal_fields(loop)->epoll_batch;
+
+  if (loop->nfds == 0 && iou->in_flight == 0) {
     assert(QUEUE_EMPTY(&loop->watcher_queue));
     return;
   }
@@ -242,7 +852,9 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     /* XXX Future optimization: do EPOLL_CTL_MOD lazily if we stop watching
      * events, skip the syscall and squelch the events after epoll_wait().
      */
-    if (epoll_ctl(loop->backend_fd, op, w->fd, &e)) {
+    if (w->pevents & UV__POLLEXCLUSIVE)
+      uv__epoll_ctl_exclusive(loop->backend_fd, op, w->fd, &e);
+    else if (epoll_ctl(loop->backend_fd, op, w->fd, &e)) {
       if (errno != EEXIST)
         abort();
 
@@ -275,12 +887,20 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     if (sizeof(int32_t) == sizeof(long) && timeout >= max_safe_timeout)
       timeout = max_safe_timeout;
 
+    if (iou->unsubmitted > 0)
+      uv__iou_flush(iou);
+
+    uv__metrics_phase(loop, UV_LOOP_PHASE_POLL);
+
+    events = batch->events;
     nfds = epoll_pwait(loop->backend_fd,
                        events,
-                       ARRAY_SIZE(events),
+                       batch->size,
                        timeout,
                        psigset);
 
+    SAVE_ERRNO(uv__metrics_phase(loop, UV_LOOP_PHASE_POLL_WAIT));
+
     /* Update loop->time unconditionally. It's tempting to skip the update when
      * timeout == 0 (i.e. non-blocking poll) but there is no guarantee that the
      * operating system didn't reschedule our process while in the syscall.
@@ -327,6 +947,12 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
       if (fd == -1)
         continue;
 
+      if (fd == iou->ringfd) {
+        uv__poll_io_uring(loop, iou);
+        nevents++;
+        continue;
+      }
+
       assert(fd >= 0);
       assert((unsigned) fd < loop->nwatchers);
 
@@ -387,11 +1013,15 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     loop->watchers[loop->nwatchers] = NULL;
     loop->watchers[loop->nwatchers + 1] = NULL;
 
+    /* Safe now that nothing refers to the events anymore. */
+    full = nfds == (int) batch->size;
+    uv__epoll_batch_adjust(batch, nfds);
+
     if (have_signals != 0)
       return;  /* Event loop should cycle now so don't poll again. */
 
     if (nevents != 0) {
-      if (nfds == ARRAY_SIZE(events) && --count != 0) {
+      if (full && --count != 0) {
         /* Poll for more events but don't block this time. */
         timeout = 0;
         continue;
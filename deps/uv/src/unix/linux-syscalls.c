@@ -117,6 +117,22 @@
 # endif
 #endif /* __NR_inotify_rm_watch */
 
+#ifndef __NR_io_uring_setup
+# if defined(__arm__)
+#  define __NR_io_uring_setup (UV_SYSCALL_BASE + 425)
+# elif !defined(__alpha__)
+#  define __NR_io_uring_setup 425
+# endif
+#endif /* __NR_io_uring_setup */
+
+#ifndef __NR_io_uring_enter
+# if defined(__arm__)
+#  define __NR_io_uring_enter (UV_SYSCALL_BASE + 426)
+# elif !defined(__alpha__)
+#  define __NR_io_uring_enter 426
+# endif
+#endif /* __NR_io_uring_enter */
+
 #ifndef __NR_pipe2
 # if defined(__x86_64__)
 #  define __NR_pipe2 293
@@ -271,6 +287,34 @@ int uv__inotify_rm_watch(int fd, int32_t wd) {
 }
 
 
+int uv__io_uring_setup(unsigned int entries, struct uv__io_uring_params* params) {
+#if defined(__NR_io_uring_setup)
+  return syscall(__NR_io_uring_setup, entries, params);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
+int uv__io_uring_enter(int fd,
+                       unsigned int to_submit,
+                       unsigned int min_complete,
+                       unsigned int flags) {
+#if defined(__NR_io_uring_enter)
+  /* The last two arguments are the signal mask and its size. */
+  return syscall(__NR_io_uring_enter,
+                 fd,
+                 to_submit,
+                 min_complete,
+                 flags,
+                 NULL,
+                 0L);
+#else
+  return errno = ENOSYS, -1;
+#endif
+}
+
+
 int uv__pipe2(int pipefd[2], int flags) {
 #if defined(__NR_pipe2)
   int result;
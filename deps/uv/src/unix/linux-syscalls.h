@@ -93,6 +93,119 @@ struct uv__mmsghdr {
   unsigned int msg_len;
 };
 
+/* io_uring flags and opcodes. Defined here rather than taken from
+ * <linux/io_uring.h> so libuv builds against older kernel headers.
+ */
+#define UV__IORING_FEAT_SINGLE_MMAP   1u
+#define UV__IORING_FEAT_NODROP        2u
+#define UV__IORING_FEAT_RW_CUR_POS    8u
+
+#define UV__IORING_ENTER_GETEVENTS    1u
+
+#define UV__IORING_SQ_CQ_OVERFLOW     2u
+
+#define UV__IORING_FSYNC_DATASYNC     1u
+
+#define UV__IORING_OFF_SQ_RING        0
+#define UV__IORING_OFF_SQES           0x10000000
+
+enum {
+  UV__IORING_OP_READV = 1,
+  UV__IORING_OP_WRITEV = 2,
+  UV__IORING_OP_FSYNC = 3,
+  UV__IORING_OP_OPENAT = 18,
+  UV__IORING_OP_CLOSE = 19,
+  UV__IORING_OP_STATX = 21
+};
+
+struct uv__io_sqring_offsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t reserved0;
+  uint64_t reserved1;
+};
+
+struct uv__io_cqring_offsets {
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint64_t reserved0;
+  uint64_t reserved1;
+};
+
+struct uv__io_uring_params {
+  uint32_t sq_entries;
+  uint32_t cq_entries;
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;
+  uint32_t reserved[4];
+  struct uv__io_sqring_offsets sq_off;  /* 40 bytes. */
+  struct uv__io_cqring_offsets cq_off;  /* 40 bytes. */
+};
+
+/* The kernel's struct io_uring_sqe uses unions for most fields; we only
+ * name the members that libuv fills in.  |off| doubles as addr2 and
+ * |rw_flags| as fsync_flags, open_flags and statx_flags.
+ */
+struct uv__io_uring_sqe {
+  uint8_t opcode;
+  uint8_t flags;
+  uint16_t ioprio;
+  int32_t fd;
+  uint64_t off;
+  uint64_t addr;
+  uint32_t len;
+  uint32_t rw_flags;
+  uint64_t user_data;
+  uint64_t pad[3];
+};
+
+struct uv__io_uring_cqe {
+  uint64_t user_data;
+  int32_t res;
+  uint32_t flags;
+};
+
+struct uv__statx_timestamp {
+  int64_t tv_sec;
+  uint32_t tv_nsec;
+  int32_t unused0;
+};
+
+struct uv__statx {
+  uint32_t stx_mask;
+  uint32_t stx_blksize;
+  uint64_t stx_attributes;
+  uint32_t stx_nlink;
+  uint32_t stx_uid;
+  uint32_t stx_gid;
+  uint16_t stx_mode;
+  uint16_t unused0;
+  uint64_t stx_ino;
+  uint64_t stx_size;
+  uint64_t stx_blocks;
+  uint64_t stx_attributes_mask;
+  struct uv__statx_timestamp stx_atime;
+  struct uv__statx_timestamp stx_btime;
+  struct uv__statx_timestamp stx_ctime;
+  struct uv__statx_timestamp stx_mtime;
+  uint32_t stx_rdev_major;
+  uint32_t stx_rdev_minor;
+  uint32_t stx_dev_major;
+  uint32_t stx_dev_minor;
+  uint64_t unused1[14];
+};
+
 int uv__accept4(int fd, struct sockaddr* addr, socklen_t* addrlen, int flags);
 int uv__eventfd(unsigned int count);
 int uv__eventfd2(unsigned int count, int flags);
@@ -100,6 +213,11 @@ int uv__inotify_init(void);
 int uv__inotify_init1(int flags);
 int uv__inotify_add_watch(int fd, const char* path, uint32_t mask);
 int uv__inotify_rm_watch(int fd, int32_t wd);
+int uv__io_uring_setup(unsigned int entries, struct uv__io_uring_params* params);
+int uv__io_uring_enter(int fd,
+                       unsigned int to_submit,
+                       unsigned int min_complete,
+                       unsigned int flags);
 int uv__pipe2(int pipefd[2], int flags);
 int uv__recvmmsg(int fd,
                  struct uv__mmsghdr* mmsg,
@@ -185,7 +185,9 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
     if (pset != NULL)
       if (pthread_sigmask(SIG_BLOCK, pset, NULL))
         abort();
+    uv__metrics_phase(loop, UV_LOOP_PHASE_POLL);
     nfds = poll(loop->poll_fds, (nfds_t)loop->poll_fds_used, timeout);
+    SAVE_ERRNO(uv__metrics_phase(loop, UV_LOOP_PHASE_POLL_WAIT));
     if (pset != NULL)
       if (pthread_sigmask(SIG_UNBLOCK, pset, NULL))
         abort();
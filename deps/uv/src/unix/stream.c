@@ -35,6 +35,11 @@
 #include <unistd.h>
 #include <limits.h> /* IOV_MAX */
 
+#if defined(__linux__)
+# include <netinet/in.h>
+# include <linux/errqueue.h>
+#endif
+
 #if defined(__APPLE__)
 # include <sys/event.h>
 # include <sys/time.h>
@@ -72,6 +77,18 @@ static void uv__read(uv_stream_t* stream);
 static void uv__stream_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
 static void uv__write_callbacks(uv_stream_t* stream);
 static size_t uv__write_req_size(uv_write_t* req);
+#if defined(__linux__)
+static void uv__stream_zerocopy_close(uv_stream_t* stream);
+#endif
+
+/* A write request that was sent with MSG_ZEROCOPY remembers how many
+ * zero-copy sends the kernel has to be done with before the request is
+ * complete.
+ */
+#define UV__WRITE_ZEROCOPY_ID(req) ((req)->reserved[0])
+#define UV__WRITE_ZEROCOPY(req) ((req)->reserved[1])
+
+void uv_try_write_cb(uv_write_t* req, int status);
 
 
 void uv__stream_init(uv_loop_t* loop,
@@ -457,6 +474,7 @@ void uv__stream_destroy(uv_stream_t* stream) {
     stream->connect_req = NULL;
   }
 
+  uv__stream_zerocopy_destroy(stream);
   uv__stream_flush_write_queue(stream, UV_ECANCELED);
   uv__write_callbacks(stream);
 
@@ -526,7 +544,7 @@ void uv__server_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
   assert(stream->accepted_fd == -1);
   assert(!(stream->flags & UV_HANDLE_CLOSING));
 
-  uv__io_start(stream->loop, &stream->io_watcher, POLLIN);
+  uv__io_start(stream->loop, &stream->io_watcher, UV__ACCEPT_EVENTS(stream));
 
   /* connection_cb can close the server socket while we're
    * in the loop so check it on each iteration.
@@ -639,7 +657,9 @@ done:
   } else {
     server->accepted_fd = -1;
     if (err == 0)
-      uv__io_start(server->loop, &server->io_watcher, POLLIN);
+      uv__io_start(server->loop,
+                   &server->io_watcher,
+                   UV__ACCEPT_EVENTS(server));
   }
   return err;
 }
@@ -712,6 +732,291 @@ static size_t uv__write_req_size(uv_write_t* req) {
 }
 
 
+#if defined(__linux__)
+/* Moves the requests whose buffers the kernel is done with from the
+ * zero-copy pending queue to the write_completed_queue.
+ */
+static void uv__stream_zerocopy_release(uv_stream_t* stream) {
+  uv__tcp_zerocopy_t* zc;
+  uv_write_t* req;
+  QUEUE* q;
+
+  zc = uv__tcp_zerocopy(stream);
+
+  while (!QUEUE_EMPTY(&zc->pending_queue)) {
+    q = QUEUE_HEAD(&zc->pending_queue);
+    req = QUEUE_DATA(q, uv_write_t, queue);
+    if ((int) (zc->completed -
+               (unsigned int) (uintptr_t) UV__WRITE_ZEROCOPY_ID(req)) < 0) {
+      break;
+    }
+
+    QUEUE_REMOVE(q);
+    QUEUE_INSERT_TAIL(&stream->write_completed_queue, q);
+    uv__io_feed(stream->loop, &stream->io_watcher);
+  }
+
+  if (!QUEUE_EMPTY(&zc->pending_queue))
+    return;
+
+  /* uv_close() waits for all zero-copy sends, including those of requests
+   * that were not finished, see uv__stream_zerocopy_linger().
+   */
+  if (stream->flags & UV_HANDLE_CLOSING) {
+    if (zc->completed != zc->sent)
+      return;
+    uv__stream_zerocopy_close(stream);
+    return;
+  }
+
+  uv__io_stop(stream->loop, &stream->io_watcher, UV__POLLPRI);
+}
+
+
+/* Ends the wait of uv__stream_zerocopy_linger() and closes the stream. */
+static void uv__stream_zerocopy_close(uv_stream_t* stream) {
+  if (uv__tcp_zerocopy(stream)->lingering)
+    uv_timer_stop(&uv__tcp_zerocopy(stream)->linger_timer);
+  uv__io_stop(stream->loop, &stream->io_watcher, UV__POLLPRI);
+  uv__tcp_close((uv_tcp_t*) stream);
+  uv__make_close_pending((uv_handle_t*) stream);
+}
+
+
+/* The kernel did not release the buffers in time, most likely because the
+ * peer stopped reading. Reset the connection, which drops the data that was
+ * not sent yet; the requests that still wait are canceled.
+ */
+static void uv__stream_zerocopy_linger_timeout(uv_timer_t* timer) {
+  uv_stream_t* stream;
+  struct linger l;
+
+  stream = timer->data;
+  l.l_onoff = 1;
+  l.l_linger = 0;
+  setsockopt(uv__stream_fd(stream), SOL_SOCKET, SO_LINGER, &l, sizeof(l));
+  uv__stream_zerocopy_close(stream);
+}
+
+
+static void uv__stream_zerocopy_free(uv_handle_t* timer) {
+  uv__free(container_of(timer, uv__tcp_zerocopy_t, linger_timer));
+}
+
+
+/* Reads the completion notifications for zero-copy sends from the socket's
+ * error queue.
+ */
+static void uv__stream_zerocopy_complete(uv_stream_t* stream) {
+  struct sock_extended_err* serr;
+  uv__tcp_zerocopy_t* zc;
+  struct cmsghdr* cmsg;
+  struct msghdr msg;
+  char control[256];
+  int fd;
+  int r;
+
+  zc = uv__tcp_zerocopy(stream);
+  fd = uv__stream_fd(stream);
+
+  for (;;) {
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    do
+      r = recvmsg(fd, &msg, MSG_ERRQUEUE);
+    while (r == -1 && errno == EINTR);
+
+    if (r == -1)
+      break;
+
+    for (cmsg = CMSG_FIRSTHDR(&msg);
+         cmsg != NULL;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+
+      serr = (struct sock_extended_err*) CMSG_DATA(cmsg);
+      if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+        continue;
+
+      /* The kernel reports ranges of sends, TCP releases them in order. */
+      if ((int) (serr->ee_data + 1 - zc->completed) > 0)
+        zc->completed = serr->ee_data + 1;
+    }
+  }
+
+  uv__stream_zerocopy_release(stream);
+}
+
+
+/* Returns 1 if the finished request has to wait for the kernel to release
+ * its buffers, or for earlier requests that do.
+ */
+static int uv__write_req_zerocopy_defer(uv_write_t* req) {
+  uv_stream_t* stream;
+  uv__tcp_zerocopy_t* zc;
+
+  stream = req->handle;
+  if (stream->type != UV_TCP || req->cb == uv_try_write_cb)
+    return 0;
+
+  zc = uv__tcp_zerocopy(stream);
+  if (zc == NULL)
+    return 0;
+  if (UV__WRITE_ZEROCOPY(req) == NULL && QUEUE_EMPTY(&zc->pending_queue))
+    return 0;
+
+  if (UV__WRITE_ZEROCOPY(req) == NULL)
+    UV__WRITE_ZEROCOPY_ID(req) = (void*) (uintptr_t) zc->sent;
+
+  QUEUE_INSERT_TAIL(&zc->pending_queue, &req->queue);
+  /* There may be nothing else to wait for on the socket, but the completion
+   * notifications only arrive while it is registered with the backend.
+   */
+  uv__io_start(stream->loop, &stream->io_watcher, UV__POLLPRI);
+  uv__stream_zerocopy_release(stream);
+  return 1;
+}
+
+
+static ssize_t uv__write_zerocopy(uv_stream_t* stream,
+                                  uv_write_t* req,
+                                  struct iovec* iov,
+                                  int iovcnt) {
+  uv__tcp_zerocopy_t* zc;
+  struct msghdr msg;
+  ssize_t n;
+
+  zc = uv__tcp_zerocopy(stream);
+
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = iovcnt;
+
+  do
+    n = sendmsg(uv__stream_fd(stream), &msg, MSG_ZEROCOPY);
+  while (n == -1 && errno == EINTR);
+
+  /* ENOBUFS means that the socket's option memory limit for notifications
+   * is exhausted. Fall back to a copy.
+   */
+  if (n == -1 && errno == ENOBUFS) {
+    do
+      n = writev(uv__stream_fd(stream), iov, iovcnt);
+    while (n == -1 && errno == EINTR);
+    return n;
+  }
+
+  if (n > 0) {
+    zc->sent++;
+    UV__WRITE_ZEROCOPY_ID(req) = (void*) (uintptr_t) zc->sent;
+    UV__WRITE_ZEROCOPY(req) = zc;
+  }
+
+  return n;
+}
+#endif  /* defined(__linux__) */
+
+
+/* Called by uv_close(). Returns 1 if the kernel may still read from the
+ * buffers of zero-copy sends. The socket then stays open, but nothing else
+ * is done with it, until the kernel has released all of them; only then is
+ * it closed and the close callback called. Otherwise, the owner of the
+ * buffers could reuse them while the data is still being sent.
+ *
+ * The wait lasts as long as SO_LINGER says, or UV__ZEROCOPY_LINGER_TIMEOUT
+ * if it is not set. After that, the connection is reset.
+ */
+int uv__stream_zerocopy_linger(uv_stream_t* stream) {
+#if defined(__linux__)
+  uv__tcp_zerocopy_t* zc;
+  struct linger l;
+  socklen_t len;
+  uint64_t timeout;
+
+  if (stream->type != UV_TCP || uv__stream_fd(stream) == -1)
+    return 0;
+
+  zc = uv__tcp_zerocopy(stream);
+  if (zc == NULL || zc->completed == zc->sent)
+    return 0;
+
+  timeout = UV__ZEROCOPY_LINGER_TIMEOUT;
+  len = sizeof(l);
+  if (getsockopt(uv__stream_fd(stream), SOL_SOCKET, SO_LINGER, &l, &len) == 0 &&
+      l.l_onoff) {
+    /* A zero timeout resets the connection on close() already. */
+    if (l.l_linger == 0)
+      return 0;
+    timeout = (uint64_t) l.l_linger * 1000;
+  }
+
+  /* The timer keeps the loop alive while the stream, which is not active
+   * anymore, waits.
+   */
+  uv_timer_init(stream->loop, &zc->linger_timer);
+  zc->linger_timer.flags |= UV_HANDLE_INTERNAL;
+  zc->linger_timer.data = stream;
+  zc->lingering = 1;
+  uv_timer_start(&zc->linger_timer,
+                 uv__stream_zerocopy_linger_timeout,
+                 timeout,
+                 0);
+
+  /* Only UV__POLLPRI stays registered, for the completion notifications.
+   * Requests that were not written completely are canceled as usual once
+   * the stream is destroyed.
+   */
+  uv_read_stop(stream);
+  uv__io_start(stream->loop, &stream->io_watcher, UV__POLLPRI);
+  uv__io_stop(stream->loop, &stream->io_watcher, POLLIN | POLLOUT);
+  uv__handle_stop(stream);
+  stream->flags &= ~(UV_HANDLE_READABLE | UV_HANDLE_WRITABLE);
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+
+/* Completes the requests that still wait for zero-copy sends when the
+ * stream is destroyed without uv__stream_zerocopy_linger(), which only
+ * happens if its socket was gone already.
+ */
+void uv__stream_zerocopy_destroy(uv_stream_t* stream) {
+#if defined(__linux__)
+  uv__tcp_zerocopy_t* zc;
+  uv_write_t* req;
+  QUEUE* q;
+
+  if (stream->type != UV_TCP)
+    return;
+
+  zc = uv__tcp_zerocopy(stream);
+  if (zc == NULL)
+    return;
+
+  while (!QUEUE_EMPTY(&zc->pending_queue)) {
+    q = QUEUE_HEAD(&zc->pending_queue);
+    req = QUEUE_DATA(q, uv_write_t, queue);
+    req->error = UV_ECANCELED;
+    QUEUE_REMOVE(q);
+    QUEUE_INSERT_TAIL(&stream->write_completed_queue, q);
+  }
+
+  if (zc->lingering)
+    uv_close((uv_handle_t*) &zc->linger_timer, uv__stream_zerocopy_free);
+  else
+    uv__free(zc);
+  stream->u.reserved[0] = NULL;
+#endif
+}
+
+
 static void uv__write_req_finish(uv_write_t* req) {
   uv_stream_t* stream = req->handle;
 
@@ -730,6 +1035,11 @@ static void uv__write_req_finish(uv_write_t* req) {
     req->bufs = NULL;
   }
 
+#if defined(__linux__)
+  if (req->error == 0 && uv__write_req_zerocopy_defer(req))
+    return;
+#endif
+
   /* Add it to the write_completed_queue where it will have its
    * callback called in the near future.
    */
@@ -845,6 +1155,14 @@ start:
     while (n == -1 && (errno == EINTR || errno == EPROTOTYPE));
 #else
     while (n == -1 && errno == EINTR);
+#endif
+#if defined(__linux__)
+  } else if (stream->type == UV_TCP &&
+             uv__tcp_zerocopy(stream) != NULL &&
+             uv__tcp_zerocopy(stream)->enabled &&
+             uv__count_bufs((uv_buf_t*) iov, iovcnt) >=
+                 uv__tcp_zerocopy(stream)->min_size) {
+    n = uv__write_zerocopy(stream, req, iov, iovcnt);
 #endif
   } else {
     do {
@@ -868,6 +1186,14 @@ start:
   }
 
   if (n < 0) {
+#if defined(__linux__)
+    /* The first write on a TCP Fast Open socket without a cookie for the
+     * peer only sends the SYN. The data goes out once the handshake is done
+     * and the socket becomes writable.
+     */
+    if (errno == EINPROGRESS && (stream->flags & UV_HANDLE_TCP_FASTOPEN))
+      errno = EAGAIN;
+#endif
     if (!WRITE_RETRY_ON_ERROR(req->send_handle)) {
       err = UV__ERR(errno);
       goto error;
@@ -1310,6 +1636,15 @@ static void uv__stream_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
   assert(stream->type == UV_TCP ||
          stream->type == UV_NAMED_PIPE ||
          stream->type == UV_TTY);
+
+#if defined(__linux__)
+  /* A closing stream only waits for its zero-copy sends to complete. */
+  if (stream->flags & UV_HANDLE_CLOSING) {
+    uv__stream_zerocopy_complete(stream);
+    return;
+  }
+#endif
+
   assert(!(stream->flags & UV_HANDLE_CLOSING));
 
   if (stream->connect_req) {
@@ -1319,6 +1654,14 @@ static void uv__stream_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
 
   assert(uv__stream_fd(stream) >= 0);
 
+#if defined(__linux__)
+  if ((events & (POLLERR | UV__POLLPRI)) &&
+      stream->type == UV_TCP &&
+      uv__tcp_zerocopy(stream) != NULL) {
+    uv__stream_zerocopy_complete(stream);
+  }
+#endif
+
   /* Ignore POLLHUP here. Even if it's set, there may still be data to read. */
   if (events & (POLLIN | POLLERR | POLLHUP))
     uv__read(stream);
@@ -1462,6 +1805,7 @@ int uv_write2(uv_write_t* req,
   req->handle = stream;
   req->error = 0;
   req->send_handle = send_handle;
+  UV__WRITE_ZEROCOPY(req) = NULL;
   QUEUE_INIT(&req->queue);
 
   req->bufs = req->bufsml;
@@ -1535,6 +1879,16 @@ int uv_try_write(uv_stream_t* stream,
   if (stream->connect_req != NULL || stream->write_queue_size != 0)
     return UV_EAGAIN;
 
+#if defined(__linux__)
+  /* Zero-copy sends need the buffers until the kernel releases them. */
+  if (stream->type == UV_TCP &&
+      uv__tcp_zerocopy(stream) != NULL &&
+      uv__tcp_zerocopy(stream)->enabled &&
+      uv__count_bufs(bufs, nbufs) >= uv__tcp_zerocopy(stream)->min_size) {
+    return UV_EAGAIN;
+  }
+#endif
+
   has_pollout = uv__io_active(&stream->io_watcher, POLLOUT);
 
   r = uv_write(&req, stream, bufs, nbufs, uv_try_write_cb);
@@ -1709,3 +2063,27 @@ int uv_stream_set_blocking(uv_stream_t* handle, int blocking) {
    */
   return uv__nonblock(uv__stream_fd(handle), !blocking);
 }
+
+
+int uv_stream_set_exclusive_accept(uv_stream_t* handle, int enable) {
+#if defined(__linux__)
+  if (handle->type != UV_TCP && handle->type != UV_NAMED_PIPE)
+    return UV_EINVAL;
+
+  /* The watcher is registered with the kernel on the next loop iteration
+   * and toggling the flag afterwards would need an EPOLL_CTL_DEL/ADD cycle,
+   * which EPOLLEXCLUSIVE does not allow through EPOLL_CTL_MOD either.
+   */
+  if (uv__io_active(&handle->io_watcher, POLLIN))
+    return UV_EBUSY;
+
+  if (enable)
+    handle->flags |= UV_HANDLE_EXCLUSIVE_ACCEPT;
+  else
+    handle->flags &= ~UV_HANDLE_EXCLUSIVE_ACCEPT;
+
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
@@ -123,6 +123,7 @@ int uv_tcp_init_ex(uv_loop_t* loop, uv_tcp_t* tcp, unsigned int flags) {
     return UV_EINVAL;
 
   uv__stream_init(loop, (uv_stream_t*)tcp, UV_TCP);
+  tcp->u.reserved[0] = NULL;
 
   /* If anything fails beyond this point we need to remove the handle from
    * the handle queue, since it was added by uv__handle_init in uv_stream_init.
@@ -164,6 +165,12 @@ int uv__tcp_bind(uv_tcp_t* tcp,
   if (setsockopt(tcp->io_watcher.fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)))
     return UV__ERR(errno);
 
+  if (flags & UV_TCP_REUSEPORT) {
+    err = uv__sock_reuseport(tcp->io_watcher.fd);
+    if (err)
+      return err;
+  }
+
 #ifndef __OpenBSD__
 #ifdef IPV6_V6ONLY
   if (addr->sa_family == AF_INET6) {
@@ -220,6 +227,23 @@ int uv__tcp_connect(uv_connect_t* req,
   if (err)
     return err;
 
+#if defined(__linux__)
+  /* The kernel holds back the SYN until the first write and sends the data
+   * along with it when it has a Fast Open cookie for the peer. connect()
+   * succeeds right away.
+   */
+  if (handle->flags & UV_HANDLE_TCP_FASTOPEN) {
+    r = 1;
+    if (setsockopt(uv__stream_fd(handle),
+                   IPPROTO_TCP,
+                   TCP_FASTOPEN_CONNECT,
+                   &r,
+                   sizeof(r))) {
+      return UV__ERR(errno);
+    }
+  }
+#endif
+
   handle->delayed_error = 0;
 
   do {
@@ -356,7 +380,7 @@ int uv_tcp_listen(uv_tcp_t* tcp, int backlog, uv_connection_cb cb) {
 
   /* Start listening for connections. */
   tcp->io_watcher.cb = uv__server_io;
-  uv__io_start(tcp->loop, &tcp->io_watcher, POLLIN);
+  uv__io_start(tcp->loop, &tcp->io_watcher, UV__ACCEPT_EVENTS(tcp));
 
   return 0;
 }
@@ -440,6 +464,156 @@ int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable) {
 }
 
 
+int uv_tcp_fastopen(uv_tcp_t* handle, unsigned int qlen) {
+#if defined(TCP_FASTOPEN)
+  int val;
+
+  if (uv__stream_fd(handle) == -1)
+    return UV_EBADF;
+
+  /* Linux takes the length of the queue of pending Fast Open requests, the
+   * BSDs and macOS only look at whether it's zero.
+   */
+  val = qlen;
+  if (setsockopt(uv__stream_fd(handle),
+                 IPPROTO_TCP,
+                 TCP_FASTOPEN,
+                 &val,
+                 sizeof(val))) {
+    return UV__ERR(errno);
+  }
+
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
+int uv_tcp_fastopen_connect(uv_tcp_t* handle, int enable) {
+#if defined(__linux__)
+  if (enable)
+    handle->flags |= UV_HANDLE_TCP_FASTOPEN;
+  else
+    handle->flags &= ~UV_HANDLE_TCP_FASTOPEN;
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
+int uv_tcp_defer_accept(uv_tcp_t* handle, unsigned int timeout) {
+#if defined(TCP_DEFER_ACCEPT)
+  int val;
+
+  if (uv__stream_fd(handle) == -1)
+    return UV_EBADF;
+
+  val = timeout;
+  if (setsockopt(uv__stream_fd(handle),
+                 IPPROTO_TCP,
+                 TCP_DEFER_ACCEPT,
+                 &val,
+                 sizeof(val))) {
+    return UV__ERR(errno);
+  }
+
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
+int uv_tcp_accept_backlog(const uv_tcp_t* handle, unsigned int* count) {
+#if defined(__linux__)
+  struct tcp_info info;
+  socklen_t len;
+#elif defined(SO_LISTENQLEN)
+  int qlen;
+  socklen_t len;
+#endif
+
+  if (uv__stream_fd(handle) == -1 || handle->connection_cb == NULL)
+    return UV_EINVAL;
+
+#if defined(__linux__)
+  /* For listen sockets tcpi_unacked is the length of the accept queue. */
+  len = sizeof(info);
+  if (getsockopt(uv__stream_fd(handle), IPPROTO_TCP, TCP_INFO, &info, &len))
+    return UV__ERR(errno);
+  *count = info.tcpi_unacked;
+#elif defined(SO_LISTENQLEN)
+  len = sizeof(qlen);
+  if (getsockopt(uv__stream_fd(handle),
+                 SOL_SOCKET,
+                 SO_LISTENQLEN,
+                 &qlen,
+                 &len)) {
+    return UV__ERR(errno);
+  }
+  *count = qlen;
+#else
+  return UV_ENOTSUP;
+#endif
+
+  /* The connection that was accepted but not yet passed to uv_accept(). */
+  if (handle->accepted_fd != -1)
+    *count += 1;
+
+  return 0;
+}
+
+
+int uv_tcp_zerocopy(uv_tcp_t* handle, int enable, unsigned int min_size) {
+#if defined(__linux__)
+  uv__tcp_zerocopy_t* zc;
+  int on;
+
+  if (uv__stream_fd(handle) == -1)
+    return UV_EBADF;
+
+  zc = uv__tcp_zerocopy(handle);
+
+  if (enable && (zc == NULL || !zc->enabled)) {
+    on = 1;
+    if (setsockopt(uv__stream_fd(handle),
+                   SOL_SOCKET,
+                   SO_ZEROCOPY,
+                   &on,
+                   sizeof(on))) {
+      return UV__ERR(errno);
+    }
+  }
+
+  /* Keep the state around once it exists, writes that are still waiting for
+   * the kernel need it to complete.
+   */
+  if (zc == NULL) {
+    if (!enable)
+      return 0;
+
+    zc = uv__malloc(sizeof(*zc));
+    if (zc == NULL)
+      return UV_ENOMEM;
+
+    zc->sent = 0;
+    zc->completed = 0;
+    zc->lingering = 0;
+    QUEUE_INIT(&zc->pending_queue);
+    handle->u.reserved[0] = zc;
+  }
+
+  zc->enabled = enable;
+  zc->min_size = min_size;
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
 void uv__tcp_close(uv_tcp_t* handle) {
   uv__stream_close((uv_stream_t*)handle);
 }
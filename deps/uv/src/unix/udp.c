@@ -39,6 +39,27 @@
 # define IPV6_DROP_MEMBERSHIP IPV6_LEAVE_GROUP
 #endif
 
+/* The largest datagram recvmsg() is asked to receive, and therefore the size
+ * of every slot of a recvmmsg() buffer.
+ */
+#define UV__UDP_DGRAM_MAXSIZE (64 * 1024)
+
+#if defined(__linux__)
+# ifndef UDP_SEGMENT
+#  define UDP_SEGMENT 103
+# endif
+# ifndef UDP_GRO
+#  define UDP_GRO 104
+# endif
+
+/* Most datagrams sendmmsg() and recvmmsg() move per call. */
+# define UV__MMSG_MAXWIDTH 32
+
+/* Set once the kernel says ENOSYS, from then on it's one datagram per call. */
+static int uv__sendmmsg_unsupported;
+static int uv__recvmmsg_unsupported;
+#endif
+
 
 static void uv__udp_run_completed(uv_udp_t* handle);
 static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents);
@@ -148,8 +169,100 @@ static void uv__udp_io(uv_loop_t* loop, uv__io_t* w, unsigned int revents) {
 }
 
 
+#if defined(__linux__)
+/* Receives as many datagrams as there are UV__UDP_DGRAM_MAXSIZE slots in |buf|
+ * with a single system call.  Every datagram is reported with the
+ * UV_UDP_MMSG_CHUNK flag, followed by one UV_UDP_MMSG_FREE callback that hands
+ * |buf| back.  Returns the number of datagrams, -1 after reporting an error or
+ * EAGAIN the usual way, or UV_ENOSYS without calling recv_cb at all.
+ */
+static ssize_t uv__udp_recvmmsg(uv_udp_t* handle, uv_buf_t* buf) {
+  struct sockaddr_storage peers[UV__MMSG_MAXWIDTH];
+  struct iovec iov[UV__MMSG_MAXWIDTH];
+  struct uv__mmsghdr msgs[UV__MMSG_MAXWIDTH];
+  const struct sockaddr* addr;
+  uv_buf_t chunk_buf;
+  ssize_t nread;
+  size_t chunks;
+  size_t k;
+  int flags;
+
+  chunks = buf->len / UV__UDP_DGRAM_MAXSIZE;
+  if (chunks > ARRAY_SIZE(iov))
+    chunks = ARRAY_SIZE(iov);
+
+  memset(msgs, 0, chunks * sizeof(msgs[0]));
+  for (k = 0; k < chunks; k++) {
+    iov[k].iov_base = buf->base + k * UV__UDP_DGRAM_MAXSIZE;
+    iov[k].iov_len = UV__UDP_DGRAM_MAXSIZE;
+    msgs[k].msg_hdr.msg_iov = iov + k;
+    msgs[k].msg_hdr.msg_iovlen = 1;
+    msgs[k].msg_hdr.msg_name = peers + k;
+    msgs[k].msg_hdr.msg_namelen = sizeof(peers[0]);
+  }
+
+  do
+    nread = uv__recvmmsg(handle->io_watcher.fd, msgs, chunks, 0, NULL);
+  while (nread == -1 && errno == EINTR);
+
+  if (nread == -1 && errno == ENOSYS) {
+    uv__recvmmsg_unsupported = 1;
+    return UV_ENOSYS;
+  }
+
+  if (nread < 1) {
+    if (nread == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+      handle->recv_cb(handle, 0, buf, NULL, 0);
+    else
+      handle->recv_cb(handle, UV__ERR(errno), buf, NULL, 0);
+    return -1;
+  }
+
+  /* recv_cb may stop receiving or close the handle midway. */
+  for (k = 0; k < (size_t) nread && handle->recv_cb != NULL; k++) {
+    flags = UV_UDP_MMSG_CHUNK;
+    if (msgs[k].msg_hdr.msg_flags & MSG_TRUNC)
+      flags |= UV_UDP_PARTIAL;
+
+    addr = NULL;
+    if (msgs[k].msg_hdr.msg_namelen != 0)
+      addr = msgs[k].msg_hdr.msg_name;
+
+    chunk_buf = uv_buf_init(iov[k].iov_base, iov[k].iov_len);
+    handle->recv_cb(handle, msgs[k].msg_len, &chunk_buf, addr, flags);
+  }
+
+  if (handle->recv_cb != NULL)
+    handle->recv_cb(handle, 0, buf, NULL, UV_UDP_MMSG_FREE);
+
+  return nread;
+}
+#endif
+
+
+#if defined(__linux__)
+/* Returns the segment size of a buffer of coalesced datagrams, or 0. */
+static int uv__udp_gro_segment_size(struct msghdr* h) {
+  struct cmsghdr* cmsg;
+  int segment_size;
+
+  for (cmsg = CMSG_FIRSTHDR(h); cmsg != NULL; cmsg = CMSG_NXTHDR(h, cmsg)) {
+    if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size;
+    }
+  }
+
+  return 0;
+}
+#endif
+
+
 static void uv__udp_recvmsg(uv_udp_t* handle) {
   struct sockaddr_storage peer;
+#if defined(__linux__)
+  char control[CMSG_SPACE(sizeof(int))];
+#endif
   struct msghdr h;
   ssize_t nread;
   uv_buf_t buf;
@@ -169,16 +282,34 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 
   do {
     buf = uv_buf_init(NULL, 0);
-    handle->alloc_cb((uv_handle_t*) handle, 64 * 1024, &buf);
+    handle->alloc_cb((uv_handle_t*) handle, UV__UDP_DGRAM_MAXSIZE, &buf);
     if (buf.base == NULL || buf.len == 0) {
       handle->recv_cb(handle, UV_ENOBUFS, &buf, NULL, 0);
       return;
     }
     assert(buf.base != NULL);
 
+#if defined(__linux__)
+    if ((handle->flags & UV_HANDLE_UDP_RECVMMSG) &&
+        !(handle->flags & UV_HANDLE_UDP_GRO) &&
+        buf.len >= 2 * UV__UDP_DGRAM_MAXSIZE &&
+        !uv__recvmmsg_unsupported) {
+      nread = uv__udp_recvmmsg(handle, &buf);
+      if (nread != UV_ENOSYS) {
+        if (nread > 0)
+          count -= nread - 1;
+        continue;
+      }
+    }
+#endif
+
     h.msg_namelen = sizeof(peer);
     h.msg_iov = (void*) &buf;
     h.msg_iovlen = 1;
+#if defined(__linux__)
+    h.msg_control = control;
+    h.msg_controllen = sizeof(control);
+#endif
 
     do {
       nread = recvmsg(handle->io_watcher.fd, &h, 0);
@@ -202,6 +333,12 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
       if (h.msg_flags & MSG_TRUNC)
         flags |= UV_UDP_PARTIAL;
 
+#if defined(__linux__)
+      handle->gro_segment_size = 0;
+      if (handle->flags & UV_HANDLE_UDP_GRO)
+        handle->gro_segment_size = uv__udp_gro_segment_size(&h);
+#endif
+
       handle->recv_cb(handle, nread, &buf, addr, flags);
     }
   }
@@ -213,12 +350,97 @@ static void uv__udp_recvmsg(uv_udp_t* handle) {
 }
 
 
+#if defined(__linux__)
+static void uv__udp_fill_mmsghdr(struct uv__mmsghdr* h,
+                                 struct sockaddr* addr,
+                                 uv_buf_t* bufs,
+                                 unsigned int nbufs) {
+  memset(h, 0, sizeof(*h));
+  h->msg_hdr.msg_name = addr;
+  h->msg_hdr.msg_namelen = (addr->sa_family == AF_INET6 ?
+    sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in));
+  h->msg_hdr.msg_iov = (struct iovec*) bufs;
+  h->msg_hdr.msg_iovlen = nbufs;
+}
+
+
+/* Sends the queued datagrams with as few sendmmsg() calls as possible.
+ * Returns UV_ENOSYS when the kernel doesn't have it and nothing was sent.
+ */
+static int uv__udp_sendmmsg(uv_udp_t* handle) {
+  struct uv__mmsghdr h[UV__MMSG_MAXWIDTH];
+  uv_udp_send_t* req;
+  ssize_t npkts;
+  size_t pkts;
+  size_t i;
+  QUEUE* q;
+
+  while (!QUEUE_EMPTY(&handle->write_queue)) {
+    pkts = 0;
+    q = QUEUE_HEAD(&handle->write_queue);
+    while (pkts < ARRAY_SIZE(h) && q != &handle->write_queue) {
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      uv__udp_fill_mmsghdr(&h[pkts],
+                           (struct sockaddr*) &req->addr,
+                           req->bufs,
+                           req->nbufs);
+      pkts++;
+      q = QUEUE_NEXT(q);
+    }
+
+    do
+      npkts = uv__sendmmsg(handle->io_watcher.fd, h, pkts, 0);
+    while (npkts == -1 && errno == EINTR);
+
+    if (npkts == -1) {
+      if (errno == ENOSYS) {
+        uv__sendmmsg_unsupported = 1;
+        return UV_ENOSYS;
+      }
+
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        return 0;
+
+      /* Only the first datagram failed, the others get another try. */
+      req = QUEUE_DATA(QUEUE_HEAD(&handle->write_queue), uv_udp_send_t, queue);
+      req->status = UV__ERR(errno);
+      QUEUE_REMOVE(&req->queue);
+      QUEUE_INSERT_TAIL(&handle->write_completed_queue, &req->queue);
+      uv__io_feed(handle->loop, &handle->io_watcher);
+      continue;
+    }
+
+    for (i = 0; i < (size_t) npkts; i++) {
+      q = QUEUE_HEAD(&handle->write_queue);
+      req = QUEUE_DATA(q, uv_udp_send_t, queue);
+      req->status = h[i].msg_len;
+      QUEUE_REMOVE(&req->queue);
+      QUEUE_INSERT_TAIL(&handle->write_completed_queue, &req->queue);
+    }
+
+    uv__io_feed(handle->loop, &handle->io_watcher);
+  }
+
+  return 0;
+}
+#endif
+
+
 static void uv__udp_sendmsg(uv_udp_t* handle) {
   uv_udp_send_t* req;
   QUEUE* q;
   struct msghdr h;
   ssize_t size;
 
+#if defined(__linux__)
+  /* One datagram is just as well sent with sendmsg(). */
+  if (!uv__sendmmsg_unsupported &&
+      !QUEUE_EMPTY(&handle->write_queue) &&
+      QUEUE_NEXT(QUEUE_HEAD(&handle->write_queue)) != &handle->write_queue)
+    if (uv__udp_sendmmsg(handle) == 0)
+      return;
+#endif
+
   while (!QUEUE_EMPTY(&handle->write_queue)) {
     q = QUEUE_HEAD(&handle->write_queue);
     assert(q != NULL);
@@ -290,7 +512,7 @@ int uv__udp_bind(uv_udp_t* handle,
   int fd;
 
   /* Check for bad flags. */
-  if (flags & ~(UV_UDP_IPV6ONLY | UV_UDP_REUSEADDR))
+  if (flags & ~(UV_UDP_IPV6ONLY | UV_UDP_REUSEADDR | UV_UDP_REUSEPORT))
     return UV_EINVAL;
 
   /* Cannot set IPv6-only mode on non-IPv6 socket. */
@@ -312,6 +534,12 @@ int uv__udp_bind(uv_udp_t* handle,
       return err;
   }
 
+  if (flags & UV_UDP_REUSEPORT) {
+    err = uv__sock_reuseport(fd);
+    if (err)
+      return err;
+  }
+
   if (flags & UV_UDP_IPV6ONLY) {
 #ifdef IPV6_V6ONLY
     yes = 1;
@@ -484,6 +712,77 @@ int uv__udp_try_send(uv_udp_t* handle,
 }
 
 
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]) {
+#if defined(__linux__)
+  struct uv__mmsghdr h[UV__MMSG_MAXWIDTH];
+  unsigned int pkts;
+  unsigned int i;
+  ssize_t npkts;
+  int err;
+#endif
+  unsigned int sent;
+  int r;
+
+  sent = 0;
+
+#if defined(__linux__)
+  if (handle->send_queue_count != 0)
+    return UV_EAGAIN;
+
+  err = uv__udp_maybe_deferred_bind(handle, addrs[0]->sa_family, 0);
+  if (err)
+    return err;
+
+  while (sent < count && !uv__sendmmsg_unsupported) {
+    pkts = count - sent;
+    if (pkts > ARRAY_SIZE(h))
+      pkts = ARRAY_SIZE(h);
+
+    for (i = 0; i < pkts; i++)
+      uv__udp_fill_mmsghdr(&h[i],
+                           addrs[sent + i],
+                           bufs[sent + i],
+                           nbufs[sent + i]);
+
+    do
+      npkts = uv__sendmmsg(handle->io_watcher.fd, h, pkts, 0);
+    while (npkts == -1 && errno == EINTR);
+
+    if (npkts == -1) {
+      if (errno == ENOSYS) {
+        uv__sendmmsg_unsupported = 1;
+        break;
+      }
+
+      if (sent > 0)
+        return sent;
+
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+        return UV_EAGAIN;
+
+      return UV__ERR(errno);
+    }
+
+    sent += npkts;
+    if ((unsigned int) npkts < pkts)
+      return sent;
+  }
+#endif
+
+  for (; sent < count; sent++) {
+    r = uv_udp_try_send(handle, bufs[sent], nbufs[sent], addrs[sent]);
+    if (r < 0)
+      return sent > 0 ? (int) sent : r;
+  }
+
+  return sent;
+}
+
+
 static int uv__udp_set_membership4(uv_udp_t* handle,
                                    const struct sockaddr_in* multicast_addr,
                                    const char* interface_addr,
@@ -588,7 +887,7 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return UV_EINVAL;
 
-  if (flags & ~0xFF)
+  if (flags & ~0xFF & ~UV_UDP_RECVMMSG)
     return UV_EINVAL;
 
   if (domain != AF_UNSPEC) {
@@ -601,6 +900,9 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   }
 
   uv__handle_init(loop, (uv_handle_t*)handle, UV_UDP);
+  if (flags & UV_UDP_RECVMMSG)
+    handle->flags |= UV_HANDLE_UDP_RECVMMSG;
+  handle->gro_segment_size = 0;
   handle->alloc_cb = NULL;
   handle->recv_cb = NULL;
   handle->send_queue_size = 0;
@@ -720,6 +1022,52 @@ int uv_udp_set_broadcast(uv_udp_t* handle, int on) {
 }
 
 
+int uv_udp_set_gso(uv_udp_t* handle, unsigned int segment_size) {
+#if defined(__linux__)
+  int size;
+
+  if (segment_size > UINT16_MAX)
+    return UV_EINVAL;
+
+  size = segment_size;
+  if (setsockopt(handle->io_watcher.fd,
+                 IPPROTO_UDP,
+                 UDP_SEGMENT,
+                 &size,
+                 sizeof(size))) {
+    return UV__ERR(errno);
+  }
+
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
+int uv_udp_set_gro(uv_udp_t* handle, int on) {
+#if defined(__linux__)
+  on = !!on;
+  if (setsockopt(handle->io_watcher.fd,
+                 IPPROTO_UDP,
+                 UDP_GRO,
+                 &on,
+                 sizeof(on))) {
+    return UV__ERR(errno);
+  }
+
+  if (on)
+    handle->flags |= UV_HANDLE_UDP_GRO;
+  else
+    handle->flags &= ~UV_HANDLE_UDP_GRO;
+
+  return 0;
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
 int uv_udp_set_ttl(uv_udp_t* handle, int ttl) {
   if (ttl < 1 || ttl > 255)
     return UV_EINVAL;
@@ -356,6 +356,26 @@ int uv_udp_try_send(uv_udp_t* handle,
 }
 
 
+int uv_udp_try_send2(uv_udp_t* handle,
+                     unsigned int count,
+                     uv_buf_t* bufs[/*count*/],
+                     unsigned int nbufs[/*count*/],
+                     struct sockaddr* addrs[/*count*/],
+                     unsigned int flags) {
+  unsigned int i;
+
+  if (handle->type != UV_UDP || count < 1 || flags != 0)
+    return UV_EINVAL;
+
+  for (i = 0; i < count; i++)
+    if (nbufs[i] < 1 ||
+        (addrs[i]->sa_family != AF_INET && addrs[i]->sa_family != AF_INET6))
+      return UV_EINVAL;
+
+  return uv__udp_try_send2(handle, count, bufs, nbufs, addrs);
+}
+
+
 int uv_udp_recv_start(uv_udp_t* handle,
                       uv_alloc_cb alloc_cb,
                       uv_udp_recv_cb recv_cb) {
@@ -366,6 +386,11 @@ int uv_udp_recv_start(uv_udp_t* handle,
 }
 
 
+size_t uv_udp_get_gro_segment_size(const uv_udp_t* handle) {
+  return handle->gro_segment_size;
+}
+
+
 int uv_udp_recv_stop(uv_udp_t* handle) {
   if (handle->type != UV_UDP)
     return UV_EINVAL;
@@ -609,8 +634,14 @@ int uv_loop_configure(uv_loop_t* loop, uv_loop_option option, ...) {
   va_list ap;
   int err;
 
-  va_start(ap, option);
   /* Any platform-agnostic options should be handled here. */
+  if (option == UV_METRICS_IDLE_TIME) {
+    uv__get_internal_fields(loop)->loop_metrics.phase_start = uv_hrtime();
+    uv__get_internal_fields(loop)->loop_metrics.enabled = 1;
+    return 0;
+  }
+
+  va_start(ap, option);
   err = uv__loop_configure(loop, option, ap);
   va_end(ap);
 
@@ -618,6 +649,46 @@ int uv_loop_configure(uv_loop_t* loop, uv_loop_option option, ...) {
 }
 
 
+void uv__metrics_start_iteration(uv_loop_t* loop) {
+  struct uv__loop_metrics_s* m;
+
+  m = &uv__get_internal_fields(loop)->loop_metrics;
+  m->metrics.iterations++;
+  m->phase_start = uv_hrtime();
+}
+
+
+void uv__metrics_update_phase(uv_loop_t* loop, uv_loop_phase phase) {
+  struct uv__loop_metrics_s* m;
+  uint64_t now;
+
+  m = &uv__get_internal_fields(loop)->loop_metrics;
+  now = uv_hrtime();
+  m->metrics.phase_time[phase] += now - m->phase_start;
+  m->phase_start = now;
+}
+
+
+uint64_t uv_metrics_idle_time(uv_loop_t* loop) {
+  struct uv__loop_metrics_s* m;
+
+  m = &uv__get_internal_fields(loop)->loop_metrics;
+  return m->metrics.phase_time[UV_LOOP_PHASE_POLL_WAIT];
+}
+
+
+int uv_loop_metrics(const uv_loop_t* loop, uv_loop_metrics_t* metrics) {
+  struct uv__loop_metrics_s* m;
+
+  if (metrics == NULL)
+    return UV_EINVAL;
+
+  m = &uv__get_internal_fields(loop)->loop_metrics;
+  *metrics = m->metrics;
+  return 0;
+}
+
+
 static uv_loop_t default_loop_struct;
 static uv_loop_t* default_loop_ptr;
 
@@ -90,6 +90,9 @@ enum {
   UV_HANDLE_BLOCKING_WRITES             = 0x00100000,
   UV_HANDLE_CANCELLATION_PENDING        = 0x00200000,
 
+  /* Only used by listening streams. */
+  UV_HANDLE_EXCLUSIVE_ACCEPT            = 0x00800000,
+
   /* Used by uv_tcp_t and uv_udp_t handles */
   UV_HANDLE_IPV6                        = 0x00400000,
 
@@ -100,9 +103,12 @@ enum {
   UV_HANDLE_TCP_ACCEPT_STATE_CHANGING   = 0x08000000,
   UV_HANDLE_TCP_SOCKET_CLOSED           = 0x10000000,
   UV_HANDLE_SHARED_TCP_SOCKET           = 0x20000000,
+  UV_HANDLE_TCP_FASTOPEN                = 0x40000000,
 
   /* Only used by uv_udp_t handles. */
   UV_HANDLE_UDP_PROCESSING              = 0x01000000,
+  UV_HANDLE_UDP_RECVMMSG                = 0x02000000,
+  UV_HANDLE_UDP_GRO                     = 0x04000000,
 
   /* Only used by uv_pipe_t handles. */
   UV_HANDLE_NON_OVERLAPPED_PIPE         = 0x01000000,
@@ -122,8 +128,79 @@ enum {
   UV_HANDLE_POLL_SLOW                   = 0x01000000
 };
 
+#ifdef __linux__
+struct uv__iou {
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t* sqarray;
+  uint32_t sqmask;
+  uint32_t* sqflags;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  void* sq;   /* Pointer to munmap() on event loop teardown. */
+  void* cqe;  /* Pointer to array of struct uv__io_uring_cqe. */
+  void* sqe;  /* Pointer to array of struct uv__io_uring_sqe. */
+  size_t maxlen;
+  size_t sqelen;
+  int ringfd;  /* -1 when disabled or unsupported, -2 before first use. */
+  uint32_t unsubmitted;
+  uint32_t in_flight;
+};
+
+/* epoll_wait() output buffer.  Grows while the kernel keeps filling it up
+ * and shrinks back after a stretch of mostly idle polls.
+ */
+struct uv__epoll_batch {
+  void* events;  /* Pointer to array of struct epoll_event. */
+  unsigned int size;
+  unsigned int underused;  /* Consecutive polls that used < 1/4 of |size|. */
+};
+#endif  /* __linux__ */
+
+typedef struct uv__loop_internal_fields_s uv__loop_internal_fields_t;
+
+struct uv__loop_metrics_s {
+  uv_loop_metrics_t metrics;
+  uint64_t phase_start;
+  int enabled;
+};
+
+struct uv__loop_internal_fields_s {
+  unsigned int threadpool_next;  /* Round-robin threadpool queue index. */
+  struct uv__loop_metrics_s loop_metrics;
+#ifdef __linux__
+  struct uv__iou iou;
+  struct uv__epoll_batch epoll_batch;
+#endif  /* __linux__ */
+};
+
+#define uv__get_internal_fields(loop)                                         \
+  ((uv__loop_internal_fields_t*) (loop)->internal_fields)
+
 int uv__loop_configure(uv_loop_t* loop, uv_loop_option option, va_list ap);
 
+/* Per-phase loop time accounting, see UV_METRICS_IDLE_TIME.  uv_run() calls
+ * uv__metrics_start() at the top of every iteration and uv__metrics_phase()
+ * at the end of each phase to charge the time since the previous call to it.
+ */
+void uv__metrics_start_iteration(uv_loop_t* loop);
+void uv__metrics_update_phase(uv_loop_t* loop, uv_loop_phase phase);
+
+#define uv__metrics_start(loop)                                               \
+  do {                                                                        \
+    if (uv__get_internal_fields(loop)->loop_metrics.enabled)                  \
+      uv__metrics_start_iteration(loop);                                      \
+  }                                                                           \
+  while (0)
+
+#define uv__metrics_phase(loop, phase)                                        \
+  do {                                                                        \
+    if (uv__get_internal_fields(loop)->loop_metrics.enabled)                  \
+      uv__metrics_update_phase((loop), (phase));                              \
+  }                                                                           \
+  while (0)
+
 void uv__loop_close(uv_loop_t* loop);
 
 int uv__tcp_bind(uv_tcp_t* tcp,
@@ -156,6 +233,12 @@ int uv__udp_try_send(uv_udp_t* handle,
                      const struct sockaddr* addr,
                      unsigned int addrlen);
 
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]);
+
 int uv__udp_recv_start(uv_udp_t* handle, uv_alloc_cb alloccb,
                        uv_udp_recv_cb recv_cb);
 
@@ -171,14 +254,28 @@ enum uv__work_kind {
   UV__WORK_SLOW_IO
 };
 
+enum uv__work_stage {
+  UV__WORK_START,  /* Picked up by a worker thread. */
+  UV__WORK_END,    /* Finished running. */
+  UV__WORK_DONE    /* Completion dispatched on the loop thread. */
+};
+
 void uv__work_submit(uv_loop_t* loop,
+                     uv_req_t* req,
                      struct uv__work *w,
+                     unsigned int pool,
                      enum uv__work_kind kind,
                      void (*work)(struct uv__work *w),
                      void (*done)(struct uv__work *w, int status));
 
 void uv__work_done(uv_async_t* handle);
 
+/* Work requests that may also run synchronously clear their timing when they
+ * are initialized, and every work and done function marks its stage.
+ */
+void uv__work_timing_clear(uv_req_t* req);
+void uv__work_timing_mark(uv_req_t* req, enum uv__work_stage stage);
+
 size_t uv__count_bufs(const uv_buf_t bufs[], unsigned int nbufs);
 
 int uv__socket_sockopt(uv_handle_t* handle, int optname, int* value);
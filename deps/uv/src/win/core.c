@@ -222,6 +222,7 @@ static void uv_init(void) {
 
 
 int uv_loop_init(uv_loop_t* loop) {
+  uv__loop_internal_fields_t* lfields;
   struct heap* timer_heap;
   int err;
 
@@ -239,6 +240,13 @@ int uv_loop_init(uv_loop_t* loop) {
   loop->time = 0;
   uv_update_time(loop);
 
+  lfields = (uv__loop_internal_fields_t*) uv__calloc(1, sizeof(*lfields));
+  if (lfields == NULL) {
+    err = UV_ENOMEM;
+    goto fail_fields_alloc;
+  }
+  loop->internal_fields = lfields;
+
   QUEUE_INIT(&loop->wq);
   QUEUE_INIT(&loop->handle_queue);
   loop->active_reqs.count = 0;
@@ -297,6 +305,10 @@ fail_mutex_init:
   loop->timer_heap = NULL;
 
 fail_timers_alloc:
+  uv__free(lfields);
+  loop->internal_fields = NULL;
+
+fail_fields_alloc:
   CloseHandle(loop->iocp);
   loop->iocp = INVALID_HANDLE_VALUE;
 
@@ -342,6 +354,9 @@ void uv__loop_close(uv_loop_t* loop) {
   uv__free(loop->timer_heap);
   loop->timer_heap = NULL;
 
+  uv__free(loop->internal_fields);
+  loop->internal_fields = NULL;
+
   CloseHandle(loop->iocp);
 }
 
@@ -513,12 +528,16 @@ int uv_run(uv_loop_t *loop, uv_run_mode mode) {
     uv_update_time(loop);
 
   while (r != 0 && loop->stop_flag == 0) {
+    uv__metrics_start(loop);
     uv_update_time(loop);
     uv__run_timers(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_TIMERS);
 
     ran_pending = uv_process_reqs(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_PENDING);
     uv_idle_invoke(loop);
     uv_prepare_invoke(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_PREPARE);
 
     timeout = 0;
     if ((mode == UV_RUN_ONCE && !ran_pending) || mode == UV_RUN_DEFAULT)
@@ -528,10 +547,15 @@ int uv_run(uv_loop_t *loop, uv_run_mode mode) {
       uv__poll(loop, timeout);
     else
       uv__poll_wine(loop, timeout);
-
+    /* Completions are only queued here, their callbacks run in the pending
+     * phase of the next iteration.
+     */
+    uv__metrics_phase(loop, UV_LOOP_PHASE_POLL_WAIT);
 
     uv_check_invoke(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_CHECK);
     uv_process_endgames(loop);
+    uv__metrics_phase(loop, UV_LOOP_PHASE_CLOSING);
 
     if (mode == UV_RUN_ONCE) {
       /* UV_RUN_ONCE implies forward progress: at least one callback must have
@@ -543,6 +567,7 @@ int uv_run(uv_loop_t *loop, uv_run_mode mode) {
        * the check.
        */
       uv__run_timers(loop);
+      uv__metrics_phase(loop, UV_LOOP_PHASE_TIMERS);
     }
 
     r = uv__loop_alive(loop);
@@ -58,7 +58,9 @@
     if (cb != NULL) {                                                         \
       uv__req_register(loop, req);                                            \
       uv__work_submit(loop,                                                   \
+                      (uv_req_t*) req,                                        \
                       &req->work_req,                                         \
+                      UV_THREADPOOL_FS,                                       \
                       UV__WORK_FAST_IO,                                       \
                       uv__fs_work,                                            \
                       uv__fs_done);                                           \
@@ -254,6 +256,7 @@ INLINE static void uv_fs_req_init(uv_loop_t* loop, uv_fs_t* req,
   req->ptr = NULL;
   req->path = NULL;
   req->cb = cb;
+  uv__work_timing_clear((uv_req_t*) req);
   memset(&req->fs, 0, sizeof(req->fs));
 }
 
@@ -2081,6 +2084,7 @@ static void uv__fs_work(struct uv__work* w) {
 
   req = container_of(w, uv_fs_t, work_req);
   assert(req->type == UV_FS);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_START);
 
 #define XX(uc, lc)  case UV_FS_##uc: fs__##lc(req); break;
   switch (req->fs_type) {
@@ -2117,6 +2121,8 @@ static void uv__fs_work(struct uv__work* w) {
     default:
       assert(!"bad uv_fs_type");
   }
+
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_END);
 }
 
 
@@ -2124,6 +2130,7 @@ static void uv__fs_done(struct uv__work* w, int status) {
   uv_fs_t* req;
 
   req = container_of(w, uv_fs_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_DONE);
   uv__req_unregister(req->loop, req);
 
   if (status == UV_ECANCELED) {
@@ -45,6 +45,7 @@ static void uv__getnameinfo_work(struct uv__work* w) {
   int ret;
 
   req = container_of(w, uv_getnameinfo_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_START);
   if (GetNameInfoW((struct sockaddr*)&req->storage,
                    sizeof(req->storage),
                    host,
@@ -54,7 +55,7 @@ static void uv__getnameinfo_work(struct uv__work* w) {
                    req->flags)) {
     ret = WSAGetLastError();
     req->retcode = uv__getaddrinfo_translate_error(ret);
-    return;
+    goto done;
   }
 
   ret = WideCharToMultiByte(CP_UTF8,
@@ -67,7 +68,7 @@ static void uv__getnameinfo_work(struct uv__work* w) {
                             NULL);
   if (ret == 0) {
     req->retcode = uv_translate_sys_error(GetLastError());
-    return;
+    goto done;
   }
 
   ret = WideCharToMultiByte(CP_UTF8,
@@ -81,6 +82,9 @@ static void uv__getnameinfo_work(struct uv__work* w) {
   if (ret == 0) {
     req->retcode = uv_translate_sys_error(GetLastError());
   }
+
+done:
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_END);
 }
 
 
@@ -93,6 +97,7 @@ static void uv__getnameinfo_done(struct uv__work* w, int status) {
   char* service;
 
   req = container_of(w, uv_getnameinfo_t, work_req);
+  uv__work_timing_mark((uv_req_t*) req, UV__WORK_DONE);
   uv__req_unregister(req->loop, req);
   host = service = NULL;
 
@@ -144,12 +149,15 @@ int uv_getnameinfo(uv_loop_t* loop,
 
   if (getnameinfo_cb) {
     uv__work_submit(loop,
+                    (uv_req_t*) req,
                     &req->work_req,
+                    UV_THREADPOOL_DNS,
                     UV__WORK_SLOW_IO,
                     uv__getnameinfo_work,
                     uv__getnameinfo_done);
     return 0;
   } else {
+    uv__work_timing_clear((uv_req_t*) req);
     uv__getnameinfo_work(&req->work_req);
     uv__getnameinfo_done(&req->work_req, 0);
     return req->retcode;
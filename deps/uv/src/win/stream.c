@@ -238,3 +238,8 @@ int uv_stream_set_blocking(uv_stream_t* handle, int blocking) {
 
   return 0;
 }
+
+
+int uv_stream_set_exclusive_accept(uv_stream_t* handle, int enable) {
+  return UV_ENOTSUP;
+}
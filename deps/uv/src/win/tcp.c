@@ -1306,6 +1306,31 @@ int uv_tcp_keepalive(uv_tcp_t* handle, int enable, unsigned int delay) {
 }
 
 
+int uv_tcp_zerocopy(uv_tcp_t* handle, int enable, unsigned int min_size) {
+  return UV_ENOTSUP;
+}
+
+
+int uv_tcp_fastopen(uv_tcp_t* handle, unsigned int qlen) {
+  return UV_ENOTSUP;
+}
+
+
+int uv_tcp_fastopen_connect(uv_tcp_t* handle, int enable) {
+  return UV_ENOTSUP;
+}
+
+
+int uv_tcp_defer_accept(uv_tcp_t* handle, unsigned int timeout) {
+  return UV_ENOTSUP;
+}
+
+
+int uv_tcp_accept_backlog(const uv_tcp_t* handle, unsigned int* count) {
+  return UV_ENOTSUP;
+}
+
+
 int uv_tcp_simultaneous_accepts(uv_tcp_t* handle, int enable) {
   if (handle->flags & UV_HANDLE_CONNECTION) {
     return UV_EINVAL;
@@ -1499,6 +1524,9 @@ int uv__tcp_bind(uv_tcp_t* handle,
                  unsigned int flags) {
   int err;
 
+  if (flags & UV_TCP_REUSEPORT)
+    return UV_ENOTSUP;
+
   err = uv_tcp_try_bind(handle, addr, addrlen, flags);
   if (err)
     return uv_translate_sys_error(err);
@@ -128,11 +128,13 @@ int uv_udp_init_ex(uv_loop_t* loop, uv_udp_t* handle, unsigned int flags) {
   if (domain != AF_INET && domain != AF_INET6 && domain != AF_UNSPEC)
     return UV_EINVAL;
 
-  if (flags & ~0xFF)
+  /* recvmmsg() is not available, UV_UDP_RECVMMSG is accepted and ignored. */
+  if (flags & ~0xFF & ~UV_UDP_RECVMMSG)
     return UV_EINVAL;
 
   uv__handle_init(loop, (uv_handle_t*) handle, UV_UDP);
   handle->socket = INVALID_SOCKET;
+  handle->gro_segment_size = 0;
   handle->reqs_pending = 0;
   handle->activecnt = 0;
   handle->func_wsarecv = WSARecv;
@@ -784,6 +786,16 @@ int uv_udp_set_broadcast(uv_udp_t* handle, int value) {
 }
 
 
+int uv_udp_set_gso(uv_udp_t* handle, unsigned int segment_size) {
+  return UV_ENOTSUP;
+}
+
+
+int uv_udp_set_gro(uv_udp_t* handle, int on) {
+  return UV_ENOTSUP;
+}
+
+
 int uv_udp_open(uv_udp_t* handle, uv_os_sock_t sock) {
   WSAPROTOCOL_INFOW protocol_info;
   int opt_len;
@@ -872,6 +884,9 @@ int uv__udp_bind(uv_udp_t* handle,
                  unsigned int flags) {
   int err;
 
+  if (flags & UV_UDP_REUSEPORT)
+    return UV_ENOTSUP;
+
   err = uv_udp_maybe_bind(handle, addr, addrlen, flags);
   if (err)
     return uv_translate_sys_error(err);
@@ -960,3 +975,21 @@ int uv__udp_try_send(uv_udp_t* handle,
 
   return bytes;
 }
+
+
+int uv__udp_try_send2(uv_udp_t* handle,
+                      unsigned int count,
+                      uv_buf_t* bufs[],
+                      unsigned int nbufs[],
+                      struct sockaddr* addrs[]) {
+  unsigned int i;
+  int r;
+
+  for (i = 0; i < count; i++) {
+    r = uv_udp_try_send(handle, bufs[i], nbufs[i], addrs[i]);
+    if (r < 0)
+      return i > 0 ? (int) i : r;
+  }
+
+  return (int) i;
+}
@@ -0,0 +1,358 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* The io_uring code paths are opt-in.  Exercise them through the regular
+ * uv_fs_*() API; on platforms or kernels without io_uring support the same
+ * requests go through the threadpool and the test passes all the same.
+ */
+
+static const char filename[] = "test_file_io_uring";
+static const char payload[] = "io_uring round trip";
+
+static uv_loop_t* loop;
+static uv_file file;
+static char readbuf[64];
+static uv_stat_t sync_statbuf;
+
+static uv_fs_t open_req;
+static uv_fs_t write_req;
+static uv_fs_t fsync_req;
+static uv_fs_t fdatasync_req;
+static uv_fs_t fstat_req;
+static uv_fs_t stat_req;
+static uv_fs_t lstat_req;
+static uv_fs_t read_req;
+static uv_fs_t missing_req;
+
+static int read_cb_called;
+static int missing_cb_called;
+
+
+static void check_statbuf(const uv_stat_t* s) {
+  ASSERT(s->st_ino == sync_statbuf.st_ino);
+  ASSERT(s->st_dev == sync_statbuf.st_dev);
+  ASSERT(s->st_mode == sync_statbuf.st_mode);
+  ASSERT(s->st_size == sizeof(payload));
+  ASSERT(s->st_mtim.tv_sec == sync_statbuf.st_mtim.tv_sec);
+  ASSERT(s->st_mtim.tv_nsec == sync_statbuf.st_mtim.tv_nsec);
+}
+
+
+static void read_cb(uv_fs_t* req) {
+  ASSERT(req == &read_req);
+  ASSERT(req->result == sizeof(payload));
+  ASSERT(memcmp(readbuf, payload, sizeof(payload)) == 0);
+  uv_fs_req_cleanup(req);
+  read_cb_called++;
+}
+
+
+static void lstat_cb(uv_fs_t* req) {
+  uv_buf_t buf;
+
+  ASSERT(req == &lstat_req);
+  ASSERT(req->result == 0);
+  ASSERT(req->ptr == &req->statbuf);
+  check_statbuf(&req->statbuf);
+  uv_fs_req_cleanup(req);
+
+  buf = uv_buf_init(readbuf, sizeof(readbuf));
+  ASSERT(0 == uv_fs_read(loop, &read_req, file, &buf, 1, 0, read_cb));
+}
+
+
+static void stat_cb(uv_fs_t* req) {
+  ASSERT(req == &stat_req);
+  ASSERT(req->result == 0);
+  check_statbuf(&req->statbuf);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_lstat(loop, &lstat_req, filename, lstat_cb));
+}
+
+
+static void fstat_cb(uv_fs_t* req) {
+  ASSERT(req == &fstat_req);
+  ASSERT(req->result == 0);
+  check_statbuf(&req->statbuf);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_stat(loop, &stat_req, filename, stat_cb));
+}
+
+
+static void fdatasync_cb(uv_fs_t* req) {
+  uv_fs_t sync_req;
+
+  ASSERT(req == &fdatasync_req);
+  ASSERT(req->result == 0);
+  uv_fs_req_cleanup(req);
+
+  ASSERT(0 == uv_fs_fstat(NULL, &sync_req, file, NULL));
+  sync_statbuf = sync_req.statbuf;
+  uv_fs_req_cleanup(&sync_req);
+
+  ASSERT(0 == uv_fs_fstat(loop, &fstat_req, file, fstat_cb));
+}
+
+
+static void fsync_cb(uv_fs_t* req) {
+  ASSERT(req == &fsync_req);
+  ASSERT(req->result == 0);
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_fdatasync(loop, &fdatasync_req, file, fdatasync_cb));
+}
+
+
+static void write_cb(uv_fs_t* req) {
+  ASSERT(req == &write_req);
+  ASSERT(req->result == sizeof(payload));
+  uv_fs_req_cleanup(req);
+  ASSERT(0 == uv_fs_fsync(loop, &fsync_req, file, fsync_cb));
+}
+
+
+static void open_cb(uv_fs_t* req) {
+  uv_buf_t buf;
+
+  ASSERT(req == &open_req);
+  ASSERT(req->result >= 0);
+  file = req->result;
+  uv_fs_req_cleanup(req);
+
+  buf = uv_buf_init((char*) payload, sizeof(payload));
+  ASSERT(0 == uv_fs_write(loop, &write_req, file, &buf, 1, -1, write_cb));
+}
+
+
+static void missing_cb(uv_fs_t* req) {
+  ASSERT(req == &missing_req);
+  ASSERT(req->result == UV_ENOENT);
+  ASSERT(req->ptr == NULL);
+  uv_fs_req_cleanup(req);
+  missing_cb_called++;
+}
+
+
+TEST_IMPL(fs_io_uring) {
+  uv_fs_t req;
+
+  ASSERT(0 == uv_os_setenv("UV_USE_IO_URING", "1"));
+
+  loop = uv_default_loop();
+  unlink(filename);
+
+  ASSERT(0 == uv_fs_open(loop,
+                         &open_req,
+                         filename,
+                         O_RDWR | O_CREAT | O_TRUNC,
+                         S_IWUSR | S_IRUSR,
+                         open_cb));
+  ASSERT(0 == uv_fs_stat(loop, &missing_req, "no_such_file", missing_cb));
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(1 == read_cb_called);
+  ASSERT(1 == missing_cb_called);
+
+  ASSERT(0 == uv_fs_close(NULL, &req, file, NULL));
+  uv_fs_req_cleanup(&req);
+  unlink(filename);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static uv_pipe_t short_write_pipe;
+static char short_write_buf[1024 * 1024];
+static size_t short_write_nread;
+static int short_write_cb_called;
+
+
+static void short_write_alloc_cb(uv_handle_t* handle,
+                                 size_t suggested_size,
+                                 uv_buf_t* buf) {
+  static char slab[65536];
+  *buf = uv_buf_init(slab, sizeof(slab));
+}
+
+
+static void short_write_read_cb(uv_stream_t* stream,
+                                ssize_t nread,
+                                const uv_buf_t* buf) {
+  if (nread == UV_EOF) {
+    uv_close((uv_handle_t*) stream, NULL);
+    return;
+  }
+
+  ASSERT(nread >= 0);
+  ASSERT(0 == memcmp(buf->base, short_write_buf + short_write_nread, nread));
+  short_write_nread += nread;
+}
+
+
+static void short_write_cb(uv_fs_t* req) {
+  uv_fs_t close_req;
+
+  ASSERT(req == &write_req);
+  ASSERT(req->result == sizeof(short_write_buf));
+  ASSERT(0 == uv_fs_close(NULL, &close_req, file, NULL));
+  uv_fs_req_cleanup(&close_req);
+  uv_fs_req_cleanup(req);
+  short_write_cb_called++;
+}
+
+
+/* A pipe takes much less than the buffer at once, so the write completes
+ * with a short count and the rest has to be written when the reader has made
+ * room.
+ */
+TEST_IMPL(fs_io_uring_short_write) {
+  uv_buf_t buf;
+  size_t i;
+  int fds[2];
+
+  ASSERT(0 == uv_os_setenv("UV_USE_IO_URING", "1"));
+
+  for (i = 0; i < sizeof(short_write_buf); i++)
+    short_write_buf[i] = (char) (i * 7);
+
+  loop = uv_default_loop();
+  ASSERT(0 == pipe(fds));
+  ASSERT(0 == fcntl(fds[1], F_SETFL, O_NONBLOCK));
+  file = fds[1];
+
+  ASSERT(0 == uv_pipe_init(loop, &short_write_pipe, 0));
+  ASSERT(0 == uv_pipe_open(&short_write_pipe, fds[0]));
+  ASSERT(0 == uv_read_start((uv_stream_t*) &short_write_pipe,
+                            short_write_alloc_cb,
+                            short_write_read_cb));
+
+  buf = uv_buf_init(short_write_buf, sizeof(short_write_buf));
+  ASSERT(0 == uv_fs_write(loop, &write_req, file, &buf, 1, -1, short_write_cb));
+
+  /* Without io_uring, the threadpool gives up on the full pipe with EAGAIN.
+   * The request is not on any threadpool queue when it is in the ring.
+   */
+  if (write_req.work_req.work != NULL) {
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    MAKE_VALGRIND_HAPPY();
+    RETURN_SKIP("io_uring is not available");
+  }
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(1 == short_write_cb_called);
+  ASSERT(short_write_nread == sizeof(short_write_buf));
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static int fork_read_cb_called;
+
+
+static void fork_read_cb(uv_fs_t* req) {
+  ASSERT(req == &read_req);
+  ASSERT(req->result == 1);
+  uv_fs_req_cleanup(req);
+  fork_read_cb_called++;
+}
+
+
+/* A forked child never sees the completions of the requests that the parent
+ * has in the ring, so its loop must not wait for them.
+ */
+TEST_IMPL(fs_io_uring_fork) {
+  uv_buf_t buf;
+  pid_t child_pid;
+  int child_stat;
+  int fds[2];
+
+  ASSERT(0 == uv_os_setenv("UV_USE_IO_URING", "1"));
+
+  loop = uv_default_loop();
+  ASSERT(0 == pipe(fds));
+
+  buf = uv_buf_init(readbuf, sizeof(readbuf));
+  ASSERT(0 == uv_fs_read(loop, &read_req, fds[0], &buf, 1, -1, fork_read_cb));
+
+  if (read_req.work_req.work != NULL) {
+    ASSERT(1 == write(fds[1], "x", 1));
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    MAKE_VALGRIND_HAPPY();
+    RETURN_SKIP("io_uring is not available");
+  }
+
+  /* Submit the read before forking. */
+  ASSERT(0 != uv_run(loop, UV_RUN_NOWAIT));
+  ASSERT(0 == fork_read_cb_called);
+
+  child_pid = fork();
+  ASSERT(child_pid != -1);
+
+  if (child_pid == 0) {
+    ASSERT(0 == uv_loop_fork(loop));
+    ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+    ASSERT(0 == fork_read_cb_called);
+    MAKE_VALGRIND_HAPPY();
+    return 0;
+  }
+
+  ASSERT(child_pid == waitpid(child_pid, &child_stat, 0));
+  ASSERT(WIFEXITED(child_stat));
+  ASSERT(0 == WEXITSTATUS(child_stat));
+
+  ASSERT(1 == write(fds[1], "x", 1));
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(1 == fork_read_cb_called);
+
+  ASSERT(0 == close(fds[0]));
+  ASSERT(0 == close(fds[1]));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+#else
+
+TEST_IMPL(fs_io_uring) {
+  RETURN_SKIP("Test does not currently work in Windows");
+}
+
+
+TEST_IMPL(fs_io_uring_short_write) {
+  RETURN_SKIP("Test does not currently work in Windows");
+}
+
+TEST_IMPL(fs_io_uring_fork) {
+  RETURN_SKIP("Test does not currently work in Windows");
+}
+
+#endif  /* !_WIN32 */
@@ -0,0 +1,115 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#define UV_NS_TO_MS 1000000
+
+static int check_cb_called;
+
+
+static void timer_spin_cb(uv_timer_t* handle) {
+  uint64_t t;
+
+  (*(int*) handle->data)++;
+  t = uv_hrtime();
+  /* Spin for 600 ms so the time is charged to the timers phase. */
+  while (uv_hrtime() - t < 600 * UV_NS_TO_MS);
+}
+
+
+static void check_spin_cb(uv_check_t* handle) {
+  uint64_t t;
+
+  check_cb_called++;
+  t = uv_hrtime();
+  while (uv_hrtime() - t < 50 * UV_NS_TO_MS);
+  uv_close((uv_handle_t*) handle, NULL);
+}
+
+
+TEST_IMPL(metrics_idle_time) {
+  const uint64_t timeout = 1000;
+  uv_timer_t timer;
+  uint64_t idle_time;
+  int cntr;
+
+  cntr = 0;
+  timer.data = &cntr;
+
+  ASSERT(0 == uv_metrics_idle_time(uv_default_loop()));
+  ASSERT(0 == uv_loop_configure(uv_default_loop(), UV_METRICS_IDLE_TIME));
+  ASSERT(0 == uv_timer_init(uv_default_loop(), &timer));
+  ASSERT(0 == uv_timer_start(&timer, timer_spin_cb, timeout, 0));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(cntr > 0);
+
+  idle_time = uv_metrics_idle_time(uv_default_loop());
+
+  /* Permissive check that the idle time matches within the timeout ±500 ms. */
+  ASSERT((idle_time <= (timeout + 500) * UV_NS_TO_MS) &&
+         (idle_time >= (timeout - 500) * UV_NS_TO_MS));
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(metrics_phases) {
+  uv_loop_metrics_t metrics;
+  uv_check_t check;
+  uv_timer_t timer;
+  uv_loop_t loop;
+  int cntr;
+
+  cntr = 0;
+  timer.data = &cntr;
+
+  ASSERT(0 == uv_loop_init(&loop));
+  ASSERT(0 == uv_loop_configure(&loop, UV_METRICS_IDLE_TIME));
+  ASSERT(0 == uv_timer_init(&loop, &timer));
+  ASSERT(0 == uv_timer_start(&timer, timer_spin_cb, 100, 0));
+  ASSERT(0 == uv_check_init(&loop, &check));
+  ASSERT(0 == uv_check_start(&check, check_spin_cb));
+
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  ASSERT(1 == cntr);
+  ASSERT(1 == check_cb_called);
+
+  ASSERT(UV_EINVAL == uv_loop_metrics(&loop, NULL));
+  ASSERT(0 == uv_loop_metrics(&loop, &metrics));
+  ASSERT(metrics.iterations >= 2);
+  ASSERT(metrics.phase_time[UV_LOOP_PHASE_TIMERS] >= 600 * UV_NS_TO_MS);
+  ASSERT(metrics.phase_time[UV_LOOP_PHASE_CHECK] >= 50 * UV_NS_TO_MS);
+  ASSERT(metrics.phase_time[UV_LOOP_PHASE_CHECK] < 600 * UV_NS_TO_MS);
+  /* The timer fires after ~100 ms of waiting, minus the first check spin. */
+  ASSERT(metrics.phase_time[UV_LOOP_PHASE_POLL_WAIT] < 600 * UV_NS_TO_MS);
+  ASSERT(metrics.phase_time[UV_LOOP_PHASE_POLL_WAIT] ==
+         uv_metrics_idle_time(&loop));
+
+  uv_close((uv_handle_t*) &timer, NULL);
+  ASSERT(0 == uv_run(&loop, UV_RUN_DEFAULT));
+  ASSERT(0 == uv_loop_close(&loop));
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
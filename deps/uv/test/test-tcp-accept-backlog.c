@@ -0,0 +1,120 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include "uv.h"
+#include "task.h"
+
+#define NUM_CLIENTS 3
+
+static uv_tcp_t server;
+static uv_tcp_t clients[NUM_CLIENTS];
+static uv_tcp_t incoming[NUM_CLIENTS];
+static uv_connect_t connect_reqs[NUM_CLIENTS];
+
+static int connection_cb_called;
+static int connect_cb_called;
+static int accepted;
+static int close_cb_called;
+
+
+static void close_cb(uv_handle_t* handle) {
+  close_cb_called++;
+}
+
+
+static void accept_one(void) {
+  ASSERT(0 == uv_tcp_init(server.loop, &incoming[accepted]));
+  ASSERT(0 == uv_accept((uv_stream_t*) &server,
+                        (uv_stream_t*) &incoming[accepted]));
+  uv_close((uv_handle_t*) &incoming[accepted], close_cb);
+  accepted++;
+
+  if (accepted == NUM_CLIENTS) {
+    int i;
+    uv_close((uv_handle_t*) &server, close_cb);
+    for (i = 0; i < NUM_CLIENTS; i++)
+      uv_close((uv_handle_t*) &clients[i], close_cb);
+  }
+}
+
+
+static void connection_cb(uv_stream_t* stream, int status) {
+  ASSERT(status == 0);
+  connection_cb_called++;
+
+  /* Hold back the first connection until every client is connected. libuv
+   * stops accepting in the meantime.
+   */
+  if (connection_cb_called > 1)
+    accept_one();
+}
+
+
+static void connect_cb(uv_connect_t* req, int status) {
+  unsigned int count;
+  int r;
+
+  ASSERT(status == 0);
+  if (++connect_cb_called < NUM_CLIENTS)
+    return;
+
+  ASSERT(connection_cb_called == 1);
+  r = uv_tcp_accept_backlog(&server, &count);
+  if (r != UV_ENOTSUP) {
+    ASSERT(r == 0);
+    ASSERT(count == NUM_CLIENTS);
+  }
+
+  accept_one();
+}
+
+
+TEST_IMPL(tcp_accept_backlog) {
+  struct sockaddr_in addr;
+  unsigned int count;
+  int i;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server));
+  ASSERT(0 == uv_tcp_bind(&server, (const struct sockaddr*) &addr, 0));
+  ASSERT(UV_EINVAL == uv_tcp_accept_backlog(&server, &count) ||
+         UV_ENOTSUP == uv_tcp_accept_backlog(&server, &count));
+  ASSERT(0 == uv_listen((uv_stream_t*) &server, 16, connection_cb));
+
+  for (i = 0; i < NUM_CLIENTS; i++) {
+    ASSERT(0 == uv_tcp_init(uv_default_loop(), &clients[i]));
+    ASSERT(0 == uv_tcp_connect(&connect_reqs[i],
+                               &clients[i],
+                               (const struct sockaddr*) &addr,
+                               connect_cb));
+  }
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(connect_cb_called == NUM_CLIENTS);
+  ASSERT(connection_cb_called == NUM_CLIENTS);
+  ASSERT(accepted == NUM_CLIENTS);
+  ASSERT(close_cb_called == 2 * NUM_CLIENTS + 1);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -256,3 +256,48 @@ TEST_IMPL(tcp_bind_writable_flags) {
   MAKE_VALGRIND_HAPPY();
   return 0;
 }
+
+
+TEST_IMPL(tcp_bind_reuseport) {
+  struct sockaddr_in addr;
+  uv_tcp_t h1, h2, h3;
+  int r;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &h1));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &h2));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &h3));
+
+  r = uv_tcp_bind(&h1, (const struct sockaddr*) &addr, UV_TCP_REUSEPORT);
+  if (r == UV_ENOTSUP) {
+    uv_close((uv_handle_t*) &h1, NULL);
+    uv_close((uv_handle_t*) &h2, NULL);
+    uv_close((uv_handle_t*) &h3, NULL);
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+    RETURN_SKIP("SO_REUSEPORT load balancing is not supported");
+  }
+  ASSERT(r == 0);
+  ASSERT(0 == uv_listen((uv_stream_t*) &h1, 128, NULL));
+
+  /* Handles that set the flag share the port. */
+  r = uv_tcp_bind(&h2, (const struct sockaddr*) &addr, UV_TCP_REUSEPORT);
+  ASSERT(r == 0);
+  ASSERT(0 == uv_listen((uv_stream_t*) &h2, 128, NULL));
+
+  /* Others do not. */
+  r = uv_tcp_bind(&h3, (const struct sockaddr*) &addr, 0);
+  if (r == 0)
+    r = uv_listen((uv_stream_t*) &h3, 128, NULL);
+  ASSERT(r == UV_EADDRINUSE);
+
+  uv_close((uv_handle_t*) &h1, close_cb);
+  uv_close((uv_handle_t*) &h2, close_cb);
+  uv_close((uv_handle_t*) &h3, close_cb);
+
+  uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+
+  ASSERT(close_cb_called == 3);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -0,0 +1,130 @@
+/* Copyright Joyent, Inc. and other Node contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+static uv_tcp_t server;
+static uv_tcp_t clients[2];
+static uv_tcp_t accepted[2];
+static uv_connect_t connect_reqs[2];
+static uv_idle_t idle;
+static int connection_cb_called;
+static int connect_cb_called;
+static int accepted_count;
+
+
+static void close_cb(uv_handle_t* handle) {
+}
+
+
+static void accept_one(void) {
+  ASSERT(0 == uv_tcp_init(server.loop, &accepted[accepted_count]));
+  ASSERT(0 == uv_accept((uv_stream_t*) &server,
+                        (uv_stream_t*) &accepted[accepted_count]));
+  accepted_count++;
+
+  if (accepted_count == ARRAY_SIZE(accepted)) {
+    uv_close((uv_handle_t*) &server, close_cb);
+    uv_close((uv_handle_t*) &accepted[0], close_cb);
+    uv_close((uv_handle_t*) &accepted[1], close_cb);
+    uv_close((uv_handle_t*) &clients[0], close_cb);
+    uv_close((uv_handle_t*) &clients[1], close_cb);
+  }
+}
+
+
+static void idle_cb(uv_idle_t* handle) {
+  uv_idle_stop(handle);
+  uv_close((uv_handle_t*) handle, close_cb);
+  /* Restarts the exclusive watcher that was stopped while the connection
+   * was pending.
+   */
+  accept_one();
+}
+
+
+static void connection_cb(uv_stream_t* handle, int status) {
+  ASSERT(handle == (uv_stream_t*) &server);
+  ASSERT(status == 0);
+  connection_cb_called++;
+
+  /* Leave the first connection pending for a while.  That stops watching
+   * the listen socket, which disarms the exclusive registration.
+   */
+  if (connection_cb_called == 1) {
+    ASSERT(0 == uv_idle_start(&idle, idle_cb));
+    return;
+  }
+
+  accept_one();
+}
+
+
+static void connect_cb(uv_connect_t* req, int status) {
+  ASSERT(status == 0);
+  connect_cb_called++;
+}
+
+
+TEST_IMPL(tcp_exclusive_accept) {
+  struct sockaddr_in addr;
+  uv_loop_t* loop;
+  unsigned int i;
+  int r;
+
+  loop = uv_default_loop();
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(loop, &server));
+  ASSERT(0 == uv_idle_init(loop, &idle));
+  ASSERT(0 == uv_tcp_bind(&server, (const struct sockaddr*) &addr, 0));
+
+  r = uv_stream_set_exclusive_accept((uv_stream_t*) &server, 1);
+#ifndef __linux__
+  ASSERT(r == UV_ENOTSUP);
+  uv_close((uv_handle_t*) &server, NULL);
+  uv_close((uv_handle_t*) &idle, NULL);
+  uv_run(loop, UV_RUN_DEFAULT);
+  MAKE_VALGRIND_HAPPY();
+  RETURN_SKIP("Exclusive accept is only supported on Linux.");
+#endif
+  ASSERT(r == 0);
+
+  ASSERT(0 == uv_listen((uv_stream_t*) &server, 128, connection_cb));
+  r = uv_stream_set_exclusive_accept((uv_stream_t*) &server, 0);
+  ASSERT(r == UV_EBUSY);
+
+  for (i = 0; i < ARRAY_SIZE(clients); i++) {
+    ASSERT(0 == uv_tcp_init(loop, &clients[i]));
+    ASSERT(0 == uv_tcp_connect(&connect_reqs[i],
+                               &clients[i],
+                               (const struct sockaddr*) &addr,
+                               connect_cb));
+  }
+
+  ASSERT(0 == uv_run(loop, UV_RUN_DEFAULT));
+  ASSERT(connect_cb_called == 2);
+  ASSERT(connection_cb_called == 2);
+  ASSERT(accepted_count == 2);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
@@ -0,0 +1,147 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include "uv.h"
+#include "task.h"
+
+#include <string.h>
+
+static uv_tcp_t server;
+static uv_tcp_t incoming;
+static uv_tcp_t client;
+static uv_connect_t connect_req;
+static uv_write_t write_req;
+static char buffer[64];
+
+static int connection_cb_called;
+static int connect_cb_called;
+static int write_cb_called;
+static int read_cb_called;
+static int close_cb_called;
+
+
+static void close_cb(uv_handle_t* handle) {
+  close_cb_called++;
+}
+
+
+static void alloc_cb(uv_handle_t* handle,
+                     size_t suggested_size,
+                     uv_buf_t* buf) {
+  buf->base = buffer;
+  buf->len = sizeof(buffer);
+}
+
+
+static void incoming_read_cb(uv_stream_t* stream,
+                             ssize_t nread,
+                             const uv_buf_t* buf) {
+  /* Deferred accept: the connection is accepted together with its data. */
+  ASSERT(nread == 4);
+  ASSERT(0 == memcmp(buf->base, "PING", 4));
+  read_cb_called++;
+  uv_close((uv_handle_t*) stream, close_cb);
+  uv_close((uv_handle_t*) &server, close_cb);
+}
+
+
+static void client_read_cb(uv_stream_t* stream,
+                           ssize_t nread,
+                           const uv_buf_t* buf) {
+  if (nread == 0)
+    return;
+  ASSERT(nread == UV_EOF);
+  read_cb_called++;
+  uv_close((uv_handle_t*) stream, close_cb);
+}
+
+
+static void connection_cb(uv_stream_t* stream, int status) {
+  ASSERT(status == 0);
+  connection_cb_called++;
+  ASSERT(0 == uv_tcp_init(stream->loop, &incoming));
+  ASSERT(0 == uv_accept(stream, (uv_stream_t*) &incoming));
+  ASSERT(0 == uv_read_start((uv_stream_t*) &incoming,
+                            alloc_cb,
+                            incoming_read_cb));
+}
+
+
+static void write_cb(uv_write_t* req, int status) {
+  ASSERT(status == 0);
+  write_cb_called++;
+  ASSERT(0 == uv_read_start(req->handle, alloc_cb, client_read_cb));
+}
+
+
+static void connect_cb(uv_connect_t* req, int status) {
+  uv_buf_t buf;
+
+  ASSERT(status == 0);
+  connect_cb_called++;
+
+  /* Without a cookie for the server the kernel falls back to a regular
+   * handshake and the write waits for it.
+   */
+  buf = uv_buf_init("PING", 4);
+  ASSERT(0 == uv_write(&write_req, req->handle, &buf, 1, write_cb));
+}
+
+
+TEST_IMPL(tcp_fastopen) {
+  struct sockaddr_in addr;
+  int r;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &client));
+  ASSERT(UV_EBADF == uv_tcp_fastopen(&server, 16) ||
+         UV_ENOTSUP == uv_tcp_fastopen(&server, 16));
+  ASSERT(0 == uv_tcp_bind(&server, (const struct sockaddr*) &addr, 0));
+
+  r = uv_tcp_fastopen(&server, 16);
+  if (r == UV_ENOTSUP || r == UV_ENOPROTOOPT)
+    RETURN_SKIP("TCP Fast Open is not supported");
+  ASSERT(r == 0);
+
+  r = uv_tcp_defer_accept(&server, 1);
+  ASSERT(r == 0 || r == UV_ENOTSUP);
+  ASSERT(0 == uv_listen((uv_stream_t*) &server, 1, connection_cb));
+
+  r = uv_tcp_fastopen_connect(&client, 1);
+  ASSERT(r == 0 || r == UV_ENOTSUP);
+  ASSERT(0 == uv_tcp_connect(&connect_req,
+                             &client,
+                             (const struct sockaddr*) &addr,
+                             connect_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(connection_cb_called == 1);
+  ASSERT(connect_cb_called == 1);
+  ASSERT(write_cb_called == 1);
+  ASSERT(read_cb_called == 2);
+  ASSERT(close_cb_called == 3);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
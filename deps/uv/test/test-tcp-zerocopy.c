@@ -0,0 +1,331 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+# include <sys/socket.h>
+#endif
+
+#define LARGE_SIZE (1024 * 1024)
+#define SMALL_SIZE 100
+#define TOTAL_SIZE (2 * LARGE_SIZE + SMALL_SIZE)
+/* More than the socket buffers of both ends take together. */
+#define LINGER_SIZE (64 * 1024 * 1024)
+
+static uv_tcp_t server;
+static uv_tcp_t incoming;
+static uv_tcp_t client;
+static uv_connect_t connect_req;
+static uv_write_t write_reqs[3];
+
+static char* data;
+static char* expected;
+static char* received;
+static size_t bytes_received;
+static int write_cb_called;
+static int close_cb_called;
+static uint64_t close_time;
+
+
+static void alloc_cb(uv_handle_t* handle,
+                     size_t suggested_size,
+                     uv_buf_t* buf) {
+  buf->base = received + bytes_received;
+  /* One spare byte, so that there is room for the EOF. */
+  buf->len = TOTAL_SIZE + 1 - bytes_received;
+}
+
+
+static void read_cb(uv_stream_t* stream,
+                    ssize_t nread,
+                    const uv_buf_t* buf) {
+  if (nread == UV_EOF) {
+    if (expected != NULL) {
+      /* Whatever was sent before closing is intact. */
+      ASSERT(0 == memcmp(expected, received, bytes_received));
+    } else if (write_cb_called != -1) {
+      ASSERT(bytes_received == TOTAL_SIZE);
+      ASSERT(0 == memcmp(data, received, TOTAL_SIZE));
+    }
+    uv_close((uv_handle_t*) stream, NULL);
+    return;
+  }
+
+  ASSERT(nread >= 0);
+  bytes_received += nread;
+}
+
+
+static void connection_cb(uv_stream_t* stream, int status) {
+  ASSERT(status == 0);
+  ASSERT(0 == uv_tcp_init(stream->loop, &incoming));
+  ASSERT(0 == uv_accept(stream, (uv_stream_t*) &incoming));
+  ASSERT(0 == uv_read_start((uv_stream_t*) &incoming, alloc_cb, read_cb));
+  uv_close((uv_handle_t*) stream, NULL);
+}
+
+
+static void write_cb(uv_write_t* req, int status) {
+  ASSERT(status == 0);
+  /* The small write does not overtake the large one before it. */
+  ASSERT(req == &write_reqs[write_cb_called]);
+  write_cb_called++;
+
+  if (write_cb_called == 3)
+    uv_close((uv_handle_t*) req->handle, NULL);
+}
+
+
+static void connect_cb(uv_connect_t* req, int status) {
+  uv_buf_t bufs[3];
+  int r;
+
+  ASSERT(status == 0);
+
+  r = uv_tcp_zerocopy(&client, 1, 16 * 1024);
+  if (r == UV_ENOTSUP || r == UV_ENOPROTOOPT) {
+    uv_close((uv_handle_t*) &client, NULL);
+    write_cb_called = -1;
+    return;
+  }
+  ASSERT(r == 0);
+
+  bufs[0] = uv_buf_init(data, LARGE_SIZE);
+  bufs[1] = uv_buf_init(data + LARGE_SIZE, SMALL_SIZE);
+  bufs[2] = uv_buf_init(data + LARGE_SIZE + SMALL_SIZE, LARGE_SIZE);
+
+  ASSERT(UV_EAGAIN == uv_try_write(req->handle, &bufs[0], 1));
+
+  ASSERT(0 == uv_write(&write_reqs[0], req->handle, &bufs[0], 1, write_cb));
+  ASSERT(0 == uv_write(&write_reqs[1], req->handle, &bufs[1], 1, write_cb));
+  ASSERT(0 == uv_write(&write_reqs[2], req->handle, &bufs[2], 1, write_cb));
+}
+
+
+TEST_IMPL(tcp_zerocopy) {
+  struct sockaddr_in addr;
+  size_t i;
+
+  data = malloc(TOTAL_SIZE);
+  received = malloc(TOTAL_SIZE + 1);
+  ASSERT(data != NULL);
+  ASSERT(received != NULL);
+  for (i = 0; i < TOTAL_SIZE; i++)
+    data[i] = i % 251;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server));
+  ASSERT(0 == uv_tcp_bind(&server, (const struct sockaddr*) &addr, 0));
+  ASSERT(0 == uv_listen((uv_stream_t*) &server, 1, connection_cb));
+
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &client));
+  ASSERT(UV_EBADF == uv_tcp_zerocopy(&client, 1, 0) ||
+         UV_ENOTSUP == uv_tcp_zerocopy(&client, 1, 0));
+  ASSERT(0 == uv_tcp_connect(&connect_req,
+                             &client,
+                             (const struct sockaddr*) &addr,
+                             connect_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  free(data);
+  free(received);
+
+  if (write_cb_called == -1)
+    RETURN_SKIP("Zero-copy sends are not supported");
+
+  ASSERT(write_cb_called == 3);
+  ASSERT(bytes_received == TOTAL_SIZE);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static void close_write_cb(uv_write_t* req, int status) {
+  ASSERT(status == 0 || status == UV_ECANCELED);
+  ASSERT(close_cb_called == 0);
+  write_cb_called++;
+}
+
+
+static void close_cb(uv_handle_t* handle) {
+  ASSERT(write_cb_called == 1);
+  close_cb_called++;
+  /* The kernel is done with the buffer, it may be reused. */
+  memset(data, 0, TOTAL_SIZE);
+}
+
+
+static void close_connect_cb(uv_connect_t* req, int status) {
+  uv_buf_t buf;
+  int r;
+
+  ASSERT(status == 0);
+
+  r = uv_tcp_zerocopy(&client, 1, 16 * 1024);
+  if (r == UV_ENOTSUP || r == UV_ENOPROTOOPT) {
+    uv_close((uv_handle_t*) &client, NULL);
+    write_cb_called = -1;
+    return;
+  }
+  ASSERT(r == 0);
+
+  buf = uv_buf_init(data, TOTAL_SIZE);
+  ASSERT(0 == uv_write(&write_reqs[0], req->handle, &buf, 1, close_write_cb));
+  uv_close((uv_handle_t*) req->handle, close_cb);
+}
+
+
+TEST_IMPL(tcp_zerocopy_close) {
+  struct sockaddr_in addr;
+  size_t i;
+
+  data = malloc(TOTAL_SIZE);
+  expected = malloc(TOTAL_SIZE);
+  received = malloc(TOTAL_SIZE + 1);
+  ASSERT(data != NULL);
+  ASSERT(expected != NULL);
+  ASSERT(received != NULL);
+  for (i = 0; i < TOTAL_SIZE; i++)
+    data[i] = i % 251;
+  memcpy(expected, data, TOTAL_SIZE);
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server));
+  ASSERT(0 == uv_tcp_bind(&server, (const struct sockaddr*) &addr, 0));
+  ASSERT(0 == uv_listen((uv_stream_t*) &server, 1, connection_cb));
+
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &client));
+  ASSERT(0 == uv_tcp_connect(&connect_req,
+                             &client,
+                             (const struct sockaddr*) &addr,
+                             close_connect_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  free(data);
+  free(expected);
+  free(received);
+
+  if (write_cb_called == -1)
+    RETURN_SKIP("Zero-copy sends are not supported");
+
+  ASSERT(write_cb_called == 1);
+  ASSERT(close_cb_called == 1);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static void linger_connection_cb(uv_stream_t* stream, int status) {
+  ASSERT(status == 0);
+  ASSERT(0 == uv_tcp_init(stream->loop, &incoming));
+  /* Never reads, the client's sends cannot complete. */
+  ASSERT(0 == uv_accept(stream, (uv_stream_t*) &incoming));
+  uv_close((uv_handle_t*) stream, NULL);
+}
+
+
+static void linger_write_cb(uv_write_t* req, int status) {
+  ASSERT(status == UV_ECANCELED);
+  write_cb_called++;
+}
+
+
+static void linger_close_cb(uv_handle_t* handle) {
+  ASSERT(write_cb_called == 1);
+  /* SO_LINGER bounds the wait. */
+  ASSERT(uv_now(handle->loop) - close_time >= 1000);
+  close_cb_called++;
+  memset(data, 0, LINGER_SIZE);
+  uv_close((uv_handle_t*) &incoming, NULL);
+}
+
+
+static void linger_connect_cb(uv_connect_t* req, int status) {
+  uv_os_fd_t fd;
+  uv_buf_t buf;
+  int r;
+
+  ASSERT(status == 0);
+
+  r = uv_tcp_zerocopy(&client, 1, 16 * 1024);
+  if (r == UV_ENOTSUP || r == UV_ENOPROTOOPT) {
+    uv_close((uv_handle_t*) &client, NULL);
+    uv_close((uv_handle_t*) &incoming, NULL);
+    write_cb_called = -1;
+    return;
+  }
+  ASSERT(r == 0);
+
+#ifndef _WIN32
+  {
+    struct linger l;
+    l.l_onoff = 1;
+    l.l_linger = 1;
+    ASSERT(0 == uv_fileno((uv_handle_t*) &client, &fd));
+    ASSERT(0 == setsockopt(fd, SOL_SOCKET, SO_LINGER, &l, sizeof(l)));
+  }
+#endif
+
+  buf = uv_buf_init(data, LINGER_SIZE);
+  ASSERT(0 == uv_write(&write_reqs[0], req->handle, &buf, 1, linger_write_cb));
+  close_time = uv_now(req->handle->loop);
+  uv_close((uv_handle_t*) req->handle, linger_close_cb);
+}
+
+
+TEST_IMPL(tcp_zerocopy_close_linger) {
+  struct sockaddr_in addr;
+
+  data = calloc(1, LINGER_SIZE);
+  ASSERT(data != NULL);
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &server));
+  ASSERT(0 == uv_tcp_bind(&server, (const struct sockaddr*) &addr, 0));
+  ASSERT(0 == uv_listen((uv_stream_t*) &server, 1, linger_connection_cb));
+
+  ASSERT(0 == uv_tcp_init(uv_default_loop(), &client));
+  ASSERT(0 == uv_tcp_connect(&connect_req,
+                             &client,
+                             (const struct sockaddr*) &addr,
+                             linger_connect_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  free(data);
+
+  if (write_cb_called == -1)
+    RETURN_SKIP("Zero-copy sends are not supported");
+
+  ASSERT(write_cb_called == 1);
+  ASSERT(close_cb_called == 1);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
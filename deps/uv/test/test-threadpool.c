@@ -22,6 +22,8 @@
 #include "uv.h"
 #include "task.h"
 
+#include <string.h>  /* memset */
+
 static int work_cb_count;
 static int after_work_cb_count;
 static uv_work_t work_req;
@@ -59,6 +61,69 @@ TEST_IMPL(threadpool_queue_work_simple) {
 }
 
 
+static void timing_work_cb(uv_work_t* req) {
+  uv_sleep(10);
+}
+
+
+static void timing_after_work_cb(uv_work_t* req, int status) {
+  uv_work_timing_t timing;
+
+  ASSERT(status == 0);
+  ASSERT(UV_EINVAL == uv_req_get_work_timing((uv_req_t*) req, NULL));
+  ASSERT(0 == uv_req_get_work_timing((uv_req_t*) req, &timing));
+  ASSERT(timing.submit_time != 0);
+  ASSERT(timing.start_time >= timing.submit_time);
+  ASSERT(timing.end_time >= timing.start_time + 10 * 1000000);
+  ASSERT(timing.done_time >= timing.end_time);
+  ASSERT(timing.done_time <= uv_hrtime());
+  after_work_cb_count++;
+}
+
+
+TEST_IMPL(threadpool_work_timing) {
+  uv_work_timing_t timing;
+  uv_getaddrinfo_t addrinfo_req;
+  uv_timer_t timer;
+  uv_fs_t fs_req;
+
+  ASSERT(0 == uv_queue_work(uv_default_loop(),
+                            &work_req,
+                            timing_work_cb,
+                            timing_after_work_cb));
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(after_work_cb_count == 1);
+
+  /* Synchronous requests never touch the threadpool. */
+  ASSERT(0 == uv_fs_stat(NULL, &fs_req, ".", NULL));
+  ASSERT(0 == uv_req_get_work_timing((uv_req_t*) &fs_req, &timing));
+  ASSERT(timing.submit_time == 0);
+  ASSERT(timing.done_time == 0);
+  uv_fs_req_cleanup(&fs_req);
+
+  /* Whatever the request held before does not show up as timing. */
+  memset(&addrinfo_req, 0xff, sizeof(addrinfo_req));
+  ASSERT(0 == uv_getaddrinfo(uv_default_loop(),
+                             &addrinfo_req,
+                             NULL,
+                             "127.0.0.1",
+                             NULL,
+                             NULL));
+  ASSERT(0 == uv_req_get_work_timing((uv_req_t*) &addrinfo_req, &timing));
+  ASSERT(timing.submit_time == 0);
+  ASSERT(timing.done_time == 0);
+  uv_freeaddrinfo(addrinfo_req.addrinfo);
+
+  ASSERT(0 == uv_timer_init(uv_default_loop(), &timer));
+  ASSERT(UV_EINVAL == uv_req_get_work_timing((uv_req_t*) &timer, &timing));
+  uv_close((uv_handle_t*) &timer, NULL);
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
 TEST_IMPL(threadpool_queue_work_einval) {
   int r;
 
@@ -74,3 +139,120 @@ TEST_IMPL(threadpool_queue_work_einval) {
   MAKE_VALGRIND_HAPPY();
   return 0;
 }
+
+
+static uv_sem_t stealing_sem;
+static uv_work_t stealing_reqs[32];
+static int stealing_done_count;
+
+
+static void stealing_block_cb(uv_work_t* req) {
+  uv_sem_wait(&stealing_sem);
+}
+
+
+static void stealing_work_cb(uv_work_t* req) {
+  /* Keep the other workers busy so new work is queued instead of being
+   * handed to an idle thread.
+   */
+  uv_sleep(1);
+}
+
+
+static void stealing_after_work_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  stealing_done_count++;
+
+  /* Work queued behind the blocked worker must have been picked up by the
+   * other workers, release the blocked one only once everything else ran.
+   */
+  if (stealing_done_count == ARRAY_SIZE(stealing_reqs) - 1)
+    uv_sem_post(&stealing_sem);
+}
+
+
+TEST_IMPL(threadpool_work_stealing) {
+  unsigned int i;
+
+  ASSERT(0 == uv_os_setenv("UV_THREADPOOL_SIZE", "4"));
+  ASSERT(0 == uv_sem_init(&stealing_sem, 0));
+
+  ASSERT(0 == uv_queue_work(uv_default_loop(),
+                            stealing_reqs + 0,
+                            stealing_block_cb,
+                            stealing_after_work_cb));
+
+  for (i = 1; i < ARRAY_SIZE(stealing_reqs); i++)
+    ASSERT(0 == uv_queue_work(uv_default_loop(),
+                              stealing_reqs + i,
+                              stealing_work_cb,
+                              stealing_after_work_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(stealing_done_count == ARRAY_SIZE(stealing_reqs));
+
+  uv_sem_destroy(&stealing_sem);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+static uv_sem_t pools_sem;
+static uv_work_t pools_blocked_req;
+static uv_work_t pools_default_req;
+static int pools_after_work_count;
+
+
+static void pools_block_cb(uv_work_t* req) {
+  uv_sem_wait(&pools_sem);
+}
+
+
+static void pools_work_cb(uv_work_t* req) {
+}
+
+
+static void pools_after_work_cb(uv_work_t* req, int status) {
+  ASSERT(status == 0);
+  pools_after_work_count++;
+
+  /* The default pool made progress while the other one is blocked. */
+  if (req == &pools_default_req)
+    uv_sem_post(&pools_sem);
+}
+
+
+TEST_IMPL(threadpool_separate_pools) {
+  ASSERT(UV_EINVAL == uv_threadpool_set_size(UV_THREADPOOL_MAX, 1));
+  ASSERT(0 == uv_threadpool_set_size(UV_THREADPOOL_DEFAULT, 1));
+  ASSERT(0 == uv_threadpool_set_size(UV_THREADPOOL_USER, 1));
+  ASSERT(0 == uv_sem_init(&pools_sem, 0));
+
+  ASSERT(UV_EINVAL == uv_queue_work_in(uv_default_loop(),
+                                       &pools_blocked_req,
+                                       UV_THREADPOOL_MAX,
+                                       pools_block_cb,
+                                       pools_after_work_cb));
+  ASSERT(0 == uv_queue_work_in(uv_default_loop(),
+                               &pools_blocked_req,
+                               UV_THREADPOOL_USER,
+                               pools_block_cb,
+                               pools_after_work_cb));
+  ASSERT(0 == uv_queue_work_in(uv_default_loop(),
+                               &pools_default_req,
+                               UV_THREADPOOL_DEFAULT,
+                               pools_work_cb,
+                               pools_after_work_cb));
+
+  /* Sizes are fixed once the threads have been started. */
+  ASSERT(UV_EBUSY == uv_threadpool_set_size(UV_THREADPOOL_FS, 1));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+  ASSERT(pools_after_work_count == 2);
+
+  uv_sem_destroy(&pools_sem);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
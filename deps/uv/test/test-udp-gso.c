@@ -0,0 +1,126 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define SEGMENT_SIZE 100
+#define NUM_SEGMENTS 10
+
+static uv_udp_t server;
+static uv_udp_t client;
+
+static int recv_cb_called;
+static size_t bytes_received;
+
+
+static void alloc_cb(uv_handle_t* handle,
+                     size_t suggested_size,
+                     uv_buf_t* buf) {
+  buf->len = suggested_size;
+  buf->base = malloc(buf->len);
+  ASSERT(buf->base != NULL);
+}
+
+
+static void recv_cb(uv_udp_t* handle,
+                    ssize_t nread,
+                    const uv_buf_t* buf,
+                    const struct sockaddr* addr,
+                    unsigned flags) {
+  size_t segment_size;
+
+  ASSERT(handle == &server);
+  ASSERT(nread >= 0);
+
+  if (nread == 0) {
+    ASSERT(addr == NULL);
+    free(buf->base);
+    return;
+  }
+
+  /* Whether the segments arrive one by one or coalesced is up to the kernel,
+   * either way they add up to what was sent.
+   */
+  segment_size = uv_udp_get_gro_segment_size(handle);
+  if (segment_size == 0)
+    ASSERT(nread == SEGMENT_SIZE);
+  else
+    ASSERT(segment_size == SEGMENT_SIZE);
+  ASSERT(nread % SEGMENT_SIZE == 0);
+
+  recv_cb_called++;
+  bytes_received += nread;
+  free(buf->base);
+
+  if (bytes_received == SEGMENT_SIZE * NUM_SEGMENTS) {
+    uv_close((uv_handle_t*) &server, NULL);
+    uv_close((uv_handle_t*) &client, NULL);
+  }
+}
+
+
+TEST_IMPL(udp_gso) {
+  struct sockaddr_in addr;
+  char data[SEGMENT_SIZE * NUM_SEGMENTS];
+  uv_buf_t buf;
+  int r;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_udp_init(uv_default_loop(), &server));
+  ASSERT(0 == uv_udp_bind(&server, (const struct sockaddr*) &addr, 0));
+  ASSERT(0 == uv_udp_init(uv_default_loop(), &client));
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", 0, &addr));
+  ASSERT(0 == uv_udp_bind(&client, (const struct sockaddr*) &addr, 0));
+
+  r = uv_udp_set_gso(&client, SEGMENT_SIZE);
+  if (r == UV_ENOTSUP || r == UV_ENOPROTOOPT) {
+    uv_close((uv_handle_t*) &server, NULL);
+    uv_close((uv_handle_t*) &client, NULL);
+    uv_run(uv_default_loop(), UV_RUN_DEFAULT);
+    RETURN_SKIP("UDP segmentation offload is not supported");
+  }
+  ASSERT(r == 0);
+  ASSERT(UV_EINVAL == uv_udp_set_gso(&client, 65536));
+
+  r = uv_udp_set_gro(&server, 1);
+  ASSERT(r == 0 || r == UV_ENOPROTOOPT);
+  ASSERT(0 == uv_udp_recv_start(&server, alloc_cb, recv_cb));
+
+  /* One send, NUM_SEGMENTS datagrams on the wire. */
+  memset(data, 'x', sizeof(data));
+  buf = uv_buf_init(data, sizeof(data));
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  r = uv_udp_try_send(&client, &buf, 1, (const struct sockaddr*) &addr);
+  ASSERT(r == (int) sizeof(data));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(bytes_received == sizeof(data));
+  ASSERT(recv_cb_called >= 1);
+  ASSERT(recv_cb_called <= NUM_SEGMENTS);
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
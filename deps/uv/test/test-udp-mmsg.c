@@ -0,0 +1,153 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "uv.h"
+#include "task.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_BATCHED 20
+#define NUM_QUEUED 10
+#define NUM_DATAGRAMS (NUM_BATCHED + NUM_QUEUED)
+
+static uv_udp_t server;
+static uv_udp_t client;
+static uv_udp_send_t send_reqs[NUM_QUEUED];
+
+static int recv_cb_called;
+static int chunk_cb_called;
+static int free_cb_called;
+static int send_cb_called;
+
+
+static void alloc_cb(uv_handle_t* handle,
+                     size_t suggested_size,
+                     uv_buf_t* buf) {
+  /* Room for eight datagrams of the suggested size. */
+  buf->len = 8 * suggested_size;
+  buf->base = malloc(buf->len);
+  ASSERT(buf->base != NULL);
+}
+
+
+static void send_cb(uv_udp_send_t* req, int status) {
+  ASSERT(status == 0);
+  send_cb_called++;
+}
+
+
+static void recv_cb(uv_udp_t* handle,
+                    ssize_t nread,
+                    const uv_buf_t* buf,
+                    const struct sockaddr* addr,
+                    unsigned flags) {
+  ASSERT(handle == &server);
+  ASSERT(nread >= 0);
+
+  if (flags & UV_UDP_MMSG_FREE) {
+    ASSERT(nread == 0);
+    ASSERT(addr == NULL);
+    free_cb_called++;
+    free(buf->base);
+    return;
+  }
+
+  if (nread == 0) {
+    ASSERT(addr == NULL);
+    free(buf->base);
+    return;
+  }
+
+  ASSERT(nread == 4);
+  ASSERT(addr != NULL);
+  ASSERT(memcmp("PING", buf->base, nread) == 0);
+  recv_cb_called++;
+
+  if (flags & UV_UDP_MMSG_CHUNK)
+    chunk_cb_called++;
+  else
+    free(buf->base);
+
+  if (recv_cb_called == NUM_DATAGRAMS) {
+    uv_close((uv_handle_t*) &server, NULL);
+    uv_close((uv_handle_t*) &client, NULL);
+  }
+}
+
+
+TEST_IMPL(udp_mmsg) {
+  struct sockaddr_in addr;
+  struct sockaddr* addrs[NUM_BATCHED];
+  uv_buf_t* bufs[NUM_BATCHED];
+  unsigned int nbufs[NUM_BATCHED];
+  uv_buf_t buf;
+  int i;
+  int r;
+
+  ASSERT(0 == uv_ip4_addr("127.0.0.1", TEST_PORT, &addr));
+  ASSERT(0 == uv_udp_init_ex(uv_default_loop(),
+                             &server,
+                             AF_UNSPEC | UV_UDP_RECVMMSG));
+  ASSERT(0 == uv_udp_bind(&server, (const struct sockaddr*) &addr, 0));
+  ASSERT(0 == uv_udp_recv_start(&server, alloc_cb, recv_cb));
+  ASSERT(0 == uv_udp_init(uv_default_loop(), &client));
+
+  buf = uv_buf_init("PING", 4);
+  for (i = 0; i < NUM_BATCHED; i++) {
+    bufs[i] = &buf;
+    nbufs[i] = 1;
+    addrs[i] = (struct sockaddr*) &addr;
+  }
+
+  ASSERT(UV_EINVAL == uv_udp_try_send2(&client, 0, bufs, nbufs, addrs, 0));
+  ASSERT(UV_EINVAL == uv_udp_try_send2(&client, 1, bufs, nbufs, addrs, 1));
+
+  r = uv_udp_try_send2(&client, NUM_BATCHED, bufs, nbufs, addrs, 0);
+  ASSERT(r == NUM_BATCHED);
+
+  /* The first one goes out right away, the rest is queued and sent together
+   * once the socket is writable.
+   */
+  for (i = 0; i < NUM_QUEUED; i++)
+    ASSERT(0 == uv_udp_send(&send_reqs[i],
+                            &client,
+                            &buf,
+                            1,
+                            (const struct sockaddr*) &addr,
+                            send_cb));
+
+  ASSERT(0 == uv_run(uv_default_loop(), UV_RUN_DEFAULT));
+
+  ASSERT(send_cb_called == NUM_QUEUED);
+  ASSERT(recv_cb_called == NUM_DATAGRAMS);
+#if defined(__linux__)
+  ASSERT(chunk_cb_called == NUM_DATAGRAMS);
+  ASSERT(free_cb_called > 0);
+  ASSERT(free_cb_called < NUM_DATAGRAMS);
+#else
+  ASSERT(chunk_cb_called == 0);
+  ASSERT(free_cb_called == 0);
+#endif
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
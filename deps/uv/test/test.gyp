@@ -34,6 +34,7 @@
         'test-fs.c',
         'test-fs-copyfile.c',
         'test-fs-event.c',
+        'test-fs-io-uring.c',
         'test-fs-poll.c',
         'test-getters-setters.c',
         'test-get-currentexe.c',
@@ -59,6 +60,7 @@
         'test-loop-stop.c',
         'test-loop-time.c',
         'test-loop-configure.c',
+        'test-metrics.c',
         'test-walk-handles.c',
         'test-watcher-cross-stop.c',
         'test-multiple-listen.c',
@@ -106,6 +108,7 @@
         'test-tcp-close-accept.c',
         'test-tcp-close-while-connecting.c',
         'test-tcp-create-socket-early.c',
+        'test-tcp-exclusive-accept.c',
         'test-tcp-connect-error-after-write.c',
         'test-tcp-shutdown-after-write.c',
         'test-tcp-flags.c',
@@ -116,6 +119,9 @@
         'test-tcp-write-to-half-open-connection.c',
         'test-tcp-write-after-connect.c',
         'test-tcp-writealot.c',
+        'test-tcp-zerocopy.c',
+        'test-tcp-fastopen.c',
+        'test-tcp-accept-backlog.c',
         'test-tcp-write-fail.c',
         'test-tcp-try-write.c',
         'test-tcp-unexpected-read.c',
@@ -138,6 +144,7 @@
         'test-udp-bind.c',
         'test-udp-create-socket-early.c',
         'test-udp-dgram-too-big.c',
+        'test-udp-gso.c',
         'test-udp-ipv6.c',
         'test-udp-open.c',
         'test-udp-options.c',
@@ -151,6 +158,7 @@
         'test-udp-multicast-ttl.c',
         'test-ip4-addr.c',
         'test-ip6-addr.c',
+        'test-udp-mmsg.c',
         'test-udp-multicast-interface.c',
         'test-udp-multicast-interface6.c',
         'test-udp-try-send.c',
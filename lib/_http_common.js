@@ -23,7 +23,7 @@
 
 const { getOptionValue } = require('internal/options');
 
-const { methods, HTTPParser } =
+const { methods, HTTPParser, batchState, serializeHeaders } =
   getOptionValue('--http-parser') === 'legacy' ?
     internalBinding('http_parser') : internalBinding('http_parser_llhttp');
 
@@ -32,9 +32,12 @@ const { ondrain } = require('internal/http');
 const incoming = require('_http_incoming');
 const {
   IncomingMessage,
+  inflateHeaders,
   readStart,
-  readStop
+  readStop,
+  setLazyHeaders
 } = incoming;
+const { _addHeaderLines } = IncomingMessage.prototype;
 
 const debug = require('util').debuglog('http');
 
@@ -44,6 +47,19 @@ const kOnHeadersComplete = HTTPParser.kOnHeadersComplete | 0;
 const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
+const kOnBatch = HTTPParser.kOnBatch | 0;
+
+// Layout of `batchState`, see `BatchMessageFields` in
+// src/node_http_parser_impl.h.
+const kBatchMethod = 0;
+const kBatchVersionMajor = 1;
+const kBatchVersionMinor = 2;
+const kBatchShouldKeepAlive = 3;
+const kBatchHeaderCount = 4;
+const kBatchUrlOffset = 5;
+const kBatchUrlLength = 6;
+const kBatchValuesOffset = 7;
+const kBatchFieldsPerMessage = 8;
 
 const MAX_HEADER_PAIRS = 2000;
 
@@ -67,7 +83,7 @@ function parserOnHeaders(headers, url) {
 // all our parsers are request parsers.
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
-                                 shouldKeepAlive) {
+                                 shouldKeepAlive, headerValues) {
   const parser = this;
   const { socket } = parser;
 
@@ -93,13 +109,23 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
   incoming.url = url;
   incoming.upgrade = upgrade;
 
-  var n = headers.length;
+  // With lazy headers, `headers` only holds the names. They can't be used if
+  // a subclass wants to see the headers in `_addHeaderLines()` right away.
+  const lazy = headerValues !== undefined &&
+               incoming._addHeaderLines === _addHeaderLines;
+  if (headerValues !== undefined && !lazy)
+    headers = inflateHeaders(headers, headerValues);
+
+  var n = lazy ? headers.length * 2 : headers.length;
 
   // If parser.maxHeaderPairs <= 0 assume that there's no limit.
   if (parser.maxHeaderPairs > 0)
     n = Math.min(n, parser.maxHeaderPairs);
 
-  incoming._addHeaderLines(headers, n);
+  if (lazy)
+    setLazyHeaders(incoming, headers, headerValues, n);
+  else
+    incoming._addHeaderLines(headers, n);
 
   if (typeof method === 'number') {
     // server only
@@ -152,6 +178,47 @@ function parserOnMessageComplete() {
 }
 
 
+// Only called in batched mode, with all body-less requests that one execute()
+// has parsed. `names` holds the header names of all of them, `data` their URLs
+// and header values. The values take the same lazy path as for a single
+// request.
+function parserOnBatch(names, data) {
+  const parser = this;
+  const { socket } = parser;
+
+  // A nested execute() of another parser would overwrite the shared state.
+  const state = batchState.slice(0,
+                                 1 + batchState[0] * kBatchFieldsPerMessage);
+
+  var k = 0;
+  for (var i = 1; i < state.length; i += kBatchFieldsPerMessage) {
+    // A request handler may have freed the parser.
+    if (parser.socket !== socket)
+      return;
+
+    const headerCount = state[i + kBatchHeaderCount];
+    const headers = names.slice(k, k + headerCount);
+    k += headerCount;
+    const urlOffset = state[i + kBatchUrlOffset];
+    const url = data.latin1Slice(urlOffset,
+                                 urlOffset + state[i + kBatchUrlLength]);
+    // The offset table at the start tells where the values end.
+    const headerValues = data.subarray(state[i + kBatchValuesOffset]);
+
+    parser[kOnHeadersComplete](state[i + kBatchVersionMajor],
+                               state[i + kBatchVersionMinor],
+                               headers,
+                               state[i + kBatchMethod],
+                               url,
+                               undefined,
+                               undefined,
+                               false,
+                               state[i + kBatchShouldKeepAlive] === 1,
+                               headerValues);
+    parser[kOnMessageComplete]();
+  }
+}
+
 const parsers = new FreeList('parsers', 1000, function parsersCb() {
   const parser = new HTTPParser(HTTPParser.REQUEST);
 
@@ -162,6 +229,7 @@ const parsers = new FreeList('parsers', 1000, function parsersCb() {
   parser[kOnHeadersComplete] = parserOnHeadersComplete;
   parser[kOnBody] = parserOnBody;
   parser[kOnMessageComplete] = parserOnMessageComplete;
+  parser[kOnBatch] = parserOnBatch;
 
   return parser;
 });
@@ -248,5 +316,6 @@ module.exports = {
   methods,
   parsers,
   kIncomingMessage,
-  HTTPParser
+  HTTPParser,
+  serializeHeaders
 };
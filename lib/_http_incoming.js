@@ -23,6 +23,10 @@
 
 const Stream = require('stream');
 
+const kHeaders = Symbol('kHeaders');
+const kRawHeaders = Symbol('kRawHeaders');
+const kLazyHeaders = Symbol('kLazyHeaders');
+
 function readStart(socket) {
   if (socket && !socket._paused && socket.readable)
     socket.resume();
@@ -46,8 +50,9 @@ function IncomingMessage(socket) {
   this.httpVersionMinor = null;
   this.httpVersion = null;
   this.complete = false;
-  this.headers = {};
-  this.rawHeaders = [];
+  this[kHeaders] = {};
+  this[kRawHeaders] = [];
+  this[kLazyHeaders] = null;
   this.trailers = {};
   this.rawTrailers = [];
 
@@ -74,6 +79,105 @@ function IncomingMessage(socket) {
 Object.setPrototypeOf(IncomingMessage.prototype, Stream.Readable.prototype);
 Object.setPrototypeOf(IncomingMessage, Stream.Readable);
 
+// The HTTP parser may hand over header values as one Buffer instead of as
+// strings (see `Parser::CreateHeaderValues()` in src/node_http_parser_impl.h).
+// They are only turned into strings once `headers` or `rawHeaders` is used.
+// Both are accessors on the prototype: defining them on every message would
+// cost more than the strings that are saved.
+Object.defineProperty(IncomingMessage.prototype, 'headers', {
+  configurable: true,
+  enumerable: true,
+  get() {
+    materializeHeaders(this);
+    return this[kHeaders];
+  },
+  set(val) {
+    materializeHeaders(this);
+    this[kHeaders] = val;
+  }
+});
+
+Object.defineProperty(IncomingMessage.prototype, 'rawHeaders', {
+  configurable: true,
+  enumerable: true,
+  get() {
+    materializeHeaders(this);
+    return this[kRawHeaders];
+  },
+  set(val) {
+    materializeHeaders(this);
+    this[kRawHeaders] = val;
+  }
+});
+
+// `names` is a list of header names, `values` the Buffer holding their
+// values, and `n` has the same meaning as for `_addHeaderLines()`.
+function setLazyHeaders(msg, names, values, n) {
+  const offsets = new Uint32Array(values.buffer, values.byteOffset,
+                                  names.length + 1);
+  msg[kLazyHeaders] = { names, values, offsets, n };
+}
+
+function lazyHeaderValue(lazy, i) {
+  const { values, offsets } = lazy;
+  return values.latin1Slice(offsets.byteLength + offsets[i],
+                            offsets.byteLength + offsets[i + 1]);
+}
+
+function lazyRawHeaders(lazy) {
+  const { names } = lazy;
+  const rawHeaders = new Array(names.length * 2);
+  for (var i = 0; i < names.length; i++) {
+    rawHeaders[i * 2] = names[i];
+    rawHeaders[i * 2 + 1] = lazyHeaderValue(lazy, i);
+  }
+  return rawHeaders;
+}
+
+function materializeHeaders(msg) {
+  const lazy = msg[kLazyHeaders];
+  if (lazy == null)
+    return;
+  msg[kLazyHeaders] = null;
+
+  const rawHeaders = msg[kRawHeaders] = lazyRawHeaders(lazy);
+  const dest = msg[kHeaders];
+  for (var i = 0; i < lazy.n; i += 2)
+    msg._addHeaderLine(rawHeaders[i], rawHeaders[i + 1], dest);
+}
+
+// Turns the parser's names and values into the usual flat list of headers.
+function inflateHeaders(names, values) {
+  const offsets = new Uint32Array(values.buffer, values.byteOffset,
+                                  names.length + 1);
+  return lazyRawHeaders({ names, values, offsets });
+}
+
+// Returns what `msg.headers[name]` would be for a header that is joined with
+// ', ' when repeated, without materializing the other headers. `name` must
+// be lowercase.
+function peekHeader(msg, name) {
+  // `msg` is not necessarily an IncomingMessage, e.g. for a ServerResponse
+  // that is created on its own.
+  const lazy = msg[kLazyHeaders];
+  if (lazy == null)
+    return msg.headers[name];
+
+  const { names, n } = lazy;
+  var value;
+  for (var i = 0; i * 2 < n; i++) {
+    const field = names[i];
+    if (field.length === name.length && field.toLowerCase() === name) {
+      if (value === undefined)
+        value = lazyHeaderValue(lazy, i);
+      else
+        value += ', ' + lazyHeaderValue(lazy, i);
+    }
+  }
+  return value;
+}
+
+
 IncomingMessage.prototype.setTimeout = function setTimeout(msecs, callback) {
   if (callback)
     this.on('timeout', callback);
@@ -312,6 +416,9 @@ IncomingMessage.prototype._dump = function _dump() {
 
 module.exports = {
   IncomingMessage,
+  inflateHeaders,
+  peekHeader,
   readStart,
-  readStop
+  readStop,
+  setLazyHeaders
 };
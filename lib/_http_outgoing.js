@@ -47,9 +47,11 @@ const {
 } = require('internal/errors').codes;
 const { validateString } = require('internal/validators');
 
-const { CRLF, debug } = common;
+const { CRLF, debug, serializeHeaders } = common;
 
 const kIsCorked = Symbol('isCorked');
+const kHeader = Symbol('header');
+const kHeaderString = Symbol('headerString');
 
 const hasOwnProperty = Function.call.bind(Object.prototype.hasOwnProperty);
 
@@ -101,7 +103,8 @@ function OutgoingMessage() {
 
   this.socket = null;
   this.connection = null;
-  this._header = null;
+  this[kHeader] = null;
+  this[kHeaderString] = null;
   this[outHeadersKey] = null;
 
   this._onPendingData = noopPendingOutput;
@@ -110,6 +113,32 @@ Object.setPrototypeOf(OutgoingMessage.prototype, Stream.prototype);
 Object.setPrototypeOf(OutgoingMessage, Stream);
 
 
+// The stored header is a Buffer that is written to the socket as is. It is
+// only decoded when `_header` is read, which does not happen on the hot path.
+Object.defineProperty(OutgoingMessage.prototype, '_header', {
+  configurable: true,
+  get() {
+    const header = this[kHeader];
+    if (!(header instanceof Buffer))
+      return header;
+    if (this[kHeaderString] === null)
+      this[kHeaderString] = header.latin1Slice(0, header.length);
+    return this[kHeaderString];
+  },
+  set(val) {
+    this[kHeader] = val;
+    this[kHeaderString] = null;
+  }
+});
+
+// Same as `!!msg._header`, but does not decode the stored header. Falls back
+// to `_header` for objects that were not created by OutgoingMessage.
+function headerStored(msg) {
+  const header = msg[kHeader];
+  return header === undefined ? !!msg._header : !!header;
+}
+
+
 Object.defineProperty(OutgoingMessage.prototype, '_headers', {
   get: util.deprecate(function() {
     return this.getHeaders();
@@ -160,7 +189,7 @@ Object.defineProperty(OutgoingMessage.prototype, '_headerNames', {
 
 
 OutgoingMessage.prototype._renderHeaders = function _renderHeaders() {
-  if (this._header) {
+  if (headerStored(this)) {
     throw new ERR_HTTP_HEADERS_SENT('render');
   }
 
@@ -215,11 +244,15 @@ OutgoingMessage.prototype._send = function _send(data, encoding, callback) {
   // the same packet. Future versions of Node are going to take care of
   // this at a lower level and in a more general way.
   if (!this._headerSent) {
-    if (typeof data === 'string' &&
-        (encoding === 'utf8' || encoding === 'latin1' || !encoding)) {
-      data = this._header + data;
+    var header = this[kHeader];
+    if (data.length === 0) {
+      data = header;
+    } else if (typeof header === 'string' && typeof data === 'string' &&
+               (encoding === 'utf8' || encoding === 'latin1' || !encoding)) {
+      data = header + data;
     } else {
-      var header = this._header;
+      // The header and the data are flushed together, so a corked socket
+      // still writes them with a single writev().
       if (this.output.length === 0) {
         this.output = [header];
         this.outputEncodings = ['latin1'];
@@ -293,9 +326,20 @@ function _storeHeader(firstLine, headers) {
     date: false,
     expect: false,
     trailer: false,
-    header: firstLine
+    validate: false,
+    fields: []
   };
 
+  // The names and values are only validated by serializeHeader(), after the
+  // code below has updated the message. Keep what it changes, so that an
+  // invalid header leaves the message as it was.
+  const last = this._last;
+  const chunkedEncoding = this.chunkedEncoding;
+  const shouldKeepAlive = this.shouldKeepAlive;
+  const removedConnection = this._removedConnection;
+  const removedContLen = this._removedContLen;
+  const removedTE = this._removedTE;
+
   var key;
   if (headers === this[outHeadersKey]) {
     for (key in headers) {
@@ -315,11 +359,11 @@ function _storeHeader(firstLine, headers) {
     }
   }
 
-  let { header } = state;
+  const { fields } = state;
 
   // Date header
   if (this.sendDate && !state.date) {
-    header += 'Date: ' + utcDate() + CRLF;
+    fields.push('Date', utcDate());
   }
 
   // Force the connection to close when the response is a 204 No Content or
@@ -349,10 +393,10 @@ function _storeHeader(firstLine, headers) {
     const shouldSendKeepAlive = this.shouldKeepAlive &&
         (state.contLen || this.useChunkedEncodingByDefault || this.agent);
     if (shouldSendKeepAlive) {
-      header += 'Connection: keep-alive\r\n';
+      fields.push('Connection', 'keep-alive');
     } else {
       this._last = true;
-      header += 'Connection: close\r\n';
+      fields.push('Connection', 'close');
     }
   }
 
@@ -365,9 +409,9 @@ function _storeHeader(firstLine, headers) {
     } else if (!state.trailer &&
                !this._removedContLen &&
                typeof this._contentLength === 'number') {
-      header += 'Content-Length: ' + this._contentLength + CRLF;
+      fields.push('Content-Length', '' + this._contentLength);
     } else if (!this._removedTE) {
-      header += 'Transfer-Encoding: chunked\r\n';
+      fields.push('Transfer-Encoding', 'chunked');
       this.chunkedEncoding = true;
     } else {
       // We should only be able to get here if both Content-Length and
@@ -385,7 +429,19 @@ function _storeHeader(firstLine, headers) {
     throw new ERR_HTTP_TRAILER_INVALID();
   }
 
-  this._header = header + CRLF;
+  const header = serializeHeader(firstLine, fields, state.validate);
+  if (typeof header === 'number') {
+    this._last = last;
+    this.chunkedEncoding = chunkedEncoding;
+    this.shouldKeepAlive = shouldKeepAlive;
+    this._removedConnection = removedConnection;
+    this._removedContLen = removedContLen;
+    this._removedTE = removedTE;
+    throwInvalidHeader(fields, header);
+  }
+
+  this[kHeader] = header;
+  this[kHeaderString] = null;
   this._headerSent = false;
 
   // Wait until the first body chunk, or close(), is sent to flush,
@@ -393,9 +449,39 @@ function _storeHeader(firstLine, headers) {
   if (state.expect) this._send('');
 }
 
+// Writes the first line, the header fields and the final CRLF into a single
+// Buffer. When `validate` is true, the characters of the names and values
+// are checked while they are copied, instead of by a separate RegExp pass.
+// Returns the negative result of serializeHeaders() if a field is invalid.
+function serializeHeader(firstLine, fields, validate) {
+  var size = firstLine.length + 2;
+  for (var i = 0; i < fields.length; i++)
+    size += fields[i].length + 2;
+
+  const header = Buffer.allocUnsafe(size);
+  const ret = serializeHeaders(header, firstLine, fields, validate);
+  return ret < 0 ? ret : header;
+}
+
+// Throws the error the JS validators give for the field that
+// serializeHeaders() rejected.
+function throwInvalidHeader(fields, ret) {
+  const index = -1 - ret;
+  if (index % 2 === 0)
+    validateHeaderName(fields[index]);
+  else
+    validateHeaderValue(fields[index - 1], fields[index]);
+  assert(false, `serializeHeaders() rejected valid header field ${index}`);
+}
+
 function processHeader(self, state, key, value, validate) {
-  if (validate)
-    validateHeaderName(key);
+  if (validate) {
+    // Only the checks that need the original values are done here. The
+    // characters are checked by serializeHeader().
+    if (typeof key !== 'string')
+      validateHeaderName(key);
+    state.validate = true;
+  }
   if (Array.isArray(value)) {
     if (value.length < 2 || !isCookieField(key)) {
       for (var i = 0; i < value.length; i++)
@@ -408,9 +494,9 @@ function processHeader(self, state, key, value, validate) {
 }
 
 function storeHeader(self, state, key, value, validate) {
-  if (validate)
+  if (validate && value === undefined)
     validateHeaderValue(key, value);
-  state.header += key + ': ' + value + CRLF;
+  state.fields.push(key, '' + value);
   matchHeader(self, state, key, value);
 }
 
@@ -479,7 +565,7 @@ function validateHeaderValue(name, value) {
 }
 
 OutgoingMessage.prototype.setHeader = function setHeader(name, value) {
-  if (this._header) {
+  if (headerStored(this)) {
     throw new ERR_HTTP_HEADERS_SENT('set');
   }
   validateHeaderName(name);
@@ -537,7 +623,7 @@ OutgoingMessage.prototype.hasHeader = function hasHeader(name) {
 OutgoingMessage.prototype.removeHeader = function removeHeader(name) {
   validateString(name, 'name');
 
-  if (this._header) {
+  if (headerStored(this)) {
     throw new ERR_HTTP_HEADERS_SENT('remove');
   }
 
@@ -571,7 +657,7 @@ OutgoingMessage.prototype._implicitHeader = function _implicitHeader() {
 Object.defineProperty(OutgoingMessage.prototype, 'headersSent', {
   configurable: true,
   enumerable: true,
-  get: function() { return !!this._header; }
+  get: function() { return headerStored(this); }
 });
 
 
@@ -594,7 +680,7 @@ function write_(msg, chunk, encoding, callback, fromEnd) {
     return true;
   }
 
-  if (!msg._header) {
+  if (!headerStored(msg)) {
     msg._implicitHeader();
   }
 
@@ -702,7 +788,7 @@ OutgoingMessage.prototype.end = function end(chunk, encoding, callback) {
     if (typeof chunk !== 'string' && !(chunk instanceof Buffer)) {
       throw new ERR_INVALID_ARG_TYPE('chunk', ['string', 'Buffer'], chunk);
     }
-    if (!this._header) {
+    if (!headerStored(this)) {
       if (typeof chunk === 'string')
         this._contentLength = Buffer.byteLength(chunk, encoding);
       else
@@ -713,7 +799,7 @@ OutgoingMessage.prototype.end = function end(chunk, encoding, callback) {
       uncork = true;
     }
     write_(this, chunk, encoding, null, true);
-  } else if (!this._header) {
+  } else if (!headerStored(this)) {
     this._contentLength = 0;
     this._implicitHeader();
   }
@@ -817,7 +903,7 @@ OutgoingMessage.prototype._flushOutput = function _flushOutput(socket) {
 
 
 OutgoingMessage.prototype.flushHeaders = function flushHeaders() {
-  if (!this._header) {
+  if (!headerStored(this)) {
     this._implicitHeader();
   }
 
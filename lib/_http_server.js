@@ -43,7 +43,7 @@ const {
   getOrSetAsyncId
 } = require('internal/async_hooks');
 const is_reused_symbol = require('internal/freelist').symbols.is_reused_symbol;
-const { IncomingMessage } = require('_http_incoming');
+const { IncomingMessage, peekHeader } = require('_http_incoming');
 const {
   ERR_HTTP_HEADERS_SENT,
   ERR_HTTP_INVALID_STATUS_CODE,
@@ -53,6 +53,7 @@ const {
 const Buffer = require('buffer').Buffer;
 
 const kServerResponse = Symbol('ServerResponse');
+const kBatchPipelinedRequests = Symbol('kBatchPipelinedRequests');
 
 const STATUS_CODES = {
   100: 'Continue',
@@ -133,7 +134,8 @@ function ServerResponse(req) {
   this._expect_continue = false;
 
   if (req.httpVersionMajor < 1 || req.httpVersionMinor < 1) {
-    this.useChunkedEncodingByDefault = chunkExpression.test(req.headers.te);
+    this.useChunkedEncodingByDefault =
+      chunkExpression.test(peekHeader(req, 'te'));
     this.shouldKeepAlive = false;
   }
 }
@@ -289,6 +291,7 @@ function Server(options, requestListener) {
 
   this[kIncomingMessage] = options.IncomingMessage || IncomingMessage;
   this[kServerResponse] = options.ServerResponse || ServerResponse;
+  this[kBatchPipelinedRequests] = !!options.batchPipelinedRequests;
 
   net.Server.call(this, { allowHalfOpen: true });
 
@@ -344,7 +347,8 @@ function connectionListenerInternal(server, socket) {
   socket.on('timeout', socketOnTimeout);
 
   var parser = parsers.alloc();
-  parser.reinitialize(HTTPParser.REQUEST, parser[is_reused_symbol]);
+  parser.reinitialize(HTTPParser.REQUEST, parser[is_reused_symbol], true,
+                      server[kBatchPipelinedRequests]);
   parser.socket = socket;
 
   // We are starting to wait for our headers.
@@ -659,9 +663,10 @@ function parserOnIncoming(server, socket, state, req, keepAlive) {
   res.on('finish',
          resOnFinish.bind(undefined, req, res, socket, state, server));
 
-  if (req.headers.expect !== undefined &&
+  const expect = peekHeader(req, 'expect');
+  if (expect !== undefined &&
       (req.httpVersionMajor === 1 && req.httpVersionMinor === 1)) {
-    if (continueExpression.test(req.headers.expect)) {
+    if (continueExpression.test(expect)) {
       res._expect_continue = true;
 
       if (server.listenerCount('checkContinue') > 0) {
@@ -54,6 +54,7 @@ const kConnectOptions = Symbol('connect-options');
 const kDisableRenegotiation = Symbol('disable-renegotiation');
 const kErrorEmitted = Symbol('error-emitted');
 const kHandshakeTimeout = Symbol('handshake-timeout');
+const kKernelTLS = Symbol('kernel-tls');
 const kRes = Symbol('res');
 const kSNICallback = Symbol('snicallback');
 
@@ -329,7 +330,8 @@ function TLSSocket(socket, opts) {
     handle: this._wrapHandle(wrap),
     allowHalfOpen: socket && socket.allowHalfOpen,
     readable: false,
-    writable: false
+    writable: false,
+    onread: tlsOptions.onread
   });
 
   // Proxy for API compatibility
@@ -539,6 +541,9 @@ TLSSocket.prototype._init = function(socket, wrap) {
   if (options.handshakeTimeout > 0)
     this.setTimeout(options.handshakeTimeout, this._handleTimeout);
 
+  if (options.kernelTLS)
+    ssl.enableKernelTLS();
+
   if (socket instanceof net.Socket) {
     this._parent = socket;
 
@@ -563,6 +568,13 @@ TLSSocket.prototype.renegotiate = function(options, callback) {
   if (this.destroyed)
     return;
 
+  if (this._handle.isKernelTLSActive()) {
+    if (callback) {
+      process.nextTick(callback, new ERR_TLS_RENEGOTIATION_DISABLED());
+    }
+    return false;
+  }
+
   let requestCert = !!this._requestCert;
   let rejectUnauthorized = !!this._rejectUnauthorized;
 
@@ -706,6 +718,12 @@ TLSSocket.prototype.getCipher = function(err) {
   return null;
 };
 
+TLSSocket.prototype.isKernelTLSActive = function() {
+  if (this._handle)
+    return this._handle.isKernelTLSActive();
+  return false;
+};
+
 // TODO: support anonymous (nocert) and PSK
 
 
@@ -756,6 +774,7 @@ function tlsConnectionListener(rawSocket) {
     requestCert: this.requestCert,
     rejectUnauthorized: this.rejectUnauthorized,
     handshakeTimeout: this[kHandshakeTimeout],
+    kernelTLS: this[kKernelTLS],
     ALPNProtocols: this.ALPNProtocols,
     SNICallback: this[kSNICallback] || SNICallback
   });
@@ -861,6 +880,7 @@ function Server(options, listener) {
   this.setSecureContext(options);
 
   this[kHandshakeTimeout] = options.handshakeTimeout || (120 * 1000);
+  this[kKernelTLS] = options.kernelTLS === true;
   this[kSNICallback] = options.SNICallback;
 
   if (typeof this[kHandshakeTimeout] !== 'number') {
@@ -1237,7 +1257,9 @@ exports.connect = function connect(...args) {
     rejectUnauthorized: options.rejectUnauthorized !== false,
     session: options.session,
     ALPNProtocols: options.ALPNProtocols,
-    requestOCSP: options.requestOCSP
+    requestOCSP: options.requestOCSP,
+    kernelTLS: options.kernelTLS === true,
+    onread: options.onread
   });
 
   tlssock[kConnectOptions] = options;
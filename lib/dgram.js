@@ -41,6 +41,7 @@ const {
 } = errors.codes;
 const {
   isInt32,
+  validateInt32,
   validateString,
   validateNumber
 } = require('internal/validators');
@@ -79,6 +80,7 @@ function Socket(type, listener) {
   var lookup;
   let recvBufferSize;
   let sendBufferSize;
+  let recvBatchSize;
 
   if (type !== null && typeof type === 'object') {
     var options = type;
@@ -86,6 +88,11 @@ function Socket(type, listener) {
     lookup = options.lookup;
     recvBufferSize = options.recvBufferSize;
     sendBufferSize = options.sendBufferSize;
+    recvBatchSize = options.recvBatchSize;
+    if (recvBatchSize !== undefined)
+      validateInt32(recvBatchSize, 'options.recvBatchSize', 1);
+    if (options.gsoSegmentSize !== undefined)
+      validateInt32(options.gsoSegmentSize, 'options.gsoSegmentSize', 0, 65535);
   }
 
   var handle = newHandle(type, lookup);
@@ -104,8 +111,11 @@ function Socket(type, listener) {
     queue: undefined,
     reuseAddr: options && options.reuseAddr, // Use UV_UDP_REUSEADDR if true.
     ipv6Only: options && options.ipv6Only,
+    gsoSegmentSize: options && options.gsoSegmentSize,
+    gro: !!(options && options.gro),
     recvBufferSize,
-    sendBufferSize
+    sendBufferSize,
+    recvBatchSize
   };
 }
 Object.setPrototypeOf(Socket.prototype, EventEmitter.prototype);
@@ -120,7 +130,30 @@ function createSocket(type, listener) {
 function startListening(socket) {
   const state = socket[kStateSymbol];
 
+  // The offloads can only be turned on once the socket exists. Kernels that
+  // don't support them fail like a bind() does.
+  if (state.gsoSegmentSize) {
+    const err = state.handle.setGSO(state.gsoSegmentSize);
+    if (err) {
+      state.bindState = BIND_STATE_UNBOUND;
+      socket.emit('error', errnoException(err, 'setGSO'));
+      return;
+    }
+  }
+
+  if (state.gro) {
+    const err = state.handle.setGRO(1);
+    if (err) {
+      state.bindState = BIND_STATE_UNBOUND;
+      socket.emit('error', errnoException(err, 'setGRO'));
+      return;
+    }
+  }
+
   state.handle.onmessage = onMessage;
+  state.handle.onmessagebatch = onMessageBatch;
+  if (state.recvBatchSize > 1)
+    state.handle.setRecvBatchSize(state.recvBatchSize);
   // Todo: handle errors
   state.handle.recvStart();
   state.receiving = true;
@@ -143,6 +176,7 @@ function replaceHandle(self, newHandle) {
   newHandle.lookup = oldHandle.lookup;
   newHandle.bind = oldHandle.bind;
   newHandle.send = oldHandle.send;
+  newHandle.sendBatch = oldHandle.sendBatch;
   newHandle[owner_symbol] = self;
 
   // Replace the existing handle by the handle we got from master.
@@ -531,6 +565,149 @@ function afterSend(err, sent) {
   this.callback(err, sent);
 }
 
+// sendBatch([{ msg, port, address }, ...], callback)
+Socket.prototype.sendBatch = function(messages, callback) {
+  if (!Array.isArray(messages))
+    throw new ERR_INVALID_ARG_TYPE('messages', 'Array', messages);
+  if (callback !== undefined && typeof callback !== 'function')
+    throw new ERR_INVALID_ARG_TYPE('callback', 'Function', callback);
+
+  const count = messages.length;
+  const list = new Array(count);
+  const ports = new Array(count);
+  const addresses = new Array(count);
+  for (var i = 0; i < count; i++) {
+    const message = messages[i];
+    if (message === null || typeof message !== 'object') {
+      throw new ERR_INVALID_ARG_TYPE(`messages[${i}]`, 'Object', message);
+    }
+
+    let msg = message.msg;
+    if (typeof msg === 'string') {
+      msg = Buffer.from(msg);
+    } else if (!isUint8Array(msg)) {
+      throw new ERR_INVALID_ARG_TYPE(`messages[${i}].msg`,
+                                     ['Buffer', 'Uint8Array', 'string'], msg);
+    }
+
+    const port = message.port >>> 0;
+    if (port === 0 || port > 65535)
+      throw new ERR_SOCKET_BAD_PORT(message.port);
+
+    const address = message.address;
+    if (address && typeof address !== 'string') {
+      throw new ERR_INVALID_ARG_TYPE(`messages[${i}].address`,
+                                     ['string', 'falsy'], address);
+    }
+
+    list[i] = msg;
+    ports[i] = port;
+    addresses[i] = address;
+  }
+
+  healthCheck(this);
+
+  if (count === 0) {
+    if (callback)
+      process.nextTick(callback, null, 0);
+    return;
+  }
+
+  const state = this[kStateSymbol];
+
+  if (state.bindState === BIND_STATE_UNBOUND)
+    this.bind({ port: 0, exclusive: true }, null);
+
+  if (state.bindState !== BIND_STATE_BOUND) {
+    enqueue(this, lookupBatch.bind(null, this, list, ports, addresses,
+                                   callback));
+    return;
+  }
+
+  lookupBatch(this, list, ports, addresses, callback);
+};
+
+// Resolves every distinct address of a batch once before sending it.
+function lookupBatch(self, list, ports, addresses, callback) {
+  const state = self[kStateSymbol];
+  if (!state.handle)
+    return;
+
+  const unique = [...new Set(addresses)];
+  const resolved = new Map();
+  let pending = unique.length;
+  let failed = false;
+
+  const afterDns = (address, ex, ip) => {
+    if (failed)
+      return;
+    if (ex) {
+      failed = true;
+    } else {
+      resolved.set(address, ip);
+      if (--pending > 0)
+        return;
+    }
+
+    const ips = ex ? null : addresses.map((address) => resolved.get(address));
+    defaultTriggerAsyncIdScope(
+      self[async_id_symbol],
+      doSendBatch,
+      ex, self, ips, list, ports, addresses, callback
+    );
+  };
+
+  for (var i = 0; i < unique.length; i++)
+    state.handle.lookup(unique[i], afterDns.bind(null, unique[i]));
+}
+
+function doSendBatch(ex, self, ips, list, ports, addresses, callback) {
+  const state = self[kStateSymbol];
+
+  if (ex) {
+    if (typeof callback === 'function') {
+      process.nextTick(callback, ex);
+      return;
+    }
+
+    process.nextTick(() => self.emit('error', ex));
+    return;
+  } else if (!state.handle) {
+    return;
+  }
+
+  const req = new SendWrap();
+  req.list = list;  // Keep reference alive.
+  req.address = addresses[0];
+  req.port = ports[0];
+  if (callback) {
+    req.callback = callback;
+    req.oncomplete = afterSend;
+  }
+
+  // Returns how many datagrams are still queued, 0 when the socket took the
+  // whole batch right away.
+  const err = state.handle.sendBatch(req,
+                                     list,
+                                     ports,
+                                     ips,
+                                     list.length,
+                                     !!callback);
+
+  if (err < 0) {
+    if (callback) {
+      // Don't emit as error, same as send().
+      const ex = exceptionWithHostPort(err, 'send', addresses[0], ports[0]);
+      process.nextTick(callback, ex);
+    }
+  } else if (err === 0 && callback) {
+    let sent = 0;
+    for (var i = 0; i < list.length; i++)
+      sent += list[i].length;
+    process.nextTick(callback, null, sent);
+  }
+}
+
 Socket.prototype.close = function(callback) {
   const state = this[kStateSymbol];
   const queue = state.queue;
@@ -677,16 +854,34 @@ function stopReceiving(socket) {
 }
 
 
-function onMessage(nread, handle, buf, rinfo) {
+function onMessage(nread, handle, buf, rinfo, segmentSize) {
   var self = handle[owner_symbol];
   if (nread < 0) {
     return self.emit('error', errnoException(nread, 'recvmsg'));
   }
   rinfo.size = buf.length; // compatibility
+  if (self[kStateSymbol].gro)
+    rinfo.segmentSize = segmentSize || buf.length;
   self.emit('message', buf, rinfo);
 }
 
 
+function onMessageBatch(count, handle, buf, lengths, rinfos) {
+  const self = handle[owner_symbol];
+  let offset = 0;
+  for (var i = 0; i < count; i++) {
+    // A listener may close the socket midway.
+    if (!self[kStateSymbol].handle)
+      return;
+    const length = lengths[i];
+    const rinfo = rinfos[i];
+    rinfo.size = length; // compatibility
+    self.emit('message', buf.slice(offset, offset + length), rinfo);
+    offset += length;
+  }
+}
+
+
 Socket.prototype.ref = function() {
   const handle = this[kStateSymbol].handle;
 
@@ -89,6 +89,8 @@ cluster._getServer = function(obj, options, cb) {
 
     if (handle)
       shared(reply, handle, indexesKey, cb);  // Shared listen socket.
+    else if (reply.reusePort !== undefined)
+      reusePort(reply, options, address, indexesKey, cb);  // SO_REUSEPORT.
     else
       rr(reply, indexesKey, cb);              // Round-robin.
   });
@@ -120,6 +122,33 @@ function shared(message, handle, indexesKey, cb) {
   cb(message.errno, handle);
 }
 
+// SO_REUSEPORT. Each worker binds its own socket to the port that the
+// master picked and the kernel distributes the load across them.
+function reusePort(message, options, address, indexesKey, cb) {
+  if (message.errno)
+    return cb(message.errno, null);
+
+  const { addressType, fd, flags } = options;
+  let handle;
+  if (addressType === 'udp4' || addressType === 'udp6') {
+    const { UV_UDP_REUSEPORT } = internalBinding('udp_wrap').constants;
+    handle = require('internal/dgram')._createSocketHandle(
+      address, message.reusePort, addressType, fd, flags | UV_UDP_REUSEPORT);
+  } else {
+    const { UV_TCP_REUSEPORT } = internalBinding('tcp_wrap').constants;
+    handle = require('net')._createServerHandle(
+      address, message.reusePort, addressType, fd, flags | UV_TCP_REUSEPORT);
+  }
+
+  if (typeof handle === 'number') {
+    send({ act: 'close', key: message.key });
+    indexes.delete(indexesKey);
+    return cb(handle, null);
+  }
+
+  shared(message, handle, indexesKey, cb);
+}
+
 // Round-robin. Master distributes handles across workers.
 function rr(message, indexesKey, cb) {
   if (message.errno)
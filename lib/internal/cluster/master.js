@@ -3,6 +3,7 @@ const assert = require('assert');
 const { fork } = require('child_process');
 const path = require('path');
 const EventEmitter = require('events');
+const ReusePortHandle = require('internal/cluster/reuseport_handle');
 const RoundRobinHandle = require('internal/cluster/round_robin_handle');
 const SharedHandle = require('internal/cluster/shared_handle');
 const Worker = require('internal/cluster/worker');
@@ -13,6 +14,7 @@ const cluster = new EventEmitter();
 const intercom = new EventEmitter();
 const SCHED_NONE = 1;
 const SCHED_RR = 2;
+const SCHED_REUSEPORT = 3;
 const { isLegalPort } = require('internal/net');
 const [ minPort, maxPort ] = [ 1024, 65535 ];
 
@@ -26,6 +28,7 @@ cluster.workers = {};
 cluster.settings = {};
 cluster.SCHED_NONE = SCHED_NONE;  // Leave it to the operating system.
 cluster.SCHED_RR = SCHED_RR;      // Master distributes connections.
+cluster.SCHED_REUSEPORT = SCHED_REUSEPORT;  // Kernel balances SO_REUSEPORT.
 
 var ids = 0;
 var debugPortOffset = 1;
@@ -34,7 +37,8 @@ var initialized = false;
 // XXX(bnoordhuis) Fold cluster.schedulingPolicy into cluster.settings?
 var schedulingPolicy = {
   'none': SCHED_NONE,
-  'rr': SCHED_RR
+  'rr': SCHED_RR,
+  'reuseport': SCHED_REUSEPORT
 }[process.env.NODE_CLUSTER_SCHED_POLICY];
 
 if (schedulingPolicy === undefined) {
@@ -71,7 +75,8 @@ cluster.setupMaster = function(options) {
 
   initialized = true;
   schedulingPolicy = cluster.schedulingPolicy;  // Freeze policy.
-  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR,
+  assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR ||
+         schedulingPolicy === SCHED_REUSEPORT,
          `Bad cluster.schedulingPolicy: ${schedulingPolicy}`);
 
   process.nextTick(setupSettingsNT, settings);
@@ -287,14 +292,20 @@ function queryServer(worker, message) {
         address = message.address;
     }
 
+    const isUDP = message.addressType === 'udp4' ||
+                  message.addressType === 'udp6';
     var constructor = RoundRobinHandle;
     // UDP is exempt from round-robin connection balancing for what should
     // be obvious reasons: it's connectionless. There is nothing to send to
     // the workers except raw datagrams and that's pointless.
-    if (schedulingPolicy !== SCHED_RR ||
-        message.addressType === 'udp4' ||
-        message.addressType === 'udp6') {
+    if (schedulingPolicy === SCHED_NONE || isUDP)
       constructor = SharedHandle;
+    // SO_REUSEPORT only applies to sockets that are bound to a port, not to
+    // UNIX sockets or to file descriptors that were passed in; those are
+    // balanced the same way as without it.
+    if (schedulingPolicy === SCHED_REUSEPORT &&
+        message.port >= 0 && !(message.fd >= 0)) {
+      constructor = ReusePortHandle;
     }
 
     handle = new constructor(key,
@@ -0,0 +1,72 @@
+'use strict';
+const assert = require('assert');
+const dgram = require('internal/dgram');
+const net = require('net');
+const { UV_TCP_REUSEPORT } = internalBinding('tcp_wrap').constants;
+const { UV_UDP_REUSEPORT } = internalBinding('udp_wrap').constants;
+
+module.exports = ReusePortHandle;
+
+// Every worker binds its own socket with SO_REUSEPORT and the kernel spreads
+// connections and datagrams across them. The master only picks the port:
+// it binds a socket of its own that reserves the port for as long as there
+// are workers listening on it, so that the port does not go to someone else
+// between two workers binding it.
+function ReusePortHandle(key, address, port, addressType, fd, flags) {
+  this.key = key;
+  this.workers = [];
+  this.handle = null;
+  this.errno = 0;
+  this.port = port;
+
+  var rval;
+  if (addressType === 'udp4' || addressType === 'udp6') {
+    rval = dgram._createSocketHandle(address, port, addressType, fd,
+                                     flags | UV_UDP_REUSEPORT);
+  } else {
+    rval = net._createServerHandle(address, port, addressType, fd,
+                                   flags | UV_TCP_REUSEPORT);
+  }
+
+  if (typeof rval === 'number') {
+    this.errno = rval;
+    return;
+  }
+
+  const out = {};
+  this.errno = rval.getsockname(out);
+  this.port = out.port;
+
+  // A TCP socket that does not listen takes no part in the load balancing
+  // but a bound UDP socket would receive its share of the datagrams, so the
+  // latter is let go of right away. That leaves a window in which another
+  // process can grab an ephemeral port before the first worker binds it.
+  if (this.errno !== 0 || addressType === 'udp4' || addressType === 'udp6')
+    rval.close();
+  else
+    this.handle = rval;
+}
+
+ReusePortHandle.prototype.add = function(worker, send) {
+  assert(this.workers.indexOf(worker) === -1);
+  this.workers.push(worker);
+  send(this.errno, { reusePort: this.port }, null);
+};
+
+ReusePortHandle.prototype.remove = function(worker) {
+  const index = this.workers.indexOf(worker);
+
+  if (index === -1)
+    return false; // The worker wasn't listening on this port.
+
+  this.workers.splice(index, 1);
+
+  if (this.workers.length !== 0)
+    return false;
+
+  if (this.handle !== null) {
+    this.handle.close();
+    this.handle = null;
+  }
+  return true;
+};
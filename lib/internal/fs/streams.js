@@ -1,14 +1,23 @@
 'use strict';
 
 const {
+  FileHandle,
   FSReqCallback,
   writeBuffers
 } = internalBinding('fs');
+const { StreamPipe } = internalBinding('stream_pipe');
+const { TCP } = internalBinding('tcp_wrap');
+const { Pipe } = internalBinding('pipe_wrap');
 const {
-  ERR_INVALID_ARG_TYPE,
-  ERR_OUT_OF_RANGE
-} = require('internal/errors').codes;
+  errnoException,
+  uvException,
+  codes: {
+    ERR_INVALID_ARG_TYPE,
+    ERR_OUT_OF_RANGE
+  }
+} = require('internal/errors');
 const { validateNumber } = require('internal/validators');
+const { holdStreamPipe } = require('internal/stream_base_commons');
 const fs = require('fs');
 const { Buffer } = require('buffer');
 const {
@@ -19,6 +28,7 @@ const { Readable, Writable } = require('stream');
 const { toPathIfFileURL } = require('internal/url');
 
 const kMinPoolSpace = 128;
+const kFilePipe = Symbol('kFilePipe');
 
 let pool;
 // It can happen that we expect to read a large chunk of data, and reserve
@@ -75,6 +85,7 @@ function ReadStream(path, options) {
   this.pos = undefined;
   this.bytesRead = 0;
   this.closed = false;
+  this[kFilePipe] = null;
 
   if (this.start !== undefined) {
     checkPosition(this.start, 'start');
@@ -127,6 +138,10 @@ ReadStream.prototype.open = function() {
 };
 
 ReadStream.prototype._read = function(n) {
+  // The data is going to a socket natively, see ReadStream#pipe().
+  if (this[kFilePipe] !== null)
+    return;
+
   if (typeof this.fd !== 'number') {
     return this.once('open', function() {
       this._read(n);
@@ -190,7 +205,154 @@ ReadStream.prototype._read = function(n) {
   pool.used += toRead;
 };
 
+// Piping a file into a plain TCP socket or pipe skips the JS layer: the file
+// is handed to a native StreamPipe, which sends it with sendfile() where
+// that is available and with plain reads and writes elsewhere. This is only
+// possible while nothing else consumes the file stream and nothing is
+// queued on the socket, otherwise this falls back to Readable#pipe().
+ReadStream.prototype.pipe = function(dest, options) {
+  const state = this._readableState;
+  const handle = dest !== null && typeof dest === 'object' ?
+    dest._handle : null;
+  if (handle == null ||
+      !(handle instanceof TCP || handle instanceof Pipe) ||
+      dest.connecting || !dest.writable || dest.writableLength > 0 ||
+      this.destroyed || state.flowing !== null || state.length > 0 ||
+      state.pipesCount > 0 || state.decoder !== null || state.reading ||
+      state.ended || this.listenerCount('data') > 0 ||
+      (this.pos === undefined && typeof this.fd === 'number')) {
+    return Readable.prototype.pipe.call(this, dest, options);
+  }
+
+  this[kFilePipe] = {
+    dest,
+    end: !options || options.end !== false,
+    pipe: null,
+    paused: false,
+    unpiped: false
+  };
+  dest.emit('pipe', this);
+
+  if (typeof this.fd !== 'number')
+    this.once('open', startFilePipe);
+  else
+    startFilePipe.call(this);
+  return dest;
+};
+
+function startFilePipe() {
+  const filePipe = this[kFilePipe];
+  if (filePipe === null)
+    return;
+  const { dest } = filePipe;
+  if (this.destroyed || dest.destroyed || !dest._handle) {
+    stopFilePipe(this);
+    return;
+  }
+
+  const offset = this.pos !== undefined ? this.pos : 0;
+  const length = this.end === Infinity ? -1 : this.end - offset + 1;
+  const handle = new FileHandle(this.fd, offset, length);
+  handle.onread = onFilePipeRead;
+
+  const pipe = new StreamPipe(handle._externalStream,
+                              dest._handle._externalStream);
+  pipe.stream = this;
+  pipe.onunpipe = onFilePipeUnpipe;
+  filePipe.pipe = pipe;
+  if (filePipe.paused)
+    pipe.hold();
+  pipe.start();
+}
+
+function stopFilePipe(stream) {
+  const { dest, unpiped } = stream[kFilePipe];
+  stream[kFilePipe] = null;
+  // Allow _read() to be called again.
+  stream._readableState.reading = false;
+  if (!unpiped)
+    dest.emit('unpipe', stream);
+}
+
+// Like for Readable#pipe(), unpiping and pausing stop the data from flowing.
+ReadStream.prototype.unpipe = function(dest) {
+  const filePipe = this[kFilePipe];
+  if (filePipe === null || (dest !== undefined && dest !== filePipe.dest))
+    return Readable.prototype.unpipe.call(this, dest);
+  if (filePipe.unpiped)
+    return this;
+
+  const { pipe } = filePipe;
+  if (pipe === null) {
+    stopFilePipe(this);
+    return this;
+  }
+
+  // Data that a sendfile() in flight sends must be counted before the pipe
+  // is taken down, so that reading from JS goes on at the right position.
+  filePipe.unpiped = true;
+  this._readableState.flowing = false;
+  filePipe.dest.emit('unpipe', this);
+  holdStreamPipe(pipe, () => pipe.unpipe());
+  return this;
+};
+
+ReadStream.prototype.pause = function() {
+  const filePipe = this[kFilePipe];
+  if (filePipe !== null && !filePipe.paused && !filePipe.unpiped) {
+    filePipe.paused = true;
+    if (filePipe.pipe !== null)
+      filePipe.pipe.hold();
+  }
+  return Readable.prototype.pause.call(this);
+};
+
+ReadStream.prototype.resume = function() {
+  const filePipe = this[kFilePipe];
+  if (filePipe !== null && filePipe.paused && !filePipe.unpiped) {
+    filePipe.paused = false;
+    if (filePipe.pipe !== null)
+      filePipe.pipe.release();
+  }
+  return Readable.prototype.resume.call(this);
+};
+
+// EOF and errors are reported by onFilePipeUnpipe().
+function onFilePipeRead() {}
+
+function onFilePipeUnpipe(err, sinkErr, bytes) {
+  const stream = this.stream;
+  const { dest, end, unpiped } = stream[kFilePipe];
+  this.source.releaseFD();
+
+  stream.bytesRead += bytes;
+  if (stream.pos !== undefined)
+    stream.pos += bytes;
+  stopFilePipe(stream);
+
+  if (err < 0) {
+    if (stream.autoClose)
+      stream.destroy();
+    stream.emit('error', uvException({ errno: err, syscall: 'read' }));
+  } else if (sinkErr < 0) {
+    dest.destroy(errnoException(sinkErr, 'write'));
+  } else if (unpiped) {
+    // Go on reading from JS if the stream was resumed in the meantime.
+    if (stream._readableState.flowing)
+      stream.read(0);
+  } else if (!stream.destroyed && !dest.destroyed) {
+    // Finish the file stream as if the data had been read from JS.
+    stream.push(null);
+    stream.read(0);
+    if (end)
+      dest.end();
+  }
+}
+
 ReadStream.prototype._destroy = function(err, cb) {
+  if (this[kFilePipe] !== null && this[kFilePipe].pipe !== null)
+    this[kFilePipe].pipe.unpipe();
+
   if (typeof this.fd !== 'number') {
     this.once('open', closeFsStream.bind(null, this, cb, err));
     return;
@@ -17,6 +17,7 @@ const { owner_symbol } = require('internal/async_hooks').symbols;
 const kMaybeDestroy = Symbol('kMaybeDestroy');
 const kUpdateTimer = Symbol('kUpdateTimer');
 const kAfterAsyncWrite = Symbol('kAfterAsyncWrite');
+const kBufferCb = Symbol('kBufferCb');
 
 function handleWriteReq(req, data, encoding) {
   const { handle } = req;
@@ -141,6 +142,23 @@ function onStreamRead(arrayBuffer) {
 
   if (nread > 0 && !stream.destroyed) {
     const offset = streamBaseState[kArrayBufferOffset];
+
+    // With user-supplied buffers (see `handle.useUserBuffers()`), the data
+    // is already in place and `arrayBuffer` is the index of the buffer that
+    // holds it. The callback returning `false` stops reading.
+    const bufferCb = stream[kBufferCb];
+    if (bufferCb !== undefined) {
+      if (bufferCb.call(stream, arrayBuffer, offset, nread) === false) {
+        handle.reading = false;
+        if (!stream.destroyed) {
+          const err = handle.readStop();
+          if (err)
+            stream.destroy(errnoException(err, 'read'));
+        }
+      }
+      return;
+    }
+
     const buf = new FastBuffer(arrayBuffer, offset, nread);
     if (!stream.push(buf)) {
       handle.reading = false;
@@ -178,12 +196,36 @@ function onStreamRead(arrayBuffer) {
   }
 }
 
+// Holds up a native StreamPipe (see `StreamPipe::Hold()` in
+// src/stream_pipe.cc) and calls `callback` once nothing that the pipe sent is
+// still in flight. The pipe stays held until `pipe.release()` is called.
+function holdStreamPipe(pipe, callback) {
+  if (pipe.hold()) {
+    callback();
+    return;
+  }
+  if (pipe.holdCallbacks == null) {
+    pipe.holdCallbacks = [];
+    pipe.onhold = onStreamPipeHold;
+  }
+  pipe.holdCallbacks.push(callback);
+}
+
+function onStreamPipeHold() {
+  const callbacks = this.holdCallbacks;
+  this.holdCallbacks = null;
+  for (var i = 0; i < callbacks.length; i++)
+    callbacks[i]();
+}
+
 module.exports = {
   createWriteWrap,
+  holdStreamPipe,
   writevGeneric,
   writeGeneric,
   onStreamRead,
   kAfterAsyncWrite,
+  kBufferCb,
   kMaybeDestroy,
   kUpdateTimer,
 };
@@ -1,5 +1,11 @@
 'use strict';
 
+const {
+  startWheelTimer,
+  refreshWheelTimer,
+  stopWheelTimer,
+  popExpiredWheelTimer
+} = internalBinding('timers');
 const {
   getDefaultTriggerAsyncId,
   newAsyncId,
@@ -22,6 +28,7 @@ const { inspect } = require('util');
 const TIMEOUT_MAX = 2 ** 31 - 1;
 
 const kRefed = Symbol('refed');
+const kWheelId = Symbol('wheelId');
 
 module.exports = {
   TIMEOUT_MAX,
@@ -30,9 +37,13 @@ module.exports = {
   trigger_async_id_symbol,
   Timeout,
   kRefed,
+  kWheelId,
   initAsyncResource,
   setUnrefTimeout,
-  validateTimerDuration
+  validateTimerDuration,
+  WheelTimeout,
+  stopWheelTimeout,
+  takeExpiredWheelTimeout
 };
 
 var timers;
@@ -102,6 +113,92 @@ Timeout.prototype.refresh = function() {
   return this;
 };
 
+// A timeout on the native timer wheel, see src/timer_wheel.h. It never keeps
+// the event loop alive, but refreshing it costs the same no matter how many
+// timeouts exist, which is what the idle timeouts of sockets need. Otherwise
+// it behaves like a Timeout created by setUnrefTimeout().
+function WheelTimeout(callback, after) {
+  after *= 1; // coalesce to number or NaN
+  if (!(after >= 1 && after <= TIMEOUT_MAX))
+    after = 1;
+
+  this._idleTimeout = after;
+  this._idleStart = null;
+  // This must be set to null first to avoid function tracking
+  // on the hidden class, revisit in V8 versions after 6.2
+  this._onTimeout = null;
+  this._onTimeout = callback;
+  this._destroyed = false;
+  this[kWheelId] = -1;
+
+  initAsyncResource(this, 'Timeout');
+  startWheelTimeout(this);
+}
+
+// Timeouts on the wheel, indexed by the id the wheel knows them by. Ids are
+// reused so that the wheel's own table stays as small as possible.
+const wheelTimeouts = [];
+const freeWheelIds = [];
+
+function startWheelTimeout(timer) {
+  const id =
+    freeWheelIds.length > 0 ? freeWheelIds.pop() : wheelTimeouts.length;
+  wheelTimeouts[id] = timer;
+  timer[kWheelId] = id;
+  timer._idleStart = startWheelTimer(id, timer._idleTimeout);
+}
+
+function releaseWheelId(timer) {
+  const id = timer[kWheelId];
+  wheelTimeouts[id] = undefined;
+  freeWheelIds.push(id);
+  timer[kWheelId] = -1;
+}
+
+function stopWheelTimeout(timer) {
+  if (timer[kWheelId] === -1)
+    return;
+  stopWheelTimer(timer[kWheelId]);
+  releaseWheelId(timer);
+}
+
+// Returns the next timeout that has expired, or null if there is none.
+function takeExpiredWheelTimeout() {
+  const id = popExpiredWheelTimer();
+  if (id === -1)
+    return null;
+  const timer = wheelTimeouts[id];
+  releaseWheelId(timer);
+  return timer;
+}
+
+WheelTimeout.prototype.refresh = function() {
+  if (this[kWheelId] !== -1) {
+    this._idleStart = refreshWheelTimer(this[kWheelId]);
+  } else if (this._idleTimeout !== -1) {
+    // Like a Timeout, one that has fired already is started again.
+    if (this._destroyed) {
+      this._destroyed = false;
+      initAsyncResource(this, 'Timeout');
+    }
+    startWheelTimeout(this);
+  }
+  return this;
+};
+
+WheelTimeout.prototype.unref = function() {
+  return this;
+};
+
+WheelTimeout.prototype.hasRef = function() {
+  return false;
+};
+
+WheelTimeout.prototype.close = function() {
+  getTimers().clearTimeout(this);
+  return this;
+};
+
 function setUnrefTimeout(callback, after, arg1, arg2, arg3) {
   // Type checking identical to setTimeout()
   if (typeof callback !== 'function') {
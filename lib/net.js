@@ -42,6 +42,7 @@ const {
 const { Buffer } = require('buffer');
 const TTYWrap = internalBinding('tty_wrap');
 const { ShutdownWrap } = internalBinding('stream_wrap');
+const { StreamPipe } = internalBinding('stream_pipe');
 const {
   TCP,
   TCPConnectWrap,
@@ -59,10 +60,12 @@ const {
 } = require('internal/async_hooks');
 const {
   createWriteWrap,
+  holdStreamPipe,
   writevGeneric,
   writeGeneric,
   onStreamRead,
   kAfterAsyncWrite,
+  kBufferCb,
   kUpdateTimer
 } = require('internal/stream_base_commons');
 const {
@@ -82,8 +85,17 @@ const {
   exceptionWithHostPort,
   uvExceptionWithHostPort
 } = require('internal/errors');
-const { validateInt32, validateString } = require('internal/validators');
+const {
+  validateInt32,
+  validateString,
+  validateUint32
+} = require('internal/validators');
+const {
+  isAnyArrayBuffer,
+  isArrayBufferView
+} = require('internal/util/types');
 const kLastWriteQueueSize = Symbol('lastWriteQueueSize');
+const kSocketPipe = Symbol('kSocketPipe');
 
 // Lazy loaded to improve startup performance.
 let cluster;
@@ -91,8 +103,8 @@ let dns;
 
 const {
   kTimeout,
-  setUnrefTimeout,
-  validateTimerDuration
+  validateTimerDuration,
+  WheelTimeout
 } = require('internal/timers');
 
 function noop() {}
@@ -219,12 +231,48 @@ function initSocketHandle(self) {
     self._handle[owner_symbol] = self;
     self._handle.onread = onStreamRead;
     self[async_id_symbol] = getNewAsyncId(self._handle);
+
+    if (self[kBuffers] !== null)
+      self._handle.useUserBuffers(self[kBuffers]);
   }
 }
 
 
+// Turns `options.onread.buffers` into a list of non-empty Uint8Arrays.
+function normalizeReadBuffers(buffers) {
+  if (!Array.isArray(buffers)) {
+    throw new ERR_INVALID_ARG_TYPE('options.onread.buffers', 'Array',
+                                   buffers);
+  }
+  if (buffers.length === 0) {
+    throw new ERR_INVALID_ARG_VALUE('options.onread.buffers', buffers,
+                                    'must not be empty');
+  }
+  return buffers.map((buffer, i) => {
+    if (isAnyArrayBuffer(buffer))
+      buffer = new Uint8Array(buffer);
+    else if (!isArrayBufferView(buffer)) {
+      throw new ERR_INVALID_ARG_TYPE(`options.onread.buffers[${i}]`,
+                                     ['ArrayBuffer', 'TypedArray', 'DataView'],
+                                     buffer);
+    }
+    if (buffer.byteLength === 0) {
+      throw new ERR_INVALID_ARG_VALUE(`options.onread.buffers[${i}]`, buffer,
+                                      'must not be empty');
+    }
+    return buffer;
+  });
+}
+
+
 const kBytesRead = Symbol('kBytesRead');
 const kBytesWritten = Symbol('kBytesWritten');
+const kExclusiveAccept = Symbol('kExclusiveAccept');
+const kFastOpen = Symbol('kFastOpen');
+const kDeferAccept = Symbol('kDeferAccept');
+const kAcceptBudget = Symbol('kAcceptBudget');
+const kAcceptPaused = Symbol('kAcceptPaused');
+const kBuffers = Symbol('kBuffers');
 
 
 function Socket(options) {
@@ -241,12 +289,24 @@ function Socket(options) {
   this._host = null;
   this[kLastWriteQueueSize] = 0;
   this[kTimeout] = null;
+  this[kBuffers] = null;
 
   if (typeof options === 'number')
     options = { fd: options }; // Legacy interface.
   else
     options = { ...options };
 
+  const { onread } = options;
+  if (onread !== null && typeof onread === 'object') {
+    const { buffers, callback } = onread;
+    if (typeof callback !== 'function') {
+      throw new ERR_INVALID_ARG_TYPE('options.onread.callback', 'Function',
+                                     callback);
+    }
+    this[kBuffers] = normalizeReadBuffers(buffers);
+    this[kBufferCb] = callback;
+  }
+
   options.readable = options.readable || false;
   options.writable = options.writable || false;
   const { allowHalfOpen } = options;
@@ -330,6 +390,9 @@ function Socket(options) {
   // Used after `.destroy()`
   this[kBytesRead] = 0;
   this[kBytesWritten] = 0;
+
+  // Set while data is piped natively, see Socket#pipe().
+  this[kSocketPipe] = null;
 }
 util.inherits(Socket, stream.Duplex);
 
@@ -417,7 +480,7 @@ Socket.prototype.setTimeout = function(msecs, callback) {
       this.removeListener('timeout', callback);
     }
   } else {
-    this[kTimeout] = setUnrefTimeout(this._onTimeout.bind(this), msecs);
+    this[kTimeout] = new WheelTimeout(this._onTimeout.bind(this), msecs);
 
     if (callback) {
       this.once('timeout', callback);
@@ -473,6 +536,28 @@ Socket.prototype.setKeepAlive = function(setting, msecs) {
 };
 
 
+// Below this size, copying the data into the socket is cheaper than pinning
+// its pages and waiting for the kernel to release them.
+const kZeroCopyMinSize = 16 * 1024;
+
+Socket.prototype.setZeroCopy = function(enable, minSize) {
+  if (minSize === undefined)
+    minSize = kZeroCopyMinSize;
+  validateUint32(minSize, 'minSize');
+
+  if (!this._handle || this.connecting) {
+    this.once('connect', () => this.setZeroCopy(enable, minSize));
+    return this;
+  }
+
+  // Platforms and kernels without zero-copy sends keep copying.
+  if (this._handle.setZeroCopy)
+    this._handle.setZeroCopy(enable === undefined ? true : !!enable, minSize);
+
+  return this;
+};
+
+
 Socket.prototype.address = function() {
   return this._getsockname();
 };
@@ -524,6 +609,15 @@ Object.defineProperty(Socket.prototype, kUpdateTimer, {
 });
 
 
+function tryReadStart(socket) {
+  // Not already reading, start the flow
+  debug('Socket._read readStart');
+  socket._handle.reading = true;
+  const err = socket._handle.readStart();
+  if (err)
+    socket.destroy(errnoException(err, 'read'));
+}
+
 // Just call handle.readStart until we have enough in the buffer
 Socket.prototype._read = function(n) {
   debug('_read');
@@ -532,16 +626,172 @@ Socket.prototype._read = function(n) {
     debug('_read wait for connection');
     this.once('connect', () => this._read(n));
   } else if (!this._handle.reading) {
-    // not already reading, start the flow
-    debug('Socket._read readStart');
-    this._handle.reading = true;
-    var err = this._handle.readStart();
-    if (err)
-      this.destroy(errnoException(err, 'read'));
+    tryReadStart(this);
   }
 };
 
 
+// Data read into user-supplied buffers never goes through the readable
+// side's queue, which therefore never asks for more. Reading is started
+// and stopped directly instead.
+Socket.prototype.pause = function() {
+  const socketPipe = this[kSocketPipe];
+  if (socketPipe !== null && !socketPipe.paused && !socketPipe.unpiped) {
+    socketPipe.paused = true;
+    if (socketPipe.pipe !== null)
+      socketPipe.pipe.hold();
+  }
+  if (this[kBuffers] !== null && !this.connecting && this._handle &&
+      this._handle.reading) {
+    this._handle.reading = false;
+    if (!this.destroyed) {
+      const err = this._handle.readStop();
+      if (err)
+        this.destroy(errnoException(err, 'read'));
+    }
+  }
+  return stream.Duplex.prototype.pause.call(this);
+};
+
+
+Socket.prototype.resume = function() {
+  const socketPipe = this[kSocketPipe];
+  if (socketPipe !== null && socketPipe.paused && !socketPipe.unpiped) {
+    socketPipe.paused = false;
+    if (socketPipe.pipe !== null)
+      socketPipe.pipe.release();
+  }
+  if (this[kBuffers] !== null && !this.connecting && this._handle &&
+      !this._handle.reading) {
+    tryReadStart(this);
+  }
+  return stream.Duplex.prototype.resume.call(this);
+};
+
+
+function isPipeableHandle(handle) {
+  return handle instanceof TCP || handle instanceof Pipe;
+}
+
+// With `{ native: true }`, piping a socket into another plain TCP socket or
+// pipe moves the data with a native StreamPipe, which uses splice() on Linux
+// so that it never leaves the kernel. The source's 'end' and errors are
+// reported as usual, but no 'data' events are emitted. Without the option, or
+// while anything else consumes the source, this is the same as
+// Readable#pipe().
+Socket.prototype.pipe = function(dest, options) {
+  const state = this._readableState;
+  if (!options || options.native !== true ||
+      !isPipeableHandle(this._handle) ||
+      dest === null || typeof dest !== 'object' ||
+      !isPipeableHandle(dest._handle) || dest._isStdio ||
+      this.destroyed || this[kSocketPipe] !== null ||
+      state.flowing !== null || state.length > 0 || state.pipesCount > 0 ||
+      state.decoder !== null || state.ended ||
+      this.listenerCount('data') > 0 ||
+      !dest.writable || dest.writableLength > 0) {
+    return stream.Duplex.prototype.pipe.call(this, dest, options);
+  }
+
+  const handle = this._handle;
+  this[kSocketPipe] = {
+    dest,
+    end: !options || options.end !== false,
+    wasReading: handle.reading,
+    pipe: null,
+    paused: false,
+    unpiped: false
+  };
+  // Keep _read() from starting to read into JS while the pipe is set up.
+  handle.reading = true;
+  handle.readStop();
+  dest.emit('pipe', this);
+  startSocketPipe.call(this);
+  return dest;
+};
+
+function startSocketPipe() {
+  const socketPipe = this[kSocketPipe];
+  if (socketPipe === null || socketPipe.pipe !== null)
+    return;
+  const { dest } = socketPipe;
+  if (this.connecting) {
+    this.once('connect', startSocketPipe);
+    return;
+  }
+  if (dest.connecting) {
+    dest.once('connect', startSocketPipe.bind(this));
+    return;
+  }
+  if (!this._handle || !dest._handle || this.destroyed || dest.destroyed) {
+    stopSocketPipe(this);
+    return;
+  }
+
+  const pipe = new StreamPipe(this._handle._externalStream,
+                              dest._handle._externalStream);
+  pipe.stream = this;
+  pipe.onunpipe = onSocketPipeUnpipe;
+  socketPipe.pipe = pipe;
+  if (socketPipe.paused)
+    pipe.hold();
+  pipe.start();
+}
+
+function stopSocketPipe(socket) {
+  const { dest, wasReading, unpiped } = socket[kSocketPipe];
+  socket[kSocketPipe] = null;
+  if (!unpiped)
+    dest.emit('unpipe', socket);
+
+  // Go back to reading into JS if the source is still open.
+  const handle = socket._handle;
+  if (handle && !socket._readableState.ended) {
+    handle.reading = wasReading;
+    if (wasReading) {
+      const err = handle.readStart();
+      if (err)
+        socket.destroy(errnoException(err, 'read'));
+    }
+  }
+}
+
+// EOF and read errors reach the source through its own onread callback.
+function onSocketPipeUnpipe(err, sinkErr) {
+  const socket = this.stream;
+  const { dest, end, unpiped } = socket[kSocketPipe];
+  stopSocketPipe(socket);
+
+  if (sinkErr < 0)
+    dest.destroy(errnoException(sinkErr, 'write'));
+  else if (unpiped && socket._readableState.flowing)
+    socket.read(0);
+  else if (err === 0 && socket._readableState.ended && end && !unpiped &&
+           !dest.destroyed)
+    dest.end();
+}
+
+Socket.prototype.unpipe = function(dest) {
+  const socketPipe = this[kSocketPipe];
+  if (socketPipe === null || (dest !== undefined && dest !== socketPipe.dest))
+    return stream.Duplex.prototype.unpipe.call(this, dest);
+  if (socketPipe.unpiped)
+    return this;
+
+  socketPipe.unpiped = true;
+  this._readableState.flowing = false;
+  socketPipe.dest.emit('unpipe', this);
+  const { pipe } = socketPipe;
+  if (pipe === null) {
+    stopSocketPipe(this);
+    return this;
+  }
+  // Data that has been read but not written yet is sent before the pipe is
+  // taken down.
+  holdStreamPipe(pipe, () => pipe.unpipe());
+  return this;
+};
+
 Socket.prototype.end = function(data, encoding, callback) {
   stream.Duplex.prototype.end.call(this, data, encoding, callback);
   DTRACE_NET_STREAM_END(this);
@@ -709,16 +959,44 @@ Socket.prototype._writeGeneric = function(writev, data, encoding, cb) {
     return false;
   }
 
-  this._unrefTimer();
+  // A native pipe into this socket may be sending data that bypasses the
+  // write queue. Hold it up, and wait until that data has been written.
+  const pipe = this._handle.pipeSource;
+  if (pipe) {
+    this._pendingData = data;
+    this._pendingEncoding = encoding;
+    holdStreamPipe(pipe, () => {
+      this._pendingData = null;
+      this._pendingEncoding = '';
+      writeHeldGeneric(this, pipe, writev, data, encoding, cb);
+    });
+    return;
+  }
+  writeHeldGeneric(this, null, writev, data, encoding, cb);
+};
+
+function writeHeldGeneric(socket, pipe, writev, data, encoding, cb) {
+  if (!socket._handle) {
+    if (pipe)
+      pipe.release();
+    socket.destroy(new ERR_SOCKET_CLOSED(), cb);
+    return;
+  }
+
+  socket._unrefTimer();
 
-  var req = createWriteWrap(this._handle);
+  var req = createWriteWrap(socket._handle);
   if (writev)
-    writevGeneric(this, req, data, cb);
+    writevGeneric(socket, req, data, cb);
   else
-    writeGeneric(this, req, data, encoding, cb);
+    writeGeneric(socket, req, data, encoding, cb);
   if (req.async)
-    this[kLastWriteQueueSize] = req.bytes;
-};
+    socket[kLastWriteQueueSize] = req.bytes;
+
+  // The pipe goes on once the write queue is empty.
+  if (pipe)
+    pipe.release();
+}
 
 
 Socket.prototype._writev = function(chunks, cb) {
@@ -893,6 +1171,14 @@ Socket.prototype.connect = function(...args) {
     initSocketHandle(this);
   }
 
+  // Only takes effect when the kernel has a Fast Open cookie for the server,
+  // the first write then goes out with the SYN. Not supported everywhere,
+  // treat it as a hint.
+  if (!pipe && options.fastOpen === true &&
+      typeof this._handle.setFastOpenConnect === 'function') {
+    this._handle.setFastOpenConnect(true);
+  }
+
   if (cb !== null) {
     this.once('connect', cb);
   }
@@ -1129,6 +1415,11 @@ function Server(options, connectionListener) {
   });
 
   this[async_id_symbol] = -1;
+  this[kExclusiveAccept] = false;
+  this[kFastOpen] = 0;
+  this[kDeferAccept] = 0;
+  this[kAcceptBudget] = 0;
+  this[kAcceptPaused] = false;
   this._handle = null;
   this._usingWorkers = false;
   this._workers = [];
@@ -1187,12 +1478,13 @@ function createServerHandle(address, port, addressType, fd, flags) {
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle('0.0.0.0', port);
+        return createServerHandle('0.0.0.0', port, undefined, undefined,
+                                  flags);
       }
     } else if (addressType === 6) {
       err = handle.bind6(address, port, flags);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, flags);
     }
   }
 
@@ -1245,6 +1537,32 @@ function setupListenHandle(address, port, addressType, backlog, fd, flags) {
   this._handle.onconnection = onconnection;
   this._handle[owner_symbol] = this;
 
+  // Only wake up one of the processes that wait on a shared listen socket.
+  // Handles of round-robin cluster workers are not real sockets and the
+  // master distributes their connections anyway.
+  if (this[kExclusiveAccept] &&
+      typeof this._handle.setExclusiveAccept === 'function') {
+    // Not supported everywhere, treat it as a hint.
+    this._handle.setExclusiveAccept(true);
+  }
+
+  // Both have to be set before the socket starts listening. Hints as well.
+  if (typeof this._handle.setFastOpen === 'function') {
+    if (this[kFastOpen] > 0)
+      this._handle.setFastOpen(this[kFastOpen]);
+    if (this[kDeferAccept] > 0)
+      this._handle.setDeferAccept(this[kDeferAccept]);
+  }
+
+  // Not available on the handles of round-robin cluster workers, the master
+  // accepts their connections.
+  if (typeof this._handle.setAcceptBudget === 'function') {
+    if (this[kAcceptBudget] > 0)
+      this._handle.setAcceptBudget(this[kAcceptBudget]);
+    if (this[kAcceptPaused])
+      this._handle.pauseAccepting();
+  }
+
   // Use a backlog of 512 entries. We pass 511 to the listen() call because
   // the kernel does: backlogsize = roundup_pow_of_two(backlogsize + 1);
   // which will thus give us a backlog of 512 entries.
@@ -1348,6 +1666,16 @@ Server.prototype.listen = function(...args) {
     toNumber(args.length > 1 && args[1]) ||
     toNumber(args.length > 2 && args[2]);  // (port, host, backlog)
 
+  this[kExclusiveAccept] = options.exclusiveAccept === true;
+  if (options.fastOpen !== undefined)
+    validateUint32(options.fastOpen, 'options.fastOpen');
+  if (options.deferAccept !== undefined)
+    validateUint32(options.deferAccept, 'options.deferAccept');
+  this[kFastOpen] = options.fastOpen || 0;
+  this[kDeferAccept] = options.deferAccept || 0;
+  if (options.acceptBudget !== undefined)
+    validateUint32(options.acceptBudget, 'options.acceptBudget');
+  this[kAcceptBudget] = options.acceptBudget || 0;
   options = options._handle || options.handle || options;
   const flags = getFlags(options.ipv6Only);
   // (handle[, backlog][, cb]) where handle is an object with a handle
@@ -1538,6 +1866,35 @@ Server.prototype.getConnections = function(cb) {
 };
 
 
+Server.prototype.pauseAccepting = function() {
+  this[kAcceptPaused] = true;
+
+  if (this._handle && typeof this._handle.pauseAccepting === 'function')
+    this._handle.pauseAccepting();
+
+  return this;
+};
+
+
+Server.prototype.resumeAccepting = function() {
+  this[kAcceptPaused] = false;
+
+  if (this._handle && typeof this._handle.resumeAccepting === 'function')
+    this._handle.resumeAccepting();
+
+  return this;
+};
+
+
+Server.prototype.getAcceptBacklog = function() {
+  if (!this._handle || typeof this._handle.getAcceptBacklog !== 'function')
+    return undefined;
+
+  const count = this._handle.getAcceptBacklog();
+  return count >= 0 ? count : undefined;
+};
+
+
 Server.prototype.close = function(cb) {
   if (typeof cb === 'function') {
     if (!this._handle) {
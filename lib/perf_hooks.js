@@ -6,12 +6,19 @@ const {
   clearMark: _clearMark,
   measure: _measure,
   milestones,
+  loopIdleTime,
+  loopMetrics,
+  loopPhases,
+  refreshLoopMetrics,
+  getThreadPoolMetrics,
+  resetThreadPoolMetrics,
   observerCounts,
   setupObservers,
   timeOrigin,
   timeOriginTimestamp,
   timerify,
-  constants
+  constants,
+  ELDHistogram: _ELDHistogram
 } = internalBinding('performance');
 
 const {
@@ -46,6 +53,8 @@ const kGetEntries = Symbol('get-entries');
 const kIndex = Symbol('index');
 const kMarks = Symbol('marks');
 const kCount = Symbol('count');
+const kHandle = Symbol('handle');
+const kMap = Symbol('map');
 
 const observers = {};
 const observerableTypes = [
@@ -182,6 +191,10 @@ class PerformanceNodeTiming {
     return getMilestoneTimestamp(NODE_PERFORMANCE_MILESTONE_BOOTSTRAP_COMPLETE);
   }
 
+  get idleTime() {
+    return loopIdleTime();
+  }
+
   [kInspect]() {
     return {
       name: 'node',
@@ -194,6 +207,7 @@ class PerformanceNodeTiming {
       environment: this.environment,
       loopStart: this.loopStart,
       loopExit: this.loopExit,
+      idleTime: this.idleTime,
       thirdPartyMainStart: this.thirdPartyMainStart,
       thirdPartyMainEnd: this.thirdPartyMainEnd,
       clusterSetupStart: this.clusterSetupStart,
@@ -397,6 +411,38 @@ class Performance {
     }
   }
 
+  eventLoopUtilization(previous) {
+    if (previous !== undefined &&
+        (previous === null || typeof previous !== 'object')) {
+      const errors = lazyErrors();
+      throw new errors.ERR_INVALID_ARG_TYPE('previous', 'Object', previous);
+    }
+    const loopStart = milestones[NODE_PERFORMANCE_MILESTONE_LOOP_START];
+    if (loopStart === -1)
+      return { idle: 0, active: 0, utilization: 0 };
+
+    let idle = loopIdleTime();
+    let active = now() - loopStart / 1e6 - idle;
+    if (previous !== undefined) {
+      idle -= previous.idle;
+      active -= previous.active;
+    }
+    const total = idle + active;
+    return {
+      idle,
+      active,
+      utilization: total > 0 ? active / total : 0
+    };
+  }
+
+  eventLoopPhases() {
+    refreshLoopMetrics();
+    const phases = { iterations: loopMetrics[0] };
+    for (var n = 0; n < loopPhases.length; n++)
+      phases[loopPhases[n]] = loopMetrics[n + 1];
+    return phases;
+  }
+
   timerify(fn) {
     if (typeof fn !== 'function') {
       const errors = lazyErrors();
@@ -537,9 +583,90 @@ function sortedInsert(list, entry) {
   list.splice(location, 0, entry);
 }
 
+class ELDHistogram {
+  constructor(handle) {
+    this[kHandle] = handle;
+    this[kMap] = new Map();
+  }
+
+  reset() { this[kHandle].reset(); }
+  enable() { return this[kHandle].enable(); }
+  disable() { return this[kHandle].disable(); }
+
+  get exceeds() { return this[kHandle].exceeds(); }
+  get min() { return this[kHandle].min(); }
+  get max() { return this[kHandle].max(); }
+  get mean() { return this[kHandle].mean(); }
+  get stddev() { return this[kHandle].stddev(); }
+  percentile(percentile) {
+    if (typeof percentile !== 'number') {
+      const errors = lazyErrors();
+      throw new errors.ERR_INVALID_ARG_TYPE('percentile', 'number', percentile);
+    }
+    if (percentile <= 0 || percentile > 100) {
+      const errors = lazyErrors();
+      throw new errors.ERR_INVALID_ARG_VALUE.RangeError('percentile',
+                                                        percentile);
+    }
+    return this[kHandle].percentile(percentile);
+  }
+  get percentiles() {
+    this[kMap].clear();
+    this[kHandle].percentiles(this[kMap]);
+    return this[kMap];
+  }
+
+  [kInspect]() {
+    return {
+      min: this.min,
+      max: this.max,
+      mean: this.mean,
+      stddev: this.stddev,
+      percentiles: this.percentiles,
+      exceeds: this.exceeds
+    };
+  }
+}
+
+function monitorEventLoopDelay(options = {}) {
+  const errors = lazyErrors();
+  if (typeof options !== 'object' || options === null) {
+    throw new errors.ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  const { resolution = 10 } = options;
+  if (typeof resolution !== 'number') {
+    throw new errors.ERR_INVALID_ARG_TYPE('options.resolution',
+                                          'number', resolution);
+  }
+  if (resolution <= 0 || !Number.isSafeInteger(resolution) ||
+      resolution > 2 ** 31 - 1) {
+    throw new errors.ERR_INVALID_OPT_VALUE.RangeError('resolution',
+                                                      resolution);
+  }
+  return new ELDHistogram(new _ELDHistogram(resolution));
+}
+
+function threadpoolMetrics(options = {}) {
+  if (typeof options !== 'object' || options === null) {
+    const errors = lazyErrors();
+    throw new errors.ERR_INVALID_ARG_TYPE('options', 'Object', options);
+  }
+  const { reset = false } = options;
+  if (typeof reset !== 'boolean') {
+    const errors = lazyErrors();
+    throw new errors.ERR_INVALID_ARG_TYPE('options.reset', 'boolean', reset);
+  }
+  const metrics = getThreadPoolMetrics();
+  if (reset)
+    resetThreadPoolMetrics();
+  return metrics;
+}
+
 module.exports = {
   performance,
-  PerformanceObserver
+  PerformanceObserver,
+  monitorEventLoopDelay,
+  threadpoolMetrics
 };
 
 Object.defineProperty(module.exports, 'constants', {
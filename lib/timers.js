@@ -36,8 +36,12 @@ const {
   trigger_async_id_symbol,
   Timeout,
   kRefed,
+  kWheelId,
   initAsyncResource,
-  validateTimerDuration
+  validateTimerDuration,
+  WheelTimeout,
+  stopWheelTimeout,
+  takeExpiredWheelTimeout
 } = require('internal/timers');
 const internalUtil = require('internal/util');
 const util = require('util');
@@ -57,8 +61,8 @@ const kRefCount = 1;
 const kHasOutstanding = 2;
 
 // Call into C++ to assign callbacks that are responsible for processing
-// Immediates and TimerLists.
-setupTimers(processImmediate, processTimers);
+// Immediates, TimerLists and timeouts on the native timer wheel.
+setupTimers(processImmediate, processTimers, processWheelTimers);
 
 // HOW and WHY the timers implementation works the way it does.
 //
@@ -360,6 +364,37 @@ function listOnTimeout(list, now) {
 }
 
 
+// Called from C++ when timeouts on the native timer wheel have expired. It
+// takes them one at a time, so that if one of them throws C++ can call us
+// again to run the rest.
+function processWheelTimers() {
+  let timer;
+  let ranAtLeastOneTimer = false;
+  while ((timer = takeExpiredWheelTimeout()) !== null) {
+    if (ranAtLeastOneTimer)
+      runNextTicks();
+    else
+      ranAtLeastOneTimer = true;
+
+    const asyncId = timer[async_id_symbol];
+    emitBefore(asyncId, timer[trigger_async_id_symbol]);
+
+    try {
+      timer._onTimeout();
+    } finally {
+      // Unless the callback refreshed it, the timeout is done.
+      if (timer[kWheelId] === -1 &&
+          destroyHooksExist() &&
+          !timer._destroyed) {
+        emitDestroy(asyncId);
+        timer._destroyed = true;
+      }
+    }
+
+    emitAfter(asyncId);
+  }
+}
+
 // Remove a timer. Cancels the timeout and resets the relevant timer properties.
 function unenroll(item) {
   // Fewer checks may be possible, but these cover everything.
@@ -370,6 +405,12 @@ function unenroll(item) {
     item._destroyed = true;
   }
 
+  if (item instanceof WheelTimeout) {
+    stopWheelTimeout(item);
+    item._idleTimeout = -1;
+    return;
+  }
+
   L.remove(item);
 
   // We only delete refed lists because unrefed ones are incredibly likely
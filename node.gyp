@@ -91,6 +91,7 @@
       'lib/internal/child_process.js',
       'lib/internal/cluster/child.js',
       'lib/internal/cluster/master.js',
+      'lib/internal/cluster/reuseport_handle.js',
       'lib/internal/cluster/round_robin_handle.js',
       'lib/internal/cluster/shared_handle.js',
       'lib/internal/cluster/utils.js',
@@ -390,6 +391,7 @@
         'src/node_zlib.cc',
         'src/pipe_wrap.cc',
         'src/process_wrap.cc',
+        'src/read_buffer_pool.cc',
         'src/sharedarraybuffer_metadata.cc',
         'src/signal_wrap.cc',
         'src/spawn_sync.cc',
@@ -399,6 +401,7 @@
         'src/string_bytes.cc',
         'src/string_decoder.cc',
         'src/tcp_wrap.cc',
+        'src/timer_wheel.cc',
         'src/timers.cc',
         'src/tracing/agent.cc',
         'src/tracing/node_trace_buffer.cc',
@@ -422,6 +425,8 @@
         'src/env.h',
         'src/env-inl.h',
         'src/handle_wrap.h',
+        'src/histogram.h',
+        'src/histogram-inl.h',
         'src/http_parser_adaptor.h',
         'src/js_stream.h',
         'src/memory_tracker.h',
@@ -463,6 +468,7 @@
         'src/node_watchdog.h',
         'src/node_worker.h',
         'src/pipe_wrap.h',
+        'src/read_buffer_pool.h',
         'src/req_wrap.h',
         'src/req_wrap-inl.h',
         'src/sharedarraybuffer_metadata.h',
@@ -476,6 +482,7 @@
         'src/string_decoder-inl.h',
         'src/string_search.h',
         'src/tcp_wrap.h',
+        'src/timer_wheel.h',
         'src/tracing/agent.h',
         'src/tracing/node_trace_buffer.h',
         'src/tracing/node_trace_writer.h',
@@ -929,7 +936,9 @@
         'test/cctest/test_base64.cc',
         'test/cctest/test_node_postmortem_metadata.cc',
         'test/cctest/test_environment.cc',
+        'test/cctest/test_histogram.cc',
         'test/cctest/test_platform.cc',
+        'test/cctest/test_timer_wheel.cc',
         'test/cctest/test_traced_value.cc',
         'test/cctest/test_util.cc',
         'test/cctest/test_url.cc'
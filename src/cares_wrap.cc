@@ -1818,6 +1818,8 @@ void AfterGetAddrInfo(uv_getaddrinfo_t* req, int status, struct addrinfo* res) {
   std::unique_ptr<GetAddrInfoReqWrap> req_wrap {
       static_cast<GetAddrInfoReqWrap*>(req->data)};
   Environment* env = req_wrap->env();
+  performance::RecordThreadPoolWork(
+      env, "getaddrinfo", reinterpret_cast<uv_req_t*>(req));
 
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
@@ -1888,6 +1890,8 @@ void AfterGetNameInfo(uv_getnameinfo_t* req,
   std::unique_ptr<GetNameInfoReqWrap> req_wrap {
       static_cast<GetNameInfoReqWrap*>(req->data)};
   Environment* env = req_wrap->env();
+  performance::RecordThreadPoolWork(
+      env, "getnameinfo", reinterpret_cast<uv_req_t*>(req));
 
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
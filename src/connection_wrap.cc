@@ -13,10 +13,12 @@ namespace node {
 
 using v8::Boolean;
 using v8::Context;
+using v8::FunctionCallbackInfo;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Local;
 using v8::Object;
+using v8::Uint32;
 using v8::Value;
 
 
@@ -37,20 +39,45 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
   CHECK_NOT_NULL(wrap_data);
   CHECK_EQ(&wrap_data->handle_, reinterpret_cast<UVType*>(handle));
 
-  Environment* env = wrap_data->env();
-  HandleScope handle_scope(env->isolate());
-  Context::Scope context_scope(env->context());
-
   // We should not be getting this callback if someone has already called
   // uv_close() on the handle.
   CHECK_EQ(wrap_data->persistent().IsEmpty(), false);
 
+  if (status == 0 && !wrap_data->ShouldAccept())
+    return;
+
+  wrap_data->Accept(status);
+}
+
+
+template <typename WrapType, typename UVType>
+bool ConnectionWrap<WrapType, UVType>::ShouldAccept() {
+  if (!accept_paused_ &&
+      (accept_budget_ == 0 || accepted_this_tick_ < accept_budget_)) {
+    if (accept_budget_ != 0 && accepted_this_tick_++ == 0)
+      ScheduleAcceptTick();
+    return true;
+  }
+
+  // Not calling uv_accept() makes libuv stop polling the listen socket, the
+  // connections behind this one stay in the kernel's backlog.
+  accept_pending_ = true;
+  return false;
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::Accept(int status) {
+  Environment* env = this->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
   Local<Value> client_handle;
 
   if (status == 0) {
     // Instantiate the client javascript object and handle.
     Local<Object> client_obj = WrapType::Instantiate(env,
-                                                     wrap_data,
+                                                     this,
                                                      WrapType::SOCKET);
 
     // Unwrap the client javascript object.
@@ -60,7 +87,7 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
     // uv_accept can fail if the new connection has already been closed, in
     // which case an EAGAIN (resource temporarily unavailable) will be
     // returned.
-    if (uv_accept(handle, client))
+    if (uv_accept(stream(), client))
       return;
 
     // Successful accept. Call the onconnection callback in JavaScript land.
@@ -70,7 +97,65 @@ void ConnectionWrap<WrapType, UVType>::OnConnection(uv_stream_t* handle,
   }
 
   Local<Value> argv[] = { Integer::New(env->isolate(), status), client_handle };
-  wrap_data->MakeCallback(env->onconnection_string(), arraysize(argv), argv);
+  MakeCallback(env->onconnection_string(), arraysize(argv), argv);
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::ScheduleAcceptTick() {
+  if (accept_tick_scheduled_)
+    return;
+  accept_tick_scheduled_ = true;
+
+  // Runs after the poll phase of the current iteration, so that timers and
+  // other I/O get their turn before the next batch of connections.
+  HandleScope handle_scope(env()->isolate());
+  env()->SetImmediate([](Environment* env, void* data) {
+    ConnectionWrap* wrap = static_cast<ConnectionWrap*>(data);
+    wrap->accept_tick_scheduled_ = false;
+    wrap->accepted_this_tick_ = 0;
+
+    if (wrap->IsHandleClosing() ||
+        wrap->accept_paused_ ||
+        !wrap->accept_pending_) {
+      return;
+    }
+
+    wrap->accept_pending_ = false;
+    if (wrap->ShouldAccept())
+      wrap->Accept(0);
+  }, static_cast<void*>(this), object());
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::PauseAccepting(
+    const FunctionCallbackInfo<Value>& args) {
+  WrapType* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  wrap->accept_paused_ = true;
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::ResumeAccepting(
+    const FunctionCallbackInfo<Value>& args) {
+  WrapType* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  wrap->accept_paused_ = false;
+  // Not from here, that would emit 'connection' from inside the call.
+  if (wrap->accept_pending_)
+    wrap->ScheduleAcceptTick();
+}
+
+
+template <typename WrapType, typename UVType>
+void ConnectionWrap<WrapType, UVType>::SetAcceptBudget(
+    const FunctionCallbackInfo<Value>& args) {
+  WrapType* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK(args[0]->IsUint32());
+  wrap->accept_budget_ = args[0].As<Uint32>()->Value();
 }
 
 
@@ -133,5 +218,23 @@ template void ConnectionWrap<PipeWrap, uv_pipe_t>::AfterConnect(
 template void ConnectionWrap<TCPWrap, uv_tcp_t>::AfterConnect(
     uv_connect_t* handle, int status);
 
+template void ConnectionWrap<PipeWrap, uv_pipe_t>::PauseAccepting(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<TCPWrap, uv_tcp_t>::PauseAccepting(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<PipeWrap, uv_pipe_t>::ResumeAccepting(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<TCPWrap, uv_tcp_t>::ResumeAccepting(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<PipeWrap, uv_pipe_t>::SetAcceptBudget(
+    const FunctionCallbackInfo<Value>& args);
+
+template void ConnectionWrap<TCPWrap, uv_tcp_t>::SetAcceptBudget(
+    const FunctionCallbackInfo<Value>& args);
+
 
 }  // namespace node
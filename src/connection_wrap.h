@@ -15,12 +15,33 @@ class ConnectionWrap : public LibuvStreamWrap {
   static void OnConnection(uv_stream_t* handle, int status);
   static void AfterConnect(uv_connect_t* req, int status);
 
+  // Stop accepting connections until ResumeAccepting() is called, they are
+  // left waiting in the kernel's backlog meanwhile.
+  static void PauseAccepting(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void ResumeAccepting(const v8::FunctionCallbackInfo<v8::Value>& args);
+  // Accept at most this many connections per event loop iteration, 0 for no
+  // limit, so that a flood of connections does not starve timers and I/O.
+  static void SetAcceptBudget(const v8::FunctionCallbackInfo<v8::Value>& args);
+
  protected:
   ConnectionWrap(Environment* env,
                  v8::Local<v8::Object> object,
                  ProviderType provider);
 
   UVType handle_;
+
+ private:
+  bool ShouldAccept();
+  void Accept(int status);
+  void ScheduleAcceptTick();
+
+  uint32_t accept_budget_ = 0;
+  uint32_t accepted_this_tick_ = 0;
+  bool accept_paused_ = false;
+  // libuv handed us a connection that was not accepted yet. It does not
+  // look for more before uv_accept() is called.
+  bool accept_pending_ = false;
+  bool accept_tick_scheduled_ = false;
 };
 
 }  // namespace node
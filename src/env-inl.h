@@ -338,6 +338,22 @@ inline uv_timer_t* Environment::timer_handle() {
   return &timer_handle_;
 }
 
+inline Environment* Environment::from_timer_wheel_handle(uv_timer_t* handle) {
+  return ContainerOf(&Environment::timer_wheel_handle_, handle);
+}
+
+inline uv_timer_t* Environment::timer_wheel_handle() {
+  return &timer_wheel_handle_;
+}
+
+inline TimerWheel* Environment::timer_wheel() {
+  return &timer_wheel_;
+}
+
+inline ReadBufferPool* Environment::read_buffer_pool() {
+  return &read_buffer_pool_;
+}
+
 inline Environment* Environment::from_immediate_check_handle(
     uv_check_t* handle) {
   return ContainerOf(&Environment::immediate_check_handle_, handle);
@@ -544,6 +560,39 @@ inline void Environment::set_http_parser_buffer_in_use(bool in_use) {
   http_parser_buffer_in_use_ = in_use;
 }
 
+inline std::vector<v8::Global<v8::String>>*
+Environment::http_header_names() {
+  return &http_header_names_;
+}
+
+inline AliasedBuffer<uint32_t, v8::Uint32Array>*
+Environment::http_parser_batch_state() const {
+  return http_parser_batch_state_.get();
+}
+
+inline void Environment::set_http_parser_batch_state(
+    std::unique_ptr<AliasedBuffer<uint32_t, v8::Uint32Array>> state) {
+  CHECK(!http_parser_batch_state_);  // Should be set only once.
+  http_parser_batch_state_ = std::move(state);
+}
+
+inline char* Environment::udp_recv_buffer() const {
+  return udp_recv_buffer_;
+}
+
+inline void Environment::set_udp_recv_buffer(char* buffer) {
+  CHECK_NULL(udp_recv_buffer_);  // Should be set only once.
+  udp_recv_buffer_ = buffer;
+}
+
+inline bool Environment::udp_recv_buffer_in_use() const {
+  return udp_recv_buffer_in_use_;
+}
+
+inline void Environment::set_udp_recv_buffer_in_use(bool in_use) {
+  udp_recv_buffer_in_use_ = in_use;
+}
+
 inline http2::Http2State* Environment::http2_state() const {
   return http2_state_.get();
 }
@@ -1,11 +1,15 @@
 #include "async_wrap.h"
 #include "node_buffer.h"
 #include "node_context_data.h"
+#if HAVE_OPENSSL
+#include "node_crypto_bio.h"
+#endif
 #include "node_errors.h"
 #include "node_file.h"
 #include "node_internals.h"
 #include "node_native_module.h"
 #include "node_options-inl.h"
+#include "node_perf.h"
 #include "node_platform.h"
 #include "node_process.h"
 #include "node_worker.h"
@@ -172,6 +176,8 @@ Environment::Environment(IsolateData* isolate_data,
       immediate_info_(context->GetIsolate()),
       tick_info_(context->GetIsolate()),
       timer_base_(uv_now(isolate_data->event_loop())),
+      timer_wheel_(timer_base_),
+      read_buffer_pool_(context->GetIsolate()),
       should_abort_on_uncaught_toggle_(isolate_, 1),
       trace_category_state_(isolate_, kTraceCategoryCount),
       stream_base_state_(isolate_, StreamBase::kNumStreamBaseStateFields),
@@ -196,6 +202,12 @@ Environment::Environment(IsolateData* isolate_data,
       std::unique_ptr<inspector::Agent>(new inspector::Agent(this));
 #endif
 
+#if HAVE_OPENSSL
+  bio_buffer_pool_ =
+      std::unique_ptr<crypto::BIOBufferPool>(
+          new crypto::BIOBufferPool(isolate()));
+#endif
+
   AssignToContext(context, ContextInfo(""));
 
   if (tracing::AgentWriterHandle* writer = GetTracingAgentWriter()) {
@@ -272,6 +284,7 @@ Environment::~Environment() {
   delete[] heap_statistics_buffer_;
   delete[] heap_space_statistics_buffer_;
   delete[] http_parser_buffer_;
+  delete[] udp_recv_buffer_;
 
   TRACE_EVENT_NESTABLE_ASYNC_END0(
     TRACING_CATEGORY_NODE1(environment), "Environment", this);
@@ -308,6 +321,10 @@ void Environment::Start(const std::vector<std::string>& args,
   CHECK_EQ(0, uv_timer_init(event_loop(), timer_handle()));
   uv_unref(reinterpret_cast<uv_handle_t*>(timer_handle()));
 
+  // Timers on the wheel never keep the loop alive.
+  CHECK_EQ(0, uv_timer_init(event_loop(), timer_wheel_handle()));
+  uv_unref(reinterpret_cast<uv_handle_t*>(timer_wheel_handle()));
+
   uv_check_init(event_loop(), immediate_check_handle());
   uv_unref(reinterpret_cast<uv_handle_t*>(immediate_check_handle()));
 
@@ -315,6 +332,10 @@ void Environment::Start(const std::vector<std::string>& args,
 
   uv_check_start(immediate_check_handle(), CheckImmediate);
 
+  // Collect per-phase loop timing for perf_hooks and the node.perf.event_loop
+  // trace category. Costs a uv_hrtime() call per phase.
+  uv_loop_configure(event_loop(), UV_METRICS_IDLE_TIME);
+
   // Inform V8's CPU profiler when we're idle.  The profiler is sampling-based
   // but not all samples are created equal; mark the wall clock time spent in
   // epoll_wait() and friends so profiling tools can filter it out.  The samples
@@ -366,6 +387,10 @@ void Environment::RegisterHandleCleanups() {
       reinterpret_cast<uv_handle_t*>(timer_handle()),
       close_and_finish,
       nullptr);
+  RegisterHandleCleanup(
+      reinterpret_cast<uv_handle_t*>(timer_wheel_handle()),
+      close_and_finish,
+      nullptr);
   RegisterHandleCleanup(
       reinterpret_cast<uv_handle_t*>(immediate_check_handle()),
       close_and_finish,
@@ -694,11 +719,61 @@ void Environment::RunTimers(uv_timer_t* handle) {
 }
 
 
+void Environment::ScheduleTimerWheel() {
+  const uint64_t next = timer_wheel_.HasExpired() ?
+      uv_now(event_loop()) : timer_wheel_.NextEventTime();
+  if (next == timer_wheel_due_)
+    return;
+  if (next == UINT64_MAX) {
+    uv_timer_stop(timer_wheel_handle());
+  } else {
+    const uint64_t now = uv_now(event_loop());
+    uv_timer_start(timer_wheel_handle(), RunTimerWheel,
+                   next > now ? next - now : 0, 0);
+  }
+  timer_wheel_due_ = next;
+}
+
+void Environment::RunTimerWheel(uv_timer_t* handle) {
+  Environment* env = Environment::from_timer_wheel_handle(handle);
+  TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
+                              "RunTimerWheel", env);
+
+  env->timer_wheel_due_ = UINT64_MAX;
+  env->timer_wheel()->Advance(uv_now(env->event_loop()));
+
+  if (env->timer_wheel()->HasExpired() && env->can_call_into_js()) {
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+
+    Local<Object> process = env->process_object();
+    InternalCallbackScope scope(env, process, {0, 0});
+
+    // The JS side pops expired timers one at a time, so if a callback throws
+    // we call it again to continue with the rest.
+    Local<Function> cb = env->timer_wheel_callback_function();
+    MaybeLocal<Value> ret;
+    do {
+      TryCatchScope try_catch(env);
+      try_catch.SetVerbose(true);
+      ret = cb->Call(env->context(), process, 0, nullptr);
+    } while (ret.IsEmpty() && env->can_call_into_js());
+
+    if (ret.IsEmpty())
+      return;
+  }
+
+  env->ScheduleTimerWheel();
+}
+
+
 void Environment::CheckImmediate(uv_check_t* handle) {
   Environment* env = Environment::from_immediate_check_handle(handle);
   TraceEventScope trace_scope(TRACING_CATEGORY_NODE1(environment),
                               "CheckImmediate", env);
 
+  performance::TraceLoopIteration(env);
+
   if (env->immediate_info()->count() == 0)
     return;
 
@@ -34,6 +34,8 @@
 #include "node_http2_state.h"
 #include "node_options.h"
 #include "req_wrap.h"
+#include "read_buffer_pool.h"
+#include "timer_wheel.h"
 #include "util.h"
 #include "uv.h"
 #include "v8.h"
@@ -53,6 +55,12 @@ namespace contextify {
 class ContextifyScript;
 }
 
+#if HAVE_OPENSSL
+namespace crypto {
+class BIOBufferPool;
+}
+#endif
+
 namespace fs {
 class FileHandleReadWrap;
 }
@@ -230,7 +238,9 @@ constexpr size_t kFsStatsBufferLength = kFsStatsFieldsNumber * 2;
   V(onexit_string, "onexit")                                                   \
   V(onhandshakedone_string, "onhandshakedone")                                 \
   V(onhandshakestart_string, "onhandshakestart")                               \
+  V(onhold_string, "onhold")                                                   \
   V(onmessage_string, "onmessage")                                             \
+  V(onmessagebatch_string, "onmessagebatch")                                   \
   V(onnewsession_string, "onnewsession")                                       \
   V(onocspresponse_string, "onocspresponse")                                   \
   V(onread_string, "onread")                                                   \
@@ -374,6 +384,7 @@ constexpr size_t kFsStatsBufferLength = kFsStatsFieldsNumber * 2;
   V(start_execution_function, v8::Function)                                    \
   V(tcp_constructor_template, v8::FunctionTemplate)                            \
   V(tick_callback_function, v8::Function)                                      \
+  V(timer_wheel_callback_function, v8::Function)                               \
   V(timers_callback_function, v8::Function)                                    \
   V(tls_wrap_constructor_function, v8::Function)                               \
   V(trace_category_state_function, v8::Function)                               \
@@ -651,6 +662,12 @@ class Environment {
   static inline Environment* from_timer_handle(uv_timer_t* handle);
   inline uv_timer_t* timer_handle();
 
+  static inline Environment* from_timer_wheel_handle(uv_timer_t* handle);
+  inline uv_timer_t* timer_wheel_handle();
+  inline TimerWheel* timer_wheel();
+
+  inline ReadBufferPool* read_buffer_pool();
+
   static inline Environment* from_immediate_check_handle(uv_check_t* handle);
   inline uv_check_t* immediate_check_handle();
   inline uv_idle_t* immediate_idle_handle();
@@ -717,6 +734,20 @@ class Environment {
   inline void set_http_parser_buffer(char* buffer);
   inline bool http_parser_buffer_in_use() const;
   inline void set_http_parser_buffer_in_use(bool in_use);
+  // Internalized strings for common HTTP header names, filled in lazily by
+  // the HTTP parser.
+  inline std::vector<v8::Global<v8::String>>* http_header_names();
+  // Metadata of pipelined HTTP requests that the parser hands to JS in one
+  // go; see `Parser::FlushBatch()` in node_http_parser_impl.h.
+  inline AliasedBuffer<uint32_t, v8::Uint32Array>* http_parser_batch_state()
+      const;
+  inline void set_http_parser_batch_state(
+      std::unique_ptr<AliasedBuffer<uint32_t, v8::Uint32Array>> state);
+
+  inline char* udp_recv_buffer() const;
+  inline void set_udp_recv_buffer(char* buffer);
+  inline bool udp_recv_buffer_in_use() const;
+  inline void set_udp_recv_buffer_in_use(bool in_use);
 
   inline http2::Http2State* http2_state() const;
   inline void set_http2_state(std::unique_ptr<http2::Http2State> state);
@@ -845,6 +876,12 @@ class Environment {
   }
 #endif
 
+#if HAVE_OPENSSL
+  inline crypto::BIOBufferPool* bio_buffer_pool() const {
+    return bio_buffer_pool_.get();
+  }
+#endif
+
   typedef ListHead<HandleWrap, &HandleWrap::handle_wrap_queue_> HandleWrapQueue;
   typedef ListHead<ReqWrap<uv_req_t>, &ReqWrap<uv_req_t>::req_wrap_queue_>
           ReqWrapQueue;
@@ -915,6 +952,8 @@ class Environment {
   v8::Local<v8::Value> GetNow();
   void ScheduleTimer(int64_t duration);
   void ToggleTimerRef(bool ref);
+  // Makes sure timer_wheel_handle() fires by the wheel's next event.
+  void ScheduleTimerWheel();
 
   inline void AddCleanupHook(void (*fn)(void*), void* arg);
   inline void RemoveCleanupHook(void (*fn)(void*), void* arg);
@@ -940,6 +979,7 @@ class Environment {
   v8::Isolate* const isolate_;
   IsolateData* const isolate_data_;
   uv_timer_t timer_handle_;
+  uv_timer_t timer_wheel_handle_;
   uv_check_t immediate_check_handle_;
   uv_idle_t immediate_idle_handle_;
   uv_prepare_t idle_prepare_handle_;
@@ -950,6 +990,10 @@ class Environment {
   ImmediateInfo immediate_info_;
   TickInfo tick_info_;
   const uint64_t timer_base_;
+  TimerWheel timer_wheel_;
+  // When timer_wheel_handle_ is due, or UINT64_MAX if it is stopped.
+  uint64_t timer_wheel_due_ = UINT64_MAX;
+  ReadBufferPool read_buffer_pool_;
   bool printed_error_ = false;
   bool abort_on_uncaught_exception_ = false;
   bool emit_env_nonstring_warning_ = true;
@@ -994,6 +1038,10 @@ class Environment {
   std::unique_ptr<inspector::Agent> inspector_agent_;
 #endif
 
+#if HAVE_OPENSSL
+  std::unique_ptr<crypto::BIOBufferPool> bio_buffer_pool_;
+#endif
+
   // handle_wrap_queue_ and req_wrap_queue_ needs to be at a fixed offset from
   // the start of the class because it is used by
   // src/node_postmortem_metadata.cc to calculate offsets and generate debug
@@ -1012,6 +1060,11 @@ class Environment {
 
   char* http_parser_buffer_ = nullptr;
   bool http_parser_buffer_in_use_ = false;
+  std::vector<v8::Global<v8::String>> http_header_names_;
+  std::unique_ptr<AliasedBuffer<uint32_t, v8::Uint32Array>>
+      http_parser_batch_state_;
+  char* udp_recv_buffer_ = nullptr;
+  bool udp_recv_buffer_in_use_ = false;
   std::unique_ptr<http2::Http2State> http2_state_;
 
   bool debug_enabled_[static_cast<int>(DebugCategory::CATEGORY_COUNT)] = {0};
@@ -1025,6 +1078,7 @@ class Environment {
   worker::Worker* worker_context_ = nullptr;
 
   static void RunTimers(uv_timer_t* handle);
+  static void RunTimerWheel(uv_timer_t* handle);
 
   struct ExitCallback {
     void (*cb_)(void* arg);
@@ -0,0 +1,151 @@
+#ifndef SRC_HISTOGRAM_INL_H_
+#define SRC_HISTOGRAM_INL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "histogram.h"
+#include "util.h"
+
+#include <math.h>
+#include <algorithm>
+
+namespace node {
+
+namespace histogram_internal {
+
+// Number of significant bits in |value|, which must not be 0.
+inline int BitLength(uint64_t value) {
+#if defined(__GNUC__)
+  return 64 - __builtin_clzll(value);
+#else
+  int length = 0;
+  while (value != 0) {
+    value >>= 1;
+    length++;
+  }
+  return length;
+#endif
+}
+
+}  // namespace histogram_internal
+
+Histogram::Histogram(int64_t highest, int precision_bits)
+    : sub_bucket_half_count_magnitude_(precision_bits),
+      sub_bucket_half_count_(int64_t{1} << precision_bits),
+      sub_bucket_mask_((int64_t{2} << precision_bits) - 1),
+      highest_(highest) {
+  CHECK_GE(precision_bits, 1);
+  CHECK_LE(precision_bits, 20);
+  const int64_t sub_bucket_count = sub_bucket_half_count_ * 2;
+  CHECK_GE(highest, sub_bucket_count);
+  size_t buckets = 1;
+  int64_t smallest_untrackable = sub_bucket_count;
+  while (smallest_untrackable <= highest) {
+    buckets++;
+    if (smallest_untrackable > INT64_MAX / 2)
+      break;
+    smallest_untrackable <<= 1;
+  }
+  counts_.resize((buckets + 1) * sub_bucket_half_count_);
+}
+
+size_t Histogram::CountsIndex(int64_t value) const {
+  const int bucket =
+      histogram_internal::BitLength(value | sub_bucket_mask_) -
+      (sub_bucket_half_count_magnitude_ + 1);
+  const int64_t sub_bucket = value >> bucket;
+  return ((bucket + 1) << sub_bucket_half_count_magnitude_) +
+         (sub_bucket - sub_bucket_half_count_);
+}
+
+int64_t Histogram::HighestEquivalentValue(size_t index) const {
+  int bucket = (index >> sub_bucket_half_count_magnitude_) - 1;
+  int64_t sub_bucket =
+      (index & (sub_bucket_half_count_ - 1)) + sub_bucket_half_count_;
+  if (bucket < 0) {
+    sub_bucket -= sub_bucket_half_count_;
+    bucket = 0;
+  }
+  return (sub_bucket << bucket) + (int64_t{1} << bucket) - 1;
+}
+
+bool Histogram::Record(int64_t value) {
+  if (value < 0 || value > highest_)
+    return false;
+  counts_[CountsIndex(value)]++;
+  count_++;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  const double delta = value - mean_;
+  mean_ += delta / count_;
+  m2_ += delta * (value - mean_);
+  return true;
+}
+
+void Histogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  min_ = INT64_MAX;
+  max_ = 0;
+  mean_ = 0;
+  m2_ = 0;
+}
+
+int64_t Histogram::Min() const {
+  return count_ > 0 ? min_ : 0;
+}
+
+double Histogram::Mean() const {
+  return count_ > 0 ? mean_ : NAN;
+}
+
+double Histogram::Stddev() const {
+  return count_ > 0 ? sqrt(m2_ / count_) : NAN;
+}
+
+int64_t Histogram::Percentile(double percentile) const {
+  if (count_ == 0)
+    return 0;
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  const int64_t target = std::max<int64_t>(
+      static_cast<int64_t>(percentile / 100 * count_ + 0.5), 1);
+  int64_t total = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    total += counts_[i];
+    if (total >= target)
+      return std::min(HighestEquivalentValue(i), max_);
+  }
+  return max_;
+}
+
+template <typename Fn>
+void Histogram::Percentiles(Fn&& fn) const {
+  if (count_ == 0)
+    return;
+  double percentile = 0;
+  double step = 50;
+  int64_t total = 0;
+  size_t i = 0;
+  for (;;) {
+    const int64_t target = std::max<int64_t>(
+        static_cast<int64_t>(percentile / 100 * count_ + 0.5), 1);
+    while (total < target)
+      total += counts_[i++];
+    fn(percentile, std::min(HighestEquivalentValue(i - 1), max_));
+    if (total >= count_)
+      break;
+    percentile += step;
+    step /= 2;
+  }
+  fn(100, max_);
+}
+
+size_t Histogram::GetMemorySize() const {
+  return counts_.capacity() * sizeof(counts_[0]);
+}
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HISTOGRAM_INL_H_
@@ -0,0 +1,64 @@
+#ifndef SRC_HISTOGRAM_H_
+#define SRC_HISTOGRAM_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace node {
+
+// A histogram in the style of HdrHistogram. Values are grouped into buckets
+// that double in size, each of which is split into the same number of linear
+// sub-buckets, so that every value between 0 and |highest| is recorded with
+// a relative error of at most 2^-|precision_bits| in constant time and space.
+// The default keeps three significant digits.
+class Histogram {
+ public:
+  inline explicit Histogram(int64_t highest, int precision_bits = 10);
+  virtual ~Histogram() = default;
+
+  // Returns false, without recording anything, if |value| is out of range.
+  inline bool Record(int64_t value);
+  inline void Reset();
+
+  inline int64_t Count() const { return count_; }
+  inline int64_t Min() const;
+  inline int64_t Max() const { return max_; }
+  inline double Mean() const;
+  inline double Stddev() const;
+
+  // The smallest recorded value that |percentile| percent of all recorded
+  // values are less than or equal to, within the histogram's precision.
+  inline int64_t Percentile(double percentile) const;
+
+  // Calls |fn(percentile, value)| for the percentiles 0, 50, 75, 87.5, ...
+  // up to and including 100, halving the distance to 100 on every step.
+  template <typename Fn>
+  inline void Percentiles(Fn&& fn) const;
+
+  inline size_t GetMemorySize() const;
+
+ private:
+  inline size_t CountsIndex(int64_t value) const;
+  inline int64_t HighestEquivalentValue(size_t index) const;
+
+  const int sub_bucket_half_count_magnitude_;
+  const int64_t sub_bucket_half_count_;
+  const int64_t sub_bucket_mask_;
+  const int64_t highest_;
+  std::vector<int64_t> counts_;
+  int64_t count_ = 0;
+  int64_t min_ = INT64_MAX;
+  int64_t max_ = 0;
+  // Running mean and sum of squared differences from it (Welford).
+  double mean_ = 0;
+  double m2_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_HISTOGRAM_H_
@@ -951,6 +951,49 @@ int ProcessGlobalArgs(std::vector<std::string>* args,
   return 0;
 }
 
+// Hands the sizes from a --threadpool-size value like "crypto:8,fs:16" to
+// libuv. Pools that are not mentioned keep sharing the default pool.
+static bool ConfigureThreadPools(const std::string& spec,
+                                 std::vector<std::string>* errors) {
+  static const struct {
+    const char* name;
+    ThreadPoolKind kind;
+  } pools[] = {
+    { "default", ThreadPoolKind::kDefault },
+    { "fs", ThreadPoolKind::kFs },
+    { "dns", ThreadPoolKind::kDns },
+    { "crypto", ThreadPoolKind::kCrypto },
+    { "compression", ThreadPoolKind::kCompression },
+    { "user", ThreadPoolKind::kUser },
+  };
+
+  for (const std::string& item : SplitString(spec, ',')) {
+    const size_t colon = item.find(':');
+    const std::string name = item.substr(0, colon);
+    const char* size =
+        colon == std::string::npos ? "" : item.c_str() + colon + 1;
+    char* end;
+    const unsigned long n = strtoul(size, &end, 10);  // NOLINT(runtime/int)
+
+    bool ok = false;
+    if (*size != '\0' && *end == '\0' && n > 0) {
+      for (const auto& pool : pools) {
+        if (name != pool.name) continue;
+        ok = uv_threadpool_set_size(static_cast<unsigned int>(pool.kind),
+                                    n) == 0;
+        break;
+      }
+    }
+
+    if (!ok) {
+      errors->push_back("invalid value for --threadpool-size: " + item);
+      return false;
+    }
+  }
+
+  return true;
+}
+
 int Init(std::vector<std::string>* argv,
          std::vector<std::string>* exec_argv,
          std::vector<std::string>* errors) {
@@ -1026,6 +1069,13 @@ int Init(std::vector<std::string>* argv,
   if (!per_process::cli_options->title.empty())
     uv_set_process_title(per_process::cli_options->title.c_str());
 
+  // Size the threadpools before anything has a chance to submit work.
+  if (!per_process::cli_options->threadpool_size.empty() &&
+      !ConfigureThreadPools(per_process::cli_options->threadpool_size,
+                            errors)) {
+    return 9;
+  }
+
 #if defined(NODE_HAVE_I18N_SUPPORT)
   // If the parameter isn't given, use the env variable.
   if (per_process::cli_options->icu_data_dir.empty())
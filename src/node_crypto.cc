@@ -5382,7 +5382,8 @@ bool ECDH::IsKeyPairValid() {
 struct CryptoJob : public ThreadPoolWork {
   Environment* const env;
   std::unique_ptr<AsyncWrap> async_wrap;
-  inline explicit CryptoJob(Environment* env) : ThreadPoolWork(env), env(env) {}
+  inline CryptoJob(Environment* env, const char* name)
+      : ThreadPoolWork(env, ThreadPoolKind::kCrypto, name), env(env) {}
   inline void AfterThreadPoolWork(int status) final;
   virtual void AfterThreadPoolWork() = 0;
   static inline void Run(std::unique_ptr<CryptoJob> job, Local<Value> wrap);
@@ -5423,7 +5424,7 @@ struct RandomBytesJob : public CryptoJob {
   Maybe<int> rc;
 
   inline explicit RandomBytesJob(Environment* env)
-      : CryptoJob(env), rc(Nothing<int>()) {}
+      : CryptoJob(env, "randomBytes"), rc(Nothing<int>()) {}
 
   inline void DoThreadPoolWork() override {
     CheckEntropy();  // Ensure that OpenSSL's PRNG is properly seeded.
@@ -5473,7 +5474,7 @@ struct PBKDF2Job : public CryptoJob {
   Maybe<bool> success;
 
   inline explicit PBKDF2Job(Environment* env)
-      : CryptoJob(env), success(Nothing<bool>()) {}
+      : CryptoJob(env, "pbkdf2"), success(Nothing<bool>()) {}
 
   inline ~PBKDF2Job() override {
     Cleanse();
@@ -5543,7 +5544,7 @@ struct ScryptJob : public CryptoJob {
   uint32_t maxmem;
   CryptoErrorVector errors;
 
-  inline explicit ScryptJob(Environment* env) : CryptoJob(env) {}
+  inline explicit ScryptJob(Environment* env) : CryptoJob(env, "scrypt") {}
 
   inline ~ScryptJob() override {
     Cleanse();
@@ -5742,7 +5743,7 @@ class GenerateKeyPairJob : public CryptoJob {
                      std::unique_ptr<KeyPairGenerationConfig> config,
                      PublicKeyEncodingConfig public_key_encoding,
                      PrivateKeyEncodingConfig&& private_key_encoding)
-    : CryptoJob(env),
+    : CryptoJob(env, "generateKeyPair"),
     config_(std::move(config)),
     public_key_encoding_(public_key_encoding),
     private_key_encoding_(std::forward<PrivateKeyEncodingConfig>(
@@ -37,6 +37,85 @@ namespace crypto {
 #define BIO_get_init(bio) bio->init
 #endif
 
+const size_t BIOBufferPool::kBlockSize;
+const size_t BIOBufferPool::kMaxFreeBlocks;
+
+
+BIOBufferPool::~BIOBufferPool() {
+  // Blocks that are still in use belong to NodeBIOs, which free them.
+  for (char* block : free_)
+    delete[] block;
+}
+
+
+char* BIOBufferPool::Allocate() {
+  stats_[kAllocations]++;
+  in_use_++;
+
+  if (!free_.empty()) {
+    stats_[kReuses]++;
+    char* block = free_.back();
+    free_.pop_back();
+    return block;
+  }
+
+  isolate_->AdjustAmountOfExternalAllocatedMemory(kBlockSize);
+  return new char[kBlockSize];
+}
+
+
+void BIOBufferPool::Release(char* block) {
+  stats_[kReleases]++;
+  in_use_--;
+
+  if (free_.size() < kMaxFreeBlocks) {
+    free_.push_back(block);
+    return;
+  }
+
+  stats_[kFrees]++;
+  delete[] block;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(kBlockSize));
+}
+
+
+uint64_t BIOBufferPool::stat(Fields field) const {
+  switch (field) {
+    case kInUse:
+      return in_use_;
+    case kFree:
+      return free_.size();
+    default:
+      return stats_[field];
+  }
+}
+
+
+NodeBIO::Buffer::Buffer(Environment* env, size_t len)
+    : env_(env),
+      read_pos_(0),
+      write_pos_(0),
+      len_(len),
+      next_(nullptr) {
+  if (env_ != nullptr) {
+    CHECK_LE(len_, BIOBufferPool::kBlockSize);
+    len_ = BIOBufferPool::kBlockSize;
+    data_ = env_->bio_buffer_pool()->Allocate();
+    return;
+  }
+
+  data_ = new char[len_];
+}
+
+
+NodeBIO::Buffer::~Buffer() {
+  if (env_ != nullptr)
+    env_->bio_buffer_pool()->Release(data_);
+  else
+    delete[] data_;
+}
+
 
 BIOPointer NodeBIO::New(Environment* env) {
   // The const_cast doesn't violate const correctness.  OpenSSL's usage of
@@ -103,12 +182,22 @@ int NodeBIO::Read(BIO* bio, char* out, int len) {
 
 
 char* NodeBIO::Peek(size_t* size) {
+  if (read_head_ == nullptr) {
+    *size = 0;
+    return nullptr;
+  }
+
   *size = read_head_->write_pos_ - read_head_->read_pos_;
   return read_head_->data_ + read_head_->read_pos_;
 }
 
 
 size_t NodeBIO::PeekMultiple(char** out, size_t* size, size_t* count) {
+  if (read_head_ == nullptr) {
+    *count = 0;
+    return 0;
+  }
+
   Buffer* pos = read_head_;
   size_t max = *count;
   size_t total = 0;
@@ -315,6 +404,7 @@ size_t NodeBIO::Read(char* out, size_t size) {
 
   // Free all empty buffers, but write_head's child
   FreeEmpty();
+  ReleaseIfEmpty();
 
   return bytes_read;
 }
@@ -439,6 +529,12 @@ char* NodeBIO::PeekWritable(size_t* size) {
 
 
 void NodeBIO::Commit(size_t size) {
+  // Nothing was written to the space returned by PeekWritable()
+  if (size == 0) {
+    ReleaseIfEmpty();
+    return;
+  }
+
   write_head_->write_pos_ += size;
   length_ += size;
   CHECK_LE(write_head_->write_pos_, write_head_->len_);
@@ -467,6 +563,9 @@ void NodeBIO::TryAllocateForWrite(size_t hint) {
                              kThroughputBufferLength;
     if (len < hint)
       len = hint;
+    // Pooled buffers are single blocks, larger writes span several of them.
+    if (env_ != nullptr && len > BIOBufferPool::kBlockSize)
+      len = BIOBufferPool::kBlockSize;
     Buffer* next = new Buffer(env_, len);
 
     if (w == nullptr) {
@@ -496,6 +595,25 @@ void NodeBIO::Reset() {
   }
   write_head_ = read_head_;
   CHECK_EQ(length_, 0);
+
+  ReleaseIfEmpty();
+}
+
+
+void NodeBIO::ReleaseIfEmpty() {
+  // Only pooled buffers are given back, others are kept for the next write.
+  if (env_ == nullptr || length_ != 0 || read_head_ == nullptr)
+    return;
+
+  Buffer* current = read_head_;
+  do {
+    Buffer* next = current->next_;
+    delete current;
+    current = next;
+  } while (current != read_head_);
+
+  read_head_ = nullptr;
+  write_head_ = nullptr;
 }
 
 
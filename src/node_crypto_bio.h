@@ -26,13 +26,56 @@
 
 #include "node_crypto.h"
 #include "openssl/bio.h"
+#include "openssl/ssl3.h"
 #include "env-inl.h"
 #include "util-inl.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 namespace crypto {
 
+// Hands out the blocks that NodeBIOs keep their data in. Each Environment,
+// and therefore each thread, has one pool. A block fits a full TLS record,
+// and NodeBIOs give their blocks back as soon as they are empty, so idle
+// connections hold none. A limited number of free blocks is kept for the
+// next connection that needs one.
+class BIOBufferPool {
+ public:
+  // Exposed to JS through the tls_wrap binding.
+  enum Fields {
+    kAllocations,  // Blocks handed out.
+    kReuses,       // Blocks handed out from the free list.
+    kReleases,     // Blocks given back.
+    kFrees,        // Blocks freed because the free list was full.
+    kInUse,        // Blocks currently held by NodeBIOs.
+    kFree,         // Blocks currently in the free list.
+    kNumFields
+  };
+
+  static const size_t kBlockSize = SSL3_RT_MAX_PACKET_SIZE;
+  static const size_t kMaxFreeBlocks = 64;
+
+  explicit BIOBufferPool(v8::Isolate* isolate) : isolate_(isolate) {}
+  ~BIOBufferPool();
+
+  BIOBufferPool(const BIOBufferPool&) = delete;
+  BIOBufferPool& operator=(const BIOBufferPool&) = delete;
+
+  // Returns a block of kBlockSize bytes.
+  char* Allocate();
+  void Release(char* block);
+
+  uint64_t stat(Fields field) const;
+
+ private:
+  v8::Isolate* isolate_;
+  std::vector<char*> free_;
+  uint64_t in_use_ = 0;
+  uint64_t stats_[kNumFields] = {};
+};
+
 // This class represents buffers for OpenSSL I/O, implemented as a singly-linked
 // list of chunks. It can be used both for writing data from Node to OpenSSL
 // and back, but only one direction per instance.
@@ -77,6 +120,9 @@ class NodeBIO : public MemoryRetainer {
   // Discard all available data
   void Reset();
 
+  // Give all buffers back if there is no data left
+  void ReleaseIfEmpty();
+
   // Put `len` bytes from `data` into buffer
   void Write(const char* data, size_t size);
 
@@ -132,23 +178,10 @@ class NodeBIO : public MemoryRetainer {
 
   class Buffer {
    public:
-    Buffer(Environment* env, size_t len) : env_(env),
-                                           read_pos_(0),
-                                           write_pos_(0),
-                                           len_(len),
-                                           next_(nullptr) {
-      data_ = new char[len];
-      if (env_ != nullptr)
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(len);
-    }
-
-    ~Buffer() {
-      delete[] data_;
-      if (env_ != nullptr) {
-        const int64_t len = static_cast<int64_t>(len_);
-        env_->isolate()->AdjustAmountOfExternalAllocatedMemory(-len);
-      }
-    }
+    // Buffers of NodeBIOs that belong to an Environment are blocks from its
+    // BIOBufferPool.
+    Buffer(Environment* env, size_t len);
+    ~Buffer();
 
     Environment* env_;
     size_t read_pos_;
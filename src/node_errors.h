@@ -70,6 +70,8 @@ void FatalException(const v8::FunctionCallbackInfo<v8::Value>& args);
   V(ERR_SCRIPT_EXECUTION_TIMEOUT, Error)                                     \
   V(ERR_STRING_TOO_LONG, Error)                                              \
   V(ERR_TLS_INVALID_PROTOCOL_METHOD, TypeError)                              \
+  V(ERR_TLS_KERNEL_RECORD_DROPPED, Error)                                    \
+  V(ERR_TLS_RENEGOTIATION_DISABLED, Error)                                   \
   V(ERR_TRANSFERRING_EXTERNALIZED_SHAREDARRAYBUFFER, TypeError)              \
 
 #define V(code, type)                                                         \
@@ -110,6 +112,8 @@ void FatalException(const v8::FunctionCallbackInfo<v8::Value>& args);
     "creating Workers")                                                      \
   V(ERR_SCRIPT_EXECUTION_INTERRUPTED,                                        \
     "Script execution was interrupted by `SIGINT`")                          \
+  V(ERR_TLS_KERNEL_RECORD_DROPPED,                                           \
+    "Cannot send a TLS record while the kernel encrypts outgoing records")   \
   V(ERR_TRANSFERRING_EXTERNALIZED_SHAREDARRAYBUFFER,                         \
     "Cannot serialize externalized SharedArrayBuffer")                       \
 
@@ -44,6 +44,10 @@
 # include <io.h>
 #endif
 
+#ifdef __POSIX__
+# include <unistd.h>  // dup()
+#endif
+
 #include <memory>
 
 namespace node {
@@ -323,25 +327,22 @@ int FileHandle::ReadStart() {
       read_wrap.reset(new FileHandleReadWrap(this, wrap_obj));
     }
   }
-  int64_t recommended_read = 65536;
-  if (read_length_ >= 0 && read_length_ <= recommended_read)
-    recommended_read = read_length_;
 
-  read_wrap->buffer_ = EmitAlloc(recommended_read);
-
-  current_read_ = std::move(read_wrap);
-
-  current_read_->Dispatch(uv_fs_read,
-                          fd_,
-                          &current_read_->buffer_,
-                          1,
-                          read_offset_,
-                          uv_fs_callback_t{[](uv_fs_t* req) {
+  uv_fs_callback_t after_read = uv_fs_callback_t{[](uv_fs_t* req) {
     FileHandle* handle;
+    bool sendfile = false;
     {
       FileHandleReadWrap* req_wrap = FileHandleReadWrap::from_req(req);
       handle = req_wrap->file_handle_;
       CHECK_EQ(handle->current_read_.get(), req_wrap);
+#ifdef __POSIX__
+      if (req_wrap->sendfile_out_ != -1) {
+        sendfile = true;
+        close(req_wrap->sendfile_out_);
+        close(req_wrap->sendfile_in_);
+        req_wrap->sendfile_out_ = req_wrap->sendfile_in_ = -1;
+      }
+#endif
     }
 
     // ReadStart() checks whether current_read_ is set to determine whether
@@ -364,6 +365,13 @@ int FileHandle::ReadStart() {
       freelist.emplace_back(std::move(read_wrap));
     }
 
+    if (sendfile && handle->drop_sendfile_result_) {
+      // The listener that asked for sendfile() is gone. Its successor
+      // expects data in the buffer, which this read did not fill.
+      handle->drop_sendfile_result_ = false;
+      return;
+    }
+
     if (result >= 0) {
       // Read at most as many bytes as we originally planned to.
       if (handle->read_length_ >= 0 && handle->read_length_ < result)
@@ -389,11 +397,64 @@ int FileHandle::ReadStart() {
     // Start over, if EmitRead() didn’t tell us to stop.
     if (handle->reading_)
       handle->ReadStart();
-  }});
+  }};
+
+#ifdef __POSIX__
+  if (sendfile_fd_ != -1 && read_offset_ >= 0) {
+    // The kernel sends as much as the target takes, this only caps how long
+    // a single request can keep a threadpool thread busy.
+    int64_t length = 1 << 20;
+    if (read_length_ >= 0 && read_length_ <= length)
+      length = read_length_;
+
+    read_wrap->sendfile_out_ = dup(sendfile_fd_);
+    read_wrap->sendfile_in_ = dup(fd_);
+    if (read_wrap->sendfile_out_ == -1 || read_wrap->sendfile_in_ == -1) {
+      int err = uv_translate_sys_error(errno);
+      if (read_wrap->sendfile_out_ != -1)
+        close(read_wrap->sendfile_out_);
+      if (read_wrap->sendfile_in_ != -1)
+        close(read_wrap->sendfile_in_);
+      read_wrap->sendfile_out_ = read_wrap->sendfile_in_ = -1;
+      return err;
+    }
+
+    read_wrap->buffer_ = uv_buf_init(nullptr, 0);
+    current_read_ = std::move(read_wrap);
+    current_read_->Dispatch(uv_fs_sendfile,
+                            current_read_->sendfile_out_,
+                            current_read_->sendfile_in_,
+                            read_offset_,
+                            static_cast<size_t>(length),
+                            after_read);
+    return 0;
+  }
+#endif
+
+  int64_t recommended_read = 65536;
+  if (read_length_ >= 0 && read_length_ <= recommended_read)
+    recommended_read = read_length_;
+
+  read_wrap->buffer_ = EmitAlloc(recommended_read);
+
+  current_read_ = std::move(read_wrap);
+
+  current_read_->Dispatch(uv_fs_read,
+                          fd_,
+                          &current_read_->buffer_,
+                          1,
+                          read_offset_,
+                          after_read);
 
   return 0;
 }
 
+void FileHandle::StopSendFile() {
+  sendfile_fd_ = -1;
+  if (sendfile_pending())
+    drop_sendfile_result_ = true;
+}
+
 int FileHandle::ReadStop() {
   reading_ = false;
   return 0;
@@ -457,6 +518,8 @@ FSReqAfterScope::FSReqAfterScope(FSReqBase* wrap, uv_fs_t* req)
       handle_scope_(wrap->env()->isolate()),
       context_scope_(wrap->env()->context()) {
   CHECK_EQ(wrap_->req(), req);
+  performance::RecordThreadPoolWork(
+      wrap->env(), wrap->syscall(), reinterpret_cast<uv_req_t*>(req));
 }
 
 FSReqAfterScope::~FSReqAfterScope() {
@@ -348,6 +348,10 @@ class FileHandleReadWrap : public ReqWrap<uv_fs_t> {
  private:
   FileHandle* file_handle_;
   uv_buf_t buffer_;
+  // Private copies of the descriptors a sendfile() works on, so that neither
+  // can be closed and its number reused while the request is in flight.
+  int sendfile_out_ = -1;
+  int sendfile_in_ = -1;
 
   friend class FileHandle;
 };
@@ -372,6 +376,19 @@ class FileHandle : public AsyncWrap, public StreamBase {
   // Releases ownership of the FD.
   static void ReleaseFD(const FunctionCallbackInfo<Value>& args);
 
+  // While |fd| is not -1, reads send the data straight to the descriptor
+  // |fd| with sendfile() and report the number of bytes sent with an empty
+  // buffer, or UV_EAGAIN when |fd| is non-blocking and full. Only works for
+  // FileHandles that were created with an offset.
+  void set_sendfile_fd(int fd) { sendfile_fd_ = fd; }
+  // Whether a sendfile() is in flight.
+  bool sendfile_pending() const {
+    return current_read_ && current_read_->sendfile_out_ != -1;
+  }
+  // Stops using sendfile(). The result of a sendfile() in flight is dropped
+  // instead of being reported to the stream's listener.
+  void StopSendFile();
+
   // StreamBase interface:
   int ReadStart() override;
   int ReadStop() override;
@@ -465,6 +482,8 @@ class FileHandle : public AsyncWrap, public StreamBase {
   int64_t read_length_ = -1;
 
   bool reading_ = false;
+  int sendfile_fd_ = -1;
+  bool drop_sendfile_result_ = false;
   std::unique_ptr<FileHandleReadWrap> current_read_ = nullptr;
 };
 
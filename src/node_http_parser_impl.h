@@ -63,14 +63,18 @@ using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Global;
 using v8::HandleScope;
 using v8::Int32;
 using v8::Integer;
+using v8::Isolate;
 using v8::Local;
 using v8::MaybeLocal;
+using v8::NewStringType;
 using v8::Object;
 using v8::String;
 using v8::Uint32;
+using v8::Uint32Array;
 using v8::Undefined;
 using v8::Value;
 
@@ -79,9 +83,115 @@ const uint32_t kOnHeadersComplete = 1;
 const uint32_t kOnBody = 2;
 const uint32_t kOnMessageComplete = 3;
 const uint32_t kOnExecute = 4;
+const uint32_t kOnBatch = 5;
 // Any more fields than this will be flushed into JS
 const size_t kMaxHeaderFieldsCount = 32;
 
+// Header names that are common enough to be kept around as internalized
+// strings. A name is only replaced with its cached string if it matches
+// either this spelling or the all-lowercase one byte for byte, so that
+// `rawHeaders` still reflects what was actually sent.
+#define COMMON_HEADER_NAMES(V)                                                \
+  V("Accept")                                                                 \
+  V("Accept-Charset")                                                         \
+  V("Accept-Encoding")                                                        \
+  V("Accept-Language")                                                        \
+  V("Accept-Ranges")                                                          \
+  V("Access-Control-Request-Headers")                                         \
+  V("Access-Control-Request-Method")                                          \
+  V("Age")                                                                    \
+  V("Authorization")                                                          \
+  V("Cache-Control")                                                          \
+  V("Connection")                                                             \
+  V("Content-Disposition")                                                    \
+  V("Content-Encoding")                                                       \
+  V("Content-Length")                                                         \
+  V("Content-Type")                                                           \
+  V("Cookie")                                                                 \
+  V("DNT")                                                                    \
+  V("Date")                                                                   \
+  V("ETag")                                                                   \
+  V("Expect")                                                                 \
+  V("Expires")                                                                \
+  V("Host")                                                                   \
+  V("If-Match")                                                               \
+  V("If-Modified-Since")                                                      \
+  V("If-None-Match")                                                          \
+  V("If-Range")                                                               \
+  V("Keep-Alive")                                                             \
+  V("Last-Modified")                                                          \
+  V("Location")                                                               \
+  V("Origin")                                                                 \
+  V("Pragma")                                                                 \
+  V("Range")                                                                  \
+  V("Referer")                                                                \
+  V("Server")                                                                 \
+  V("Set-Cookie")                                                             \
+  V("TE")                                                                     \
+  V("Transfer-Encoding")                                                      \
+  V("Upgrade")                                                                \
+  V("Upgrade-Insecure-Requests")                                              \
+  V("User-Agent")                                                             \
+  V("Vary")                                                                   \
+  V("Via")                                                                    \
+  V("X-Forwarded-For")                                                        \
+  V("X-Forwarded-Host")                                                       \
+  V("X-Forwarded-Proto")                                                      \
+  V("X-Requested-With")
+
+#ifdef NODE_EXPERIMENTAL_HTTP
+// In batched mode, requests without a body are not reported one callback at
+// a time. Instead, their metadata is collected in the Environment's
+// `http_parser_batch_state()`, which holds the number of messages followed by
+// `kBatchFieldsPerMessage` fields for each of them, and passed to JS in one
+// `kOnBatch` call per `Execute()`. The URLs and header values of all messages
+// go into one Buffer, the fields hold their offsets in it. That Buffer is new
+// for every batch, because requests decode their header values from it later.
+enum BatchMessageFields {
+  kBatchMethod,
+  kBatchVersionMajor,
+  kBatchVersionMinor,
+  kBatchShouldKeepAlive,
+  kBatchHeaderCount,  // Number of header names.
+  kBatchUrlOffset,
+  kBatchUrlLength,
+  kBatchValuesOffset,  // Header values as laid out by CreateHeaderValues().
+  kBatchFieldsPerMessage
+};
+const size_t kMaxBatchMessages = 256;
+const size_t kBatchStateSize = 1 + kMaxBatchMessages * kBatchFieldsPerMessage;
+#endif  /* NODE_EXPERIMENTAL_HTTP */
+
+struct CommonHeaderName {
+  const char* name;
+  size_t length;
+};
+
+const CommonHeaderName kCommonHeaderNames[] = {
+#define V(name) { name, sizeof(name) - 1 },
+  COMMON_HEADER_NAMES(V)
+#undef V
+};
+
+// Returns the slot of `str` in `Environment::http_header_names()`, or -1 if
+// it is not a common header name. Even slots hold the spellings from
+// `kCommonHeaderNames`, odd slots their lowercase variants.
+int FindCommonHeaderName(const char* str, size_t size) {
+  for (size_t i = 0; i < arraysize(kCommonHeaderNames); i++) {
+    const CommonHeaderName& header = kCommonHeaderNames[i];
+    if (header.length != size)
+      continue;
+    if (memcmp(str, header.name, size) == 0)
+      return static_cast<int>(i * 2);
+    size_t j = 0;
+    while (j < size && str[j] == ToLower(header.name[j]))
+      j++;
+    if (j == size)
+      return static_cast<int>(i * 2 + 1);
+  }
+  return -1;
+}
+
 // helper class for the Parser
 struct StringPtr {
   StringPtr() {
@@ -267,6 +377,7 @@ class Parser : public AsyncWrap, public StreamListener {
       A_STATUS_MESSAGE,
       A_UPGRADE,
       A_SHOULD_KEEP_ALIVE,
+      A_HEADER_VALUES,
       A_MAX
     };
 
@@ -278,6 +389,20 @@ class Parser : public AsyncWrap, public StreamListener {
     if (!cb->IsFunction())
       return 0;
 
+#ifdef NODE_EXPERIMENTAL_HTTP
+    if (CanBatch()) {
+      BatchMessage();
+      num_fields_ = 0;
+      num_values_ = 0;
+      return got_exception_ ? -1 : 0;
+    }
+
+    // Messages that were batched before this one need to reach JS first.
+    FlushBatch();
+    if (got_exception_)
+      return -1;
+#endif  /* NODE_EXPERIMENTAL_HTTP */
+
     Local<Value> undefined = Undefined(env()->isolate());
     for (size_t i = 0; i < arraysize(argv); i++)
       argv[i] = undefined;
@@ -287,7 +412,12 @@ class Parser : public AsyncWrap, public StreamListener {
       Flush();
     } else {
       // Fast case, pass headers and URL to JS land.
-      argv[A_HEADERS] = CreateHeaders();
+      if (lazy_headers_) {
+        argv[A_HEADERS] = CreateHeaderNames();
+        argv[A_HEADER_VALUES] = CreateHeaderValues();
+      } else {
+        argv[A_HEADERS] = CreateHeaders();
+      }
       if (parser_.type == HTTP_REQUEST)
         argv[A_URL] = url_.ToString(env());
     }
@@ -383,6 +513,14 @@ class Parser : public AsyncWrap, public StreamListener {
 
 
   int on_message_complete() {
+#ifdef NODE_EXPERIMENTAL_HTTP
+    // Completion is implied for batched messages.
+    if (in_batch_) {
+      in_batch_ = false;
+      return 0;
+    }
+#endif  /* NODE_EXPERIMENTAL_HTTP */
+
     HandleScope scope(env()->isolate());
 
     if (num_fields_)
@@ -510,6 +648,8 @@ class Parser : public AsyncWrap, public StreamListener {
     CHECK(args[0]->IsInt32());
     CHECK(args[1]->IsBoolean());
     bool isReused = args[1]->IsTrue();
+    bool lazyHeaders = args[2]->IsTrue();
+    bool batched = args[3]->IsTrue();
     parser_type_t type =
         static_cast<parser_type_t>(args[0].As<Int32>()->Value());
 
@@ -525,6 +665,12 @@ class Parser : public AsyncWrap, public StreamListener {
       parser->AsyncReset();
     }
     parser->Init(type);
+    parser->lazy_headers_ = lazyHeaders;
+#ifdef NODE_EXPERIMENTAL_HTTP
+    parser->batched_ = batched;
+#else  /* !NODE_EXPERIMENTAL_HTTP */
+    USE(batched);
+#endif  /* NODE_EXPERIMENTAL_HTTP */
   }
 
 
@@ -672,6 +818,7 @@ class Parser : public AsyncWrap, public StreamListener {
       err = llhttp_execute(&parser_, data, len);
       Save();
     }
+    FlushBatch();
     execute_depth_--;
 
     // Calculate bytes read and resume after Upgrade/CONNECT pause
@@ -771,12 +918,36 @@ class Parser : public AsyncWrap, public StreamListener {
     return scope.Escape(nread_obj);
   }
 
+  Local<String> HeaderNameToString(const StringPtr& name) {
+    int slot = FindCommonHeaderName(name.str_, name.size_);
+    if (slot < 0)
+      return name.ToString(env());
+
+    std::vector<Global<String>>* names = env()->http_header_names();
+    if (names->empty())
+      names->resize(arraysize(kCommonHeaderNames) * 2);
+
+    Global<String>& cached = (*names)[slot];
+    if (!cached.IsEmpty())
+      return cached.Get(env()->isolate());
+
+    // The name matched the slot's spelling exactly, so it can be used as-is.
+    Local<String> str = String::NewFromOneByte(
+        env()->isolate(),
+        reinterpret_cast<const uint8_t*>(name.str_),
+        NewStringType::kInternalized,
+        name.size_).ToLocalChecked();
+    cached.Reset(env()->isolate(), str);
+    return str;
+  }
+
+
   Local<Array> CreateHeaders() {
     // There could be extra entries but the max size should be fixed
     Local<Value> headers_v[kMaxHeaderFieldsCount * 2];
 
     for (size_t i = 0; i < num_values_; ++i) {
-      headers_v[i * 2] = fields_[i].ToString(env());
+      headers_v[i * 2] = HeaderNameToString(fields_[i]);
       headers_v[i * 2 + 1] = values_[i].ToString(env());
     }
 
@@ -784,8 +955,50 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+  // Like CreateHeaders(), but only for the names. The values are copied into
+  // a single Buffer instead and turned into strings by JS when needed; see
+  // `IncomingMessage.prototype.headers` in lib/_http_incoming.js.
+  Local<Array> CreateHeaderNames() {
+    Local<Value> names_v[kMaxHeaderFieldsCount];
+
+    for (size_t i = 0; i < num_values_; ++i)
+      names_v[i] = HeaderNameToString(fields_[i]);
+
+    return Array::New(env()->isolate(), names_v, num_values_);
+  }
+
+
+  // The Buffer starts with `num_values_ + 1` uint32 offsets of the values,
+  // relative to the end of that table. The values follow back to back.
+  Local<Object> CreateHeaderValues() {
+    const size_t table_size = (num_values_ + 1) * sizeof(uint32_t);
+    size_t size = table_size;
+    for (size_t i = 0; i < num_values_; ++i)
+      size += values_[i].size_;
+
+    Local<Object> buffer = Buffer::New(env(), size).ToLocalChecked();
+    char* data = Buffer::Data(buffer);
+    uint32_t* offsets = reinterpret_cast<uint32_t*>(data);
+    uint32_t offset = 0;
+
+    for (size_t i = 0; i < num_values_; ++i) {
+      offsets[i] = offset;
+      if (values_[i].size_ > 0)
+        memcpy(data + table_size + offset, values_[i].str_, values_[i].size_);
+      offset += values_[i].size_;
+    }
+    offsets[num_values_] = offset;
+
+    return buffer;
+  }
+
+
   // spill headers and request path to JS land
   void Flush() {
+#ifdef NODE_EXPERIMENTAL_HTTP
+    FlushBatch();
+#endif  /* NODE_EXPERIMENTAL_HTTP */
+
     HandleScope scope(env()->isolate());
 
     Local<Object> obj = object();
@@ -811,10 +1024,109 @@ class Parser : public AsyncWrap, public StreamListener {
   }
 
 
+#ifdef NODE_EXPERIMENTAL_HTTP
+  // Only requests that are complete once their headers are, and that do not
+  // switch protocols, are batched. Everything else goes through the regular
+  // callbacks, so that e.g. the body can be streamed.
+  bool CanBatch() const {
+    return batched_ &&
+           parser_.type == HTTP_REQUEST &&
+           !have_flushed_ &&
+           !parser_.upgrade &&
+           !(parser_.flags & F_CHUNKED) &&
+           parser_.content_length == 0;
+  }
+
+
+  void BatchMessage() {
+    if (batch_count_ == kMaxBatchMessages)
+      FlushBatch();
+
+    // The URL, then the header values with their offset table in front, at
+    // an offset that a Uint32Array can start at.
+    const size_t url_offset = batch_data_.size();
+    batch_data_.insert(batch_data_.end(), url_.str_, url_.str_ + url_.size_);
+    const size_t values_offset =
+        (batch_data_.size() + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1);
+    const size_t table_size = (num_values_ + 1) * sizeof(uint32_t);
+    batch_data_.resize(values_offset + table_size);
+    uint32_t offset = 0;
+    for (size_t i = 0; i <= num_values_; ++i) {
+      memcpy(&batch_data_[values_offset + i * sizeof(offset)],
+             &offset,
+             sizeof(offset));
+      if (i == num_values_)
+        break;
+      batch_data_.insert(batch_data_.end(),
+                         values_[i].str_,
+                         values_[i].str_ + values_[i].size_);
+      offset += values_[i].size_;
+    }
+
+    AliasedBuffer<uint32_t, Uint32Array>& state =
+        *env()->http_parser_batch_state();
+    const size_t base = 1 + batch_count_ * kBatchFieldsPerMessage;
+    state[base + kBatchMethod] = parser_.method;
+    state[base + kBatchVersionMajor] = parser_.http_major;
+    state[base + kBatchVersionMinor] = parser_.http_minor;
+    state[base + kBatchShouldKeepAlive] = llhttp_should_keep_alive(&parser_);
+    state[base + kBatchHeaderCount] = num_values_;
+    state[base + kBatchUrlOffset] = url_offset;
+    state[base + kBatchUrlLength] = url_.size_;
+    state[base + kBatchValuesOffset] = values_offset;
+
+    // The names stay alive through the HandleScope in `Execute()`, which
+    // always flushes the batch before returning.
+    for (size_t i = 0; i < num_values_; ++i)
+      batch_names_.push_back(HeaderNameToString(fields_[i]));
+
+    batch_count_++;
+    in_batch_ = true;
+  }
+
+
+  // The JS callback receives the header names of all messages in one list,
+  // and the Buffer with their URLs and header values.
+  void FlushBatch() {
+    if (batch_count_ == 0)
+      return;
+
+    (*env()->http_parser_batch_state())[0] = batch_count_;
+    Local<Value> argv[] = {
+      Array::New(env()->isolate(), batch_names_.data(), batch_names_.size()),
+      Buffer::Copy(env(), batch_data_.data(), batch_data_.size())
+          .ToLocalChecked()
+    };
+    batch_count_ = 0;
+    batch_names_.clear();
+    batch_data_.clear();
+
+    Local<Value> cb = object()->Get(env()->context(),
+                                    kOnBatch).ToLocalChecked();
+    if (!cb->IsFunction())
+      return;
+
+    Environment::AsyncCallbackScope callback_scope(env());
+
+    MaybeLocal<Value> r = MakeCallback(cb.As<Function>(),
+                                       arraysize(argv),
+                                       argv);
+
+    if (r.IsEmpty())
+      got_exception_ = true;
+  }
+#endif  /* NODE_EXPERIMENTAL_HTTP */
+
+
   void Init(parser_type_t type) {
 #ifdef NODE_EXPERIMENTAL_HTTP
     llhttp_init(&parser_, type, &settings);
     header_nread_ = 0;
+    batched_ = false;
+    in_batch_ = false;
+    batch_count_ = 0;
+    batch_names_.clear();
+    batch_data_.clear();
 #else  /* !NODE_EXPERIMENTAL_HTTP */
     http_parser_init(&parser_, type);
 #endif  /* NODE_EXPERIMENTAL_HTTP */
@@ -824,6 +1136,7 @@ class Parser : public AsyncWrap, public StreamListener {
     num_values_ = 0;
     have_flushed_ = false;
     got_exception_ = false;
+    lazy_headers_ = false;
   }
 
 
@@ -864,6 +1177,7 @@ class Parser : public AsyncWrap, public StreamListener {
   size_t num_values_;
   bool have_flushed_;
   bool got_exception_;
+  bool lazy_headers_;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
   char* current_buffer_data_;
@@ -871,6 +1185,11 @@ class Parser : public AsyncWrap, public StreamListener {
   unsigned int execute_depth_ = 0;
   bool pending_pause_ = false;
   uint64_t header_nread_ = 0;
+  bool batched_ = false;
+  bool in_batch_ = false;
+  size_t batch_count_ = 0;
+  std::vector<Local<Value>> batch_names_;
+  std::vector<char> batch_data_;
 #endif  /* NODE_EXPERIMENTAL_HTTP */
 
   // These are helper functions for filling `http_parser_settings`, which turn
@@ -913,6 +1232,137 @@ const parser_settings_t Parser::settings = {
 };
 
 
+// Characters allowed in header names, i.e. `tchar` in RFC 7230, section 3.2.6.
+// Matches `tokenRegExp` in lib/_http_common.js.
+const uint8_t kTokenChars[256] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x00
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x10
+  0, 1, 0, 1, 1, 1, 1, 1, 0, 0, 1, 1, 0, 1, 1, 0,  // 0x20
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0,  // 0x30
+  0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x40
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 1,  // 0x50
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x60
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 1, 0,  // 0x70
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x80
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x90
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xa0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xb0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xc0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xd0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xe0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0xf0
+};
+
+// Characters allowed in header values: HTAB, SP, VCHAR and obs-text.
+// Matches `headerCharRegex` in lib/_http_common.js.
+const uint8_t kHeaderValueChars[256] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,  // 0x00
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,  // 0x10
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x20
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x30
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x40
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x50
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x60
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0,  // 0x70
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x80
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0x90
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0xa0
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0xb0
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0xc0
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0xd0
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0xe0
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,  // 0xf0
+};
+
+
+// Writes the Latin-1 string `str` to `out` at `*pos`. If `allowed` is not
+// nullptr, each character is checked against it and false is returned for
+// any that is not allowed, including characters outside of Latin-1.
+bool WriteHeaderPart(Isolate* isolate,
+                     Local<String> str,
+                     const uint8_t* allowed,
+                     char* out,
+                     size_t out_len,
+                     size_t* pos) {
+  const int length = str->Length();
+  if (allowed != nullptr && !str->IsOneByte() && !str->ContainsOnlyOneByte())
+    return false;
+
+  CHECK_LE(*pos + length, out_len);
+  uint8_t* dest = reinterpret_cast<uint8_t*>(out + *pos);
+  str->WriteOneByte(isolate, dest, 0, length, String::NO_NULL_TERMINATION);
+
+  if (allowed != nullptr) {
+    for (int i = 0; i < length; i++) {
+      if (!allowed[dest[i]])
+        return false;
+    }
+  }
+
+  *pos += length;
+  return true;
+}
+
+
+// serializeHeaders(buffer, firstLine, fields, validate) writes `firstLine`,
+// a `name: value\r\n` line for each pair in the flat array `fields` and the
+// final CRLF into `buffer`, which must be large enough to hold them.
+// Returns the number of bytes written or, if `validate` is true and a name
+// or value contains characters that are not allowed, -1 minus its index in
+// `fields`.
+void SerializeHeaders(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(Buffer::HasInstance(args[0]));
+  CHECK(args[1]->IsString());
+  CHECK(args[2]->IsArray());
+  const bool validate = args[3]->IsTrue();
+
+  char* out = Buffer::Data(args[0]);
+  const size_t out_len = Buffer::Length(args[0]);
+  Local<Array> fields = args[2].As<Array>();
+  const uint32_t count = fields->Length();
+  CHECK_EQ(count % 2, 0);
+
+  size_t pos = 0;
+  WriteHeaderPart(env->isolate(), args[1].As<String>(), nullptr,
+                  out, out_len, &pos);
+
+  for (uint32_t i = 0; i < count; i += 2) {
+    Local<Value> name = fields->Get(env->context(), i).ToLocalChecked();
+    Local<Value> value = fields->Get(env->context(), i + 1).ToLocalChecked();
+    CHECK(name->IsString());
+    CHECK(value->IsString());
+
+    if ((validate && name.As<String>()->Length() == 0) ||
+        !WriteHeaderPart(env->isolate(), name.As<String>(),
+                         validate ? kTokenChars : nullptr,
+                         out, out_len, &pos)) {
+      return args.GetReturnValue().Set(-1 - static_cast<int32_t>(i));
+    }
+
+    CHECK_LE(pos + 2, out_len);
+    out[pos++] = ':';
+    out[pos++] = ' ';
+
+    if (!WriteHeaderPart(env->isolate(), value.As<String>(),
+                         validate ? kHeaderValueChars : nullptr,
+                         out, out_len, &pos)) {
+      return args.GetReturnValue().Set(-2 - static_cast<int32_t>(i));
+    }
+
+    CHECK_LE(pos + 2, out_len);
+    out[pos++] = '\r';
+    out[pos++] = '\n';
+  }
+
+  CHECK_LE(pos + 2, out_len);
+  out[pos++] = '\r';
+  out[pos++] = '\n';
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(pos));
+}
+
+
 #ifndef NODE_EXPERIMENTAL_HTTP
 void InitMaxHttpHeaderSizeOnce() {
   const uint32_t max_http_header_size =
@@ -945,6 +1395,8 @@ void InitializeHttpParser(Local<Object> target,
          Integer::NewFromUnsigned(env->isolate(), kOnMessageComplete));
   t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnExecute"),
          Integer::NewFromUnsigned(env->isolate(), kOnExecute));
+  t->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "kOnBatch"),
+         Integer::NewFromUnsigned(env->isolate(), kOnBatch));
 
   Local<Array> methods = Array::New(env->isolate());
 #define V(num, name, string)                                                  \
@@ -956,6 +1408,17 @@ void InitializeHttpParser(Local<Object> target,
               FIXED_ONE_BYTE_STRING(env->isolate(), "methods"),
               methods).FromJust();
 
+#ifdef NODE_EXPERIMENTAL_HTTP
+  if (env->http_parser_batch_state() == nullptr) {
+    env->set_http_parser_batch_state(
+        std::make_unique<AliasedBuffer<uint32_t, Uint32Array>>(
+            env->isolate(), kBatchStateSize));
+  }
+  target->Set(env->context(),
+              FIXED_ONE_BYTE_STRING(env->isolate(), "batchState"),
+              env->http_parser_batch_state()->GetJSArray()).FromJust();
+#endif  /* NODE_EXPERIMENTAL_HTTP */
+
   t->Inherit(AsyncWrap::GetConstructorTemplate(env));
   env->SetProtoMethod(t, "close", Parser::Close);
   env->SetProtoMethod(t, "free", Parser::Free);
@@ -968,6 +1431,8 @@ void InitializeHttpParser(Local<Object> target,
   env->SetProtoMethod(t, "unconsume", Parser::Unconsume);
   env->SetProtoMethod(t, "getCurrentBuffer", Parser::GetCurrentBuffer);
 
+  env->SetMethod(target, "serializeHeaders", SerializeHeaders);
+
   target->Set(env->context(),
               FIXED_ONE_BYTE_STRING(env->isolate(), "HTTPParser"),
               t->GetFunction(env->context()).ToLocalChecked()).FromJust();
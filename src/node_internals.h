@@ -305,9 +305,29 @@ class InternalCallbackScope {
   bool closed_ = false;
 };
 
+// The libuv threadpools that work can be scheduled on. Pools that have not
+// been given a size through --threadpool-size share the default pool.
+enum class ThreadPoolKind : unsigned int {
+  kDefault = UV_THREADPOOL_DEFAULT,
+  kFs = UV_THREADPOOL_FS,
+  kDns = UV_THREADPOOL_DNS,
+  kCrypto = UV_THREADPOOL_USER,
+  kCompression,
+  kUser
+};
+
+namespace performance {
+// Records how long |req| waited for and ran on the threadpool under |name|.
+void RecordThreadPoolWork(Environment* env,
+                          const char* name,
+                          const uv_req_t* req);
+}  // namespace performance
+
 class ThreadPoolWork {
  public:
-  explicit inline ThreadPoolWork(Environment* env) : env_(env) {
+  // |name| identifies the kind of work in the threadpool metrics.
+  inline ThreadPoolWork(Environment* env, ThreadPoolKind kind, const char* name)
+      : env_(env), kind_(kind), name_(name) {
     CHECK_NOT_NULL(env);
   }
   inline virtual ~ThreadPoolWork() = default;
@@ -320,14 +340,17 @@ class ThreadPoolWork {
 
  private:
   Environment* env_;
+  ThreadPoolKind kind_;
+  const char* name_;
   uv_work_t work_req_;
 };
 
 void ThreadPoolWork::ScheduleWork() {
   env_->IncreaseWaitingRequestCounter();
-  int status = uv_queue_work(
+  int status = uv_queue_work_in(
       env_->event_loop(),
       &work_req_,
+      static_cast<unsigned int>(kind_),
       [](uv_work_t* req) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         self->DoThreadPoolWork();
@@ -335,6 +358,8 @@ void ThreadPoolWork::ScheduleWork() {
       [](uv_work_t* req, int status) {
         ThreadPoolWork* self = ContainerOf(&ThreadPoolWork::work_req_, req);
         self->env_->DecreaseWaitingRequestCounter();
+        performance::RecordThreadPoolWork(
+            self->env_, self->name_, reinterpret_cast<uv_req_t*>(req));
         self->AfterThreadPoolWork(status);
       });
   CHECK_EQ(status, 0);
@@ -255,6 +255,12 @@ PerIsolateOptionsParser::PerIsolateOptionsParser() {
 const PerIsolateOptionsParser PerIsolateOptionsParser::instance;
 
 PerProcessOptionsParser::PerProcessOptionsParser() {
+  AddOption("--threadpool-size",
+            "comma separated list of pool:size pairs that size libuv's "
+            "threadpools (pools: default, fs, dns, crypto, compression, "
+            "user)",
+            &PerProcessOptions::threadpool_size,
+            kAllowedInEnvironment);
   AddOption("--title",
             "the process title to use on startup",
             &PerProcessOptions::title,
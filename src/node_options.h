@@ -150,6 +150,7 @@ class PerProcessOptions : public Options {
  public:
   std::shared_ptr<PerIsolateOptions> per_isolate { new PerIsolateOptions() };
 
+  std::string threadpool_size;
   std::string title;
   std::string trace_event_categories;
   std::string trace_event_file_pattern = "node_trace.${rotation}.log";
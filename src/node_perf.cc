@@ -1,5 +1,9 @@
 #include "node_internals.h"
 #include "node_perf.h"
+#include "node_process.h"
+#include "tracing/traced_value.h"
+
+#include <cinttypes>
 
 #ifdef __POSIX__
 #include <sys/time.h>  // gettimeofday
@@ -17,9 +21,11 @@ using v8::FunctionTemplate;
 using v8::GCCallbackFlags;
 using v8::GCType;
 using v8::HandleScope;
+using v8::Int32;
 using v8::Integer;
 using v8::Isolate;
 using v8::Local;
+using v8::Map;
 using v8::Name;
 using v8::NewStringType;
 using v8::Number;
@@ -373,6 +379,303 @@ void Timerify(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(wrap);
 }
 
+// Event Loop Utilization
+
+// Returns the time, in milliseconds, that the event loop has spent blocked
+// waiting for I/O.
+static void LoopIdleTime(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  uint64_t idle_time = uv_metrics_idle_time(env->event_loop());
+  args.GetReturnValue().Set(idle_time / 1e6);
+}
+
+// Copies the iteration count and the time, in milliseconds, spent in each
+// phase of the event loop to the loopMetrics array.
+static void RefreshLoopMetrics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  AliasedBuffer<double, v8::Float64Array>& loop_metrics =
+      env->performance_state()->loop_metrics;
+  uv_loop_metrics_t metrics;
+  CHECK_EQ(0, uv_loop_metrics(env->event_loop(), &metrics));
+  loop_metrics[0] = static_cast<double>(metrics.iterations);
+  for (size_t i = 0; i < UV_LOOP_PHASE_MAX; i++)
+    loop_metrics[i + 1] = metrics.phase_time[i] / 1e6;
+}
+
+void TraceLoopIteration(Environment* env) {
+  if (*TRACE_EVENT_API_GET_CATEGORY_GROUP_ENABLED(
+      TRACING_CATEGORY_NODE2(perf, event_loop)) == 0) {
+    return;
+  }
+
+  uv_loop_metrics_t metrics;
+  CHECK_EQ(0, uv_loop_metrics(env->event_loop(), &metrics));
+  uv_loop_metrics_t* last =
+      &env->performance_state()->last_traced_loop_metrics;
+
+  // Time spent in each phase since the previous event, in microseconds.
+  auto data = tracing::TracedValue::Create();
+  data->SetDouble("iteration", static_cast<double>(metrics.iterations));
+#define V(name, label)                                                        \
+  data->SetDouble(label, (metrics.phase_time[UV_LOOP_PHASE_##name] -          \
+                          last->phase_time[UV_LOOP_PHASE_##name]) / 1e3);
+  NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+  *last = metrics;
+
+  TRACE_EVENT_INSTANT1(TRACING_CATEGORY_NODE2(perf, event_loop),
+                       "LoopIteration", TRACE_EVENT_SCOPE_THREAD,
+                       "data", std::move(data));
+}
+
+// Threadpool Work Metrics
+
+// Up to an hour with a relative error of 1/32, which keeps every histogram
+// under 10 KB.
+ThreadPoolWorkMetrics::ThreadPoolWorkMetrics()
+    : queue_wait_(int64_t{3600} * 1000 * 1000, 5),
+      run_time_(int64_t{3600} * 1000 * 1000, 5) {}
+
+// libuv records the stages after submission with microsecond resolution.
+void ThreadPoolWorkMetrics::Record(const uv_work_timing_t& timing) {
+  queue_wait_.Record((timing.start_time - timing.submit_time) / 1000);
+  run_time_.Record((timing.end_time - timing.start_time) / 1000);
+}
+
+void RecordThreadPoolWork(Environment* env,
+                          const char* name,
+                          const uv_req_t* req) {
+  uv_work_timing_t timing;
+  // Skip requests that did not run on the threadpool, e.g. fs requests that
+  // were served by io_uring, and work that was cancelled before it started.
+  if (uv_req_get_work_timing(req, &timing) != 0 || timing.start_time == 0)
+    return;
+
+  auto& metrics = env->performance_state()->threadpool_work;
+  auto it = metrics.find(name);
+  if (it == metrics.end()) {
+    it = metrics.emplace(name, std::unique_ptr<ThreadPoolWorkMetrics>(
+        new ThreadPoolWorkMetrics())).first;
+  }
+  it->second->Record(timing);
+
+  // A span from submission to completion with the time spent running on a
+  // thread nested inside it.
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+      TRACING_CATEGORY_NODE2(perf, threadpool),
+      name, req, timing.submit_time / 1000);
+  TRACE_EVENT_NESTABLE_ASYNC_BEGIN_WITH_TIMESTAMP0(
+      TRACING_CATEGORY_NODE2(perf, threadpool),
+      "run", req, timing.start_time / 1000);
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+      TRACING_CATEGORY_NODE2(perf, threadpool),
+      "run", req, timing.end_time / 1000);
+  TRACE_EVENT_NESTABLE_ASYNC_END_WITH_TIMESTAMP0(
+      TRACING_CATEGORY_NODE2(perf, threadpool),
+      name, req, timing.done_time / 1000);
+}
+
+static Local<Object> HistogramToObject(Environment* env,
+                                       const Histogram& histogram) {
+  Local<Context> context = env->context();
+  Local<Object> obj = Object::New(env->isolate());
+  auto set = [&](const char* name, double value) {
+    obj->Set(context,
+             OneByteString(env->isolate(), name),
+             Number::New(env->isolate(), value)).FromJust();
+  };
+  set("min", static_cast<double>(histogram.Min()));
+  set("max", static_cast<double>(histogram.Max()));
+  set("mean", histogram.Mean());
+  set("stddev", histogram.Stddev());
+  set("p50", static_cast<double>(histogram.Percentile(50)));
+  set("p90", static_cast<double>(histogram.Percentile(90)));
+  set("p99", static_cast<double>(histogram.Percentile(99)));
+  return obj;
+}
+
+// Returns an object with the queue wait and run time statistics for every
+// kind of threadpool work that has completed so far, keyed by its name.
+static void GetThreadPoolMetrics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Isolate* isolate = env->isolate();
+  Local<Context> context = env->context();
+  Local<Object> result = Object::New(isolate);
+
+  for (const auto& entry : env->performance_state()->threadpool_work) {
+    const ThreadPoolWorkMetrics& metrics = *entry.second;
+    Local<Object> obj = Object::New(isolate);
+    obj->Set(context,
+             FIXED_ONE_BYTE_STRING(isolate, "count"),
+             Number::New(isolate, static_cast<double>(
+                 metrics.run_time().Count()))).FromJust();
+    obj->Set(context,
+             FIXED_ONE_BYTE_STRING(isolate, "queueWait"),
+             HistogramToObject(env, metrics.queue_wait())).FromJust();
+    obj->Set(context,
+             FIXED_ONE_BYTE_STRING(isolate, "runTime"),
+             HistogramToObject(env, metrics.run_time())).FromJust();
+    result->Set(context,
+                OneByteString(isolate, entry.first.c_str()),
+                obj).FromJust();
+  }
+
+  args.GetReturnValue().Set(result);
+}
+
+static void ResetThreadPoolMetrics(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  env->performance_state()->threadpool_work.clear();
+}
+
+// Event Loop Timing Histogram
+namespace {
+static void ELDHistogramMin(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value = static_cast<double>(histogram->Min());
+  args.GetReturnValue().Set(value);
+}
+
+static void ELDHistogramMax(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value = static_cast<double>(histogram->Max());
+  args.GetReturnValue().Set(value);
+}
+
+static void ELDHistogramMean(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Mean());
+}
+
+static void ELDHistogramExceeds(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  double value = static_cast<double>(histogram->Exceeds());
+  args.GetReturnValue().Set(value);
+}
+
+static void ELDHistogramStddev(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Stddev());
+}
+
+static void ELDHistogramPercentile(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsNumber());
+  double percentile = args[0].As<Number>()->Value();
+  double value = static_cast<double>(histogram->Percentile(percentile));
+  args.GetReturnValue().Set(value);
+}
+
+static void ELDHistogramPercentiles(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  CHECK(args[0]->IsMap());
+  Local<Map> map = args[0].As<Map>();
+  histogram->Percentiles([&](double key, int64_t value) {
+    map->Set(env->context(),
+             Number::New(env->isolate(), key),
+             Number::New(env->isolate(), static_cast<double>(value)))
+                 .ToLocalChecked();
+  });
+}
+
+static void ELDHistogramEnable(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Enable());
+}
+
+static void ELDHistogramDisable(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  args.GetReturnValue().Set(histogram->Disable());
+}
+
+static void ELDHistogramReset(const FunctionCallbackInfo<Value>& args) {
+  ELDHistogram* histogram;
+  ASSIGN_OR_RETURN_UNWRAP(&histogram, args.Holder());
+  histogram->ResetState();
+}
+
+static void ELDHistogramNew(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args.IsConstructCall());
+  CHECK(args[0]->IsInt32());
+  int32_t resolution = args[0].As<Int32>()->Value();
+  CHECK_GT(resolution, 0);
+  new ELDHistogram(env, args.This(), resolution);
+}
+}  // namespace
+
+// Delays of up to an hour are recorded, anything beyond that only counts
+// towards exceeds().
+ELDHistogram::ELDHistogram(
+    Environment* env,
+    Local<Object> wrap,
+    int32_t resolution) : HandleWrap(env,
+                                     wrap,
+                                     reinterpret_cast<uv_handle_t*>(&timer_),
+                                     AsyncWrap::PROVIDER_ELDHISTOGRAM),
+                          Histogram(int64_t{3600} * 1000 * 1000 * 1000),
+                          resolution_(resolution) {
+  timer_.data = this;
+  uv_timer_init(env->event_loop(), &timer_);
+}
+
+void ELDHistogram::DelayIntervalCallback(uv_timer_t* req) {
+  ELDHistogram* histogram = static_cast<ELDHistogram*>(req->data);
+  histogram->RecordDelta();
+}
+
+// The delay is how much later than scheduled the timer fired, measured with
+// uv_hrtime() rather than the millisecond loop clock.
+bool ELDHistogram::RecordDelta() {
+  uint64_t time = uv_hrtime();
+  bool ret = true;
+  if (prev_ > 0) {
+    int64_t delta = time - prev_ - int64_t{resolution_} * 1000 * 1000;
+    if (delta < 0)
+      delta = 0;
+    ret = Record(delta);
+    if (!ret) {
+      exceeds_++;
+      ProcessEmitWarning(
+          env(),
+          "Event loop delay exceeded 1 hour: %" PRId64 " nanoseconds",
+          delta);
+    }
+  }
+  prev_ = time;
+  return ret;
+}
+
+bool ELDHistogram::Enable() {
+  if (enabled_) return false;
+  enabled_ = true;
+  uv_timer_start(&timer_,
+                 DelayIntervalCallback,
+                 resolution_,
+                 resolution_);
+  // Sampling alone must not keep the process alive.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&timer_));
+  return true;
+}
+
+bool ELDHistogram::Disable() {
+  if (!enabled_) return false;
+  enabled_ = false;
+  prev_ = 0;
+  uv_timer_stop(&timer_);
+  return true;
+}
+
 
 void Initialize(Local<Object> target,
                 Local<Value> unused,
@@ -388,6 +691,19 @@ void Initialize(Local<Object> target,
   target->Set(context,
               FIXED_ONE_BYTE_STRING(isolate, "milestones"),
               state->milestones.GetJSArray()).FromJust();
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "loopMetrics"),
+              state->loop_metrics.GetJSArray()).FromJust();
+
+  Local<Value> loop_phases[] = {
+#define V(_, label) FIXED_ONE_BYTE_STRING(isolate, label),
+    NODE_PERFORMANCE_LOOP_PHASES(V)
+#undef V
+  };
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(isolate, "loopPhases"),
+              Array::New(isolate, loop_phases,
+                         arraysize(loop_phases))).FromJust();
 
   Local<String> performanceEntryString =
       FIXED_ONE_BYTE_STRING(isolate, "PerformanceEntry");
@@ -404,6 +720,10 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "markMilestone", MarkMilestone);
   env->SetMethod(target, "setupObservers", SetupPerformanceObservers);
   env->SetMethod(target, "timerify", Timerify);
+  env->SetMethod(target, "loopIdleTime", LoopIdleTime);
+  env->SetMethod(target, "refreshLoopMetrics", RefreshLoopMetrics);
+  env->SetMethod(target, "getThreadPoolMetrics", GetThreadPoolMetrics);
+  env->SetMethod(target, "resetThreadPoolMetrics", ResetThreadPoolMetrics);
 
   Local<Object> constants = Object::New(isolate);
 
@@ -436,6 +756,25 @@ void Initialize(Local<Object> target,
       Number::New(isolate, timeOriginTimestamp / MICROS_PER_MILLIS),
       attr).ToChecked();
 
+  Local<String> eldh_classname = FIXED_ONE_BYTE_STRING(isolate, "ELDHistogram");
+  Local<FunctionTemplate> eldh =
+      env->NewFunctionTemplate(ELDHistogramNew);
+  eldh->SetClassName(eldh_classname);
+  eldh->InstanceTemplate()->SetInternalFieldCount(1);
+  eldh->Inherit(HandleWrap::GetConstructorTemplate(env));
+  env->SetProtoMethod(eldh, "exceeds", ELDHistogramExceeds);
+  env->SetProtoMethod(eldh, "min", ELDHistogramMin);
+  env->SetProtoMethod(eldh, "max", ELDHistogramMax);
+  env->SetProtoMethod(eldh, "mean", ELDHistogramMean);
+  env->SetProtoMethod(eldh, "stddev", ELDHistogramStddev);
+  env->SetProtoMethod(eldh, "percentile", ELDHistogramPercentile);
+  env->SetProtoMethod(eldh, "percentiles", ELDHistogramPercentiles);
+  env->SetProtoMethod(eldh, "enable", ELDHistogramEnable);
+  env->SetProtoMethod(eldh, "disable", ELDHistogramDisable);
+  env->SetProtoMethod(eldh, "reset", ELDHistogramReset);
+  target->Set(context, eldh_classname,
+              eldh->GetFunction(env->context()).ToLocalChecked()).FromJust();
+
   target->DefineOwnProperty(context,
                             env->constants_string(),
                             constants,
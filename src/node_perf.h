@@ -8,6 +8,8 @@
 #include "node_perf_common.h"
 #include "env.h"
 #include "base_object-inl.h"
+#include "handle_wrap.h"
+#include "histogram-inl.h"
 
 #include "v8.h"
 #include "uv.h"
@@ -27,6 +29,10 @@ extern const uint64_t timeOrigin;
 
 double GetCurrentTimeInMicroseconds();
 
+// Emits a node.perf.event_loop trace event with the time spent in each
+// phase of the event loop since the previous one.
+void TraceLoopIteration(Environment* env);
+
 static inline const char* GetPerformanceMilestoneName(
     enum PerformanceMilestone milestone) {
   switch (milestone) {
@@ -126,6 +132,41 @@ class GCPerformanceEntry : public PerformanceEntry {
   PerformanceGCKind gckind_;
 };
 
+// Samples how late a repeating timer fires to build up a histogram of the
+// event loop's delay, in nanoseconds.
+class ELDHistogram : public HandleWrap, public Histogram {
+ public:
+  ELDHistogram(Environment* env,
+               Local<Object> wrap,
+               int32_t resolution);
+
+  bool RecordDelta();
+  bool Enable();
+  bool Disable();
+  void ResetState() {
+    Reset();
+    exceeds_ = 0;
+    prev_ = 0;
+  }
+  int64_t Exceeds() const { return exceeds_; }
+
+  void MemoryInfo(MemoryTracker* tracker) const override {
+    tracker->TrackFieldWithSize("histogram", GetMemorySize());
+  }
+
+  SET_MEMORY_INFO_NAME(ELDHistogram)
+  SET_SELF_SIZE(ELDHistogram)
+
+ private:
+  static void DelayIntervalCallback(uv_timer_t* req);
+
+  bool enabled_ = false;
+  int32_t resolution_ = 0;
+  int64_t exceeds_ = 0;
+  uint64_t prev_ = 0;
+  uv_timer_t timer_;
+};
+
 }  // namespace performance
 }  // namespace node
 
@@ -4,10 +4,12 @@
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
 #include "node.h"
+#include "histogram.h"
 #include "v8.h"
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <string>
 
 namespace node {
@@ -29,6 +31,16 @@ extern uint64_t performance_v8_start;
   V(BOOTSTRAP_COMPLETE, "bootstrapComplete")
 
 
+// The phases of an event loop iteration, in uv_loop_phase order.
+#define NODE_PERFORMANCE_LOOP_PHASES(V)                                       \
+  V(TIMERS, "timers")                                                         \
+  V(PENDING, "pending")                                                       \
+  V(PREPARE, "prepare")                                                       \
+  V(POLL_WAIT, "pollWait")                                                    \
+  V(POLL, "poll")                                                             \
+  V(CHECK, "check")                                                           \
+  V(CLOSING, "closing")
+
 #define NODE_PERFORMANCE_ENTRY_TYPES(V)                                       \
   V(NODE, "node")                                                             \
   V(MARK, "mark")                                                             \
@@ -37,6 +49,22 @@ extern uint64_t performance_v8_start;
   V(FUNCTION, "function")                                                     \
   V(HTTP2, "http2")
 
+// How long one kind of threadpool work waited for a thread and how long it
+// ran, in microseconds.
+class ThreadPoolWorkMetrics {
+ public:
+  ThreadPoolWorkMetrics();
+
+  void Record(const uv_work_timing_t& timing);
+
+  const Histogram& queue_wait() const { return queue_wait_; }
+  const Histogram& run_time() const { return run_time_; }
+
+ private:
+  Histogram queue_wait_;
+  Histogram run_time_;
+};
+
 enum PerformanceMilestone {
 #define V(name, _) NODE_PERFORMANCE_MILESTONE_##name,
   NODE_PERFORMANCE_MILESTONES(V)
@@ -62,6 +90,11 @@ class performance_state {
       offsetof(performance_state_internal, milestones),
       NODE_PERFORMANCE_MILESTONE_INVALID,
       root),
+    loop_metrics(
+      isolate,
+      offsetof(performance_state_internal, loop_metrics),
+      UV_LOOP_PHASE_MAX + 1,
+      root),
     observers(
       isolate,
       offsetof(performance_state_internal, observers),
@@ -73,9 +106,15 @@ class performance_state {
 
   AliasedBuffer<uint8_t, v8::Uint8Array> root;
   AliasedBuffer<double, v8::Float64Array> milestones;
+  // The loop iteration count, followed by the time spent in each phase.
+  AliasedBuffer<double, v8::Float64Array> loop_metrics;
   AliasedBuffer<uint32_t, v8::Uint32Array> observers;
 
   uint64_t performance_last_gc_start_mark = 0;
+  uv_loop_metrics_t last_traced_loop_metrics = {};
+  // Keyed by the name passed to RecordThreadPoolWork().
+  std::map<std::string, std::unique_ptr<ThreadPoolWorkMetrics>, std::less<>>
+      threadpool_work;
 
   void Mark(enum PerformanceMilestone milestone,
             uint64_t ts = PERFORMANCE_NOW());
@@ -84,6 +123,7 @@ class performance_state {
   struct performance_state_internal {
     // doubles first so that they are always sizeof(double)-aligned
     double milestones[NODE_PERFORMANCE_MILESTONE_INVALID];
+    double loop_metrics[UV_LOOP_PHASE_MAX + 1];
     uint32_t observers[NODE_PERFORMANCE_ENTRY_TYPE_INVALID];
   };
 };
@@ -19,7 +19,7 @@ using node::tracing::TracingController;
 namespace {
 
 struct PlatformWorkerData {
-  TaskQueue<Task>* task_queue;
+  WorkerTaskQueue* task_queue;
   Mutex* platform_workers_mutex;
   ConditionVariable* platform_workers_ready;
   int* pending_platform_workers;
@@ -30,7 +30,8 @@ static void PlatformWorkerThread(void* data) {
   std::unique_ptr<PlatformWorkerData>
       worker_data(static_cast<PlatformWorkerData*>(data));
 
-  TaskQueue<Task>* pending_worker_tasks = worker_data->task_queue;
+  WorkerTaskQueue* pending_worker_tasks = worker_data->task_queue;
+  const int id = worker_data->id;
   TRACE_EVENT_METADATA1("__metadata", "thread_name", "name",
                         "PlatformWorkerThread");
 
@@ -41,7 +42,7 @@ static void PlatformWorkerThread(void* data) {
     worker_data->platform_workers_ready->Signal(lock);
   }
 
-  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop()) {
+  while (std::unique_ptr<Task> task = pending_worker_tasks->BlockingPop(id)) {
     task->Run();
     pending_worker_tasks->NotifyOfCompletion();
   }
@@ -51,7 +52,7 @@ static void PlatformWorkerThread(void* data) {
 
 class WorkerThreadsTaskRunner::DelayedTaskScheduler {
  public:
-  explicit DelayedTaskScheduler(TaskQueue<Task>* tasks)
+  explicit DelayedTaskScheduler(WorkerTaskQueue* tasks)
     : pending_worker_tasks_(tasks) {}
 
   std::unique_ptr<uv_thread_t> Start() {
@@ -158,7 +159,7 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   }
 
   uv_sem_t ready_;
-  TaskQueue<v8::Task>* pending_worker_tasks_;
+  WorkerTaskQueue* pending_worker_tasks_;
 
   TaskQueue<v8::Task> tasks_;
   uv_loop_t loop_;
@@ -166,7 +167,8 @@ class WorkerThreadsTaskRunner::DelayedTaskScheduler {
   std::unordered_set<uv_timer_t*> timers_;
 };
 
-WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
+WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size)
+    : pending_worker_tasks_(thread_pool_size) {
   Mutex platform_workers_mutex;
   ConditionVariable platform_workers_ready;
 
@@ -183,10 +185,9 @@ WorkerThreadsTaskRunner::WorkerThreadsTaskRunner(int thread_pool_size) {
       &platform_workers_ready, &pending_platform_workers, i
     };
     std::unique_ptr<uv_thread_t> t { new uv_thread_t() };
-    if (uv_thread_create(t.get(), PlatformWorkerThread,
-                         worker_data) != 0) {
-      break;
-    }
+    // Every thread owns one of the queue's shards, and we wait for all of
+    // them to start below, so there is no running without one.
+    CHECK_EQ(0, uv_thread_create(t.get(), PlatformWorkerThread, worker_data));
     threads_.push_back(std::move(t));
   }
 
@@ -229,6 +230,14 @@ PerIsolatePlatformData::PerIsolatePlatformData(
   CHECK_EQ(0, uv_async_init(loop, flush_tasks_, FlushTasks));
   flush_tasks_->data = static_cast<void*>(this);
   uv_unref(reinterpret_cast<uv_handle_t*>(flush_tasks_));
+
+  // Idle tasks may be posted from any thread, so rather than starting and
+  // stopping the handle on demand it stays active and checks the queue.
+  idle_tasks_prepare_ = new uv_prepare_t();
+  CHECK_EQ(0, uv_prepare_init(loop, idle_tasks_prepare_));
+  idle_tasks_prepare_->data = static_cast<void*>(this);
+  CHECK_EQ(0, uv_prepare_start(idle_tasks_prepare_, RunIdleTasks));
+  uv_unref(reinterpret_cast<uv_handle_t*>(idle_tasks_prepare_));
 }
 
 void PerIsolatePlatformData::FlushTasks(uv_async_t* handle) {
@@ -237,7 +246,8 @@ void PerIsolatePlatformData::FlushTasks(uv_async_t* handle) {
 }
 
 void PerIsolatePlatformData::PostIdleTask(std::unique_ptr<v8::IdleTask> task) {
-  UNREACHABLE();
+  CHECK_NE(idle_tasks_prepare_, nullptr);
+  idle_tasks_.Push(std::move(task));
 }
 
 void PerIsolatePlatformData::PostTask(std::unique_ptr<Task> task) {
@@ -273,6 +283,14 @@ void PerIsolatePlatformData::Shutdown() {
     delete reinterpret_cast<uv_async_t*>(handle);
   });
   flush_tasks_ = nullptr;
+
+  // Idle tasks are optional work; drop whatever did not get to run.
+  idle_tasks_.PopAll();
+  uv_close(reinterpret_cast<uv_handle_t*>(idle_tasks_prepare_),
+           [](uv_handle_t* handle) {
+    delete reinterpret_cast<uv_prepare_t*>(handle);
+  });
+  idle_tasks_prepare_ = nullptr;
 }
 
 void PerIsolatePlatformData::ref() {
@@ -338,6 +356,45 @@ void PerIsolatePlatformData::RunForegroundTask(std::unique_ptr<Task> task) {
   task->Run();
 }
 
+void PerIsolatePlatformData::RunIdleTasks(uv_prepare_t* handle) {
+  // Chrome hands out idle periods of at most 50 ms too, so that a long task
+  // can't delay input that arrives while the loop thinks it's idle.
+  static const int64_t kMaxIdlePeriodMillis = 50;
+
+  auto platform_data = static_cast<PerIsolatePlatformData*>(handle->data);
+  uv_loop_t* loop = platform_data->loop_;
+
+  // This is how long the poll phase is going to block for. 0 means that
+  // there is more work to do right away, e.g. pending immediates.
+  int64_t idle_millis = uv_backend_timeout(loop);
+  if (idle_millis == 0)
+    return;
+  if (idle_millis < 0 || idle_millis > kMaxIdlePeriodMillis)
+    idle_millis = kMaxIdlePeriodMillis;
+
+  // The loop's time and uv_hrtime(), which MonotonicallyIncreasingTime() is
+  // based on, use the same clock.
+  const double deadline_in_seconds = (uv_now(loop) + idle_millis) / 1e3;
+  bool ran_tasks = false;
+  while (uv_hrtime() / 1e9 < deadline_in_seconds) {
+    std::unique_ptr<v8::IdleTask> task = platform_data->idle_tasks_.Pop();
+    if (!task)
+      break;
+    Isolate* isolate = Isolate::GetCurrent();
+    HandleScope scope(isolate);
+    Environment* env = Environment::GetCurrent(isolate);
+    InternalCallbackScope cb_scope(env, Local<Object>(), { 0, 0 },
+                                   InternalCallbackScope::kAllowEmptyResource);
+    task->Run(deadline_in_seconds);
+    ran_tasks = true;
+  }
+
+  // The poll phase computes its timeout from the loop's time, which would
+  // otherwise not include the time spent here, and timers would fire late.
+  if (ran_tasks)
+    uv_update_time(loop);
+}
+
 void PerIsolatePlatformData::DeleteFromScheduledTasks(DelayedTask* task) {
   auto it = std::find_if(scheduled_delayed_tasks_.begin(),
                          scheduled_delayed_tasks_.end(),
@@ -441,7 +498,9 @@ void NodePlatform::CancelPendingDelayedTasks(v8::Isolate* isolate) {
   ForIsolate(isolate)->CancelPendingDelayedTasks();
 }
 
-bool NodePlatform::IdleTasksEnabled(Isolate* isolate) { return false; }
+bool NodePlatform::IdleTasksEnabled(Isolate* isolate) {
+  return ForIsolate(isolate)->IdleTasksEnabled();
+}
 
 std::shared_ptr<v8::TaskRunner>
 NodePlatform::GetForegroundTaskRunner(Isolate* isolate) {
@@ -462,72 +521,192 @@ TracingController* NodePlatform::GetTracingController() {
 }
 
 template <class T>
-TaskQueue<T>::TaskQueue()
-    : lock_(), tasks_available_(), tasks_drained_(),
-      outstanding_tasks_(0), stopped_(false), task_queue_() { }
+TaskQueue<T>::~TaskQueue() {
+  Node* node = pushed_.exchange(nullptr);
+  while (node != nullptr) {
+    Node* next = node->next;
+    delete node;
+    node = next;
+  }
+}
 
 template <class T>
 void TaskQueue<T>::Push(std::unique_ptr<T> task) {
-  Mutex::ScopedLock scoped_lock(lock_);
-  outstanding_tasks_++;
-  task_queue_.push(std::move(task));
-  tasks_available_.Signal(scoped_lock);
+  Node* node = new Node { std::move(task), pushed_.load() };
+  while (!pushed_.compare_exchange_weak(node->next, node)) {}
+}
+
+template <class T>
+void TaskQueue<T>::TakePushed() {
+  Node* node = pushed_.exchange(nullptr);
+  Node* reversed = nullptr;
+  while (node != nullptr) {
+    Node* next = node->next;
+    node->next = reversed;
+    reversed = node;
+    node = next;
+  }
+  while (reversed != nullptr) {
+    Node* next = reversed->next;
+    popped_.push(std::move(reversed->task));
+    delete reversed;
+    reversed = next;
+  }
 }
 
 template <class T>
 std::unique_ptr<T> TaskQueue<T>::Pop() {
-  Mutex::ScopedLock scoped_lock(lock_);
-  if (task_queue_.empty()) {
+  if (popped_.empty())
+    TakePushed();
+  if (popped_.empty())
     return std::unique_ptr<T>(nullptr);
-  }
-  std::unique_ptr<T> result = std::move(task_queue_.front());
-  task_queue_.pop();
+  std::unique_ptr<T> result = std::move(popped_.front());
+  popped_.pop();
   return result;
 }
 
 template <class T>
-std::unique_ptr<T> TaskQueue<T>::BlockingPop() {
-  Mutex::ScopedLock scoped_lock(lock_);
-  while (task_queue_.empty() && !stopped_) {
-    tasks_available_.Wait(scoped_lock);
+std::queue<std::unique_ptr<T>> TaskQueue<T>::PopAll() {
+  TakePushed();
+  std::queue<std::unique_ptr<T>> result;
+  result.swap(popped_);
+  return result;
+}
+
+WorkerTaskQueue::WorkerTaskQueue(int thread_count) {
+  // Tasks posted with no threads to run them still need somewhere to go.
+  for (int i = 0; i < std::max(thread_count, 1); i++)
+    shards_.emplace_back(new Shard());
+  idle_threads_.reserve(shards_.size());
+}
+
+void WorkerTaskQueue::Push(std::unique_ptr<Task> task) {
+  outstanding_tasks_++;
+
+  int shard = PopIdleThread();
+  const bool handed_off = shard != -1;
+  if (!handed_off)
+    shard = next_shard_++ % shards_.size();
+
+  // Wake up the owner even when it isn't idle: it may have looked for work
+  // just before we picked its queue and be about to go to sleep.
+  {
+    Shard* target = shards_[shard].get();
+    Mutex::ScopedLock scoped_lock(target->lock);
+    target->tasks.push_back(std::move(task));
+    target->tasks_available.Signal(scoped_lock);
   }
-  if (stopped_) {
-    return std::unique_ptr<T>(nullptr);
+
+  // Another thread may have gone idle after PopIdleThread() looked, but
+  // before the task was queued, and missed it when it looked at the queues
+  // for the last time. It has advertised itself by now, since that was
+  // before it took the lock we just released, so wake it up to steal the
+  // task. Threads that go idle later see it when they look.
+  if (!handed_off) {
+    int idle = PopIdleThread();
+    if (idle != -1)
+      Wake(idle);
   }
-  std::unique_ptr<T> result = std::move(task_queue_.front());
-  task_queue_.pop();
+}
+
+void WorkerTaskQueue::Wake(int thread) {
+  Shard* target = shards_[thread].get();
+  Mutex::ScopedLock scoped_lock(target->lock);
+  target->wakeup = true;
+  target->tasks_available.Signal(scoped_lock);
+}
+
+std::unique_ptr<Task> WorkerTaskQueue::Pop(int shard) {
+  Shard* source = shards_[shard].get();
+  Mutex::ScopedLock scoped_lock(source->lock);
+  if (source->tasks.empty())
+    return std::unique_ptr<Task>(nullptr);
+  std::unique_ptr<Task> result = std::move(source->tasks.front());
+  source->tasks.pop_front();
   return result;
 }
 
-template <class T>
-void TaskQueue<T>::NotifyOfCompletion() {
-  Mutex::ScopedLock scoped_lock(lock_);
+std::unique_ptr<Task> WorkerTaskQueue::Steal(int thief) {
+  const int count = shards_.size();
+  for (int i = 1; i < count; i++) {
+    if (std::unique_ptr<Task> task = Pop((thief + i) % count))
+      return task;
+  }
+  return std::unique_ptr<Task>(nullptr);
+}
+
+int WorkerTaskQueue::PopIdleThread() {
+  // Avoid the lock while every thread is busy, which is when it matters.
+  if (idle_count_.load(std::memory_order_relaxed) == 0)
+    return -1;
+  Mutex::ScopedLock scoped_lock(idle_lock_);
+  if (idle_threads_.empty())
+    return -1;
+  int thread = idle_threads_.back();
+  idle_threads_.pop_back();
+  idle_count_--;
+  return thread;
+}
+
+void WorkerTaskQueue::SetIdle(int thread, bool idle) {
+  Mutex::ScopedLock scoped_lock(idle_lock_);
+  auto it = std::find(idle_threads_.begin(), idle_threads_.end(), thread);
+  if (idle && it == idle_threads_.end()) {
+    idle_threads_.push_back(thread);
+    idle_count_++;
+  } else if (!idle && it != idle_threads_.end()) {
+    idle_threads_.erase(it);
+    idle_count_--;
+  }
+}
+
+std::unique_ptr<Task> WorkerTaskQueue::BlockingPop(int thread) {
+  Shard* own = shards_[thread].get();
+  for (;;) {
+    if (stopped_)
+      return std::unique_ptr<Task>(nullptr);
+    if (std::unique_ptr<Task> task = Pop(thread))
+      return task;
+    if (std::unique_ptr<Task> task = Steal(thread))
+      return task;
+
+    // Advertise ourselves as idle, then look once more. Tasks that are
+    // posted from now on are either visible to us or handed to us.
+    SetIdle(thread, true);
+    std::unique_ptr<Task> task = Steal(thread);
+    if (!task) {
+      Mutex::ScopedLock scoped_lock(own->lock);
+      while (own->tasks.empty() && !own->wakeup && !stopped_)
+        own->tasks_available.Wait(scoped_lock);
+      own->wakeup = false;
+    }
+    SetIdle(thread, false);
+
+    if (task)
+      return task;
+  }
+}
+
+void WorkerTaskQueue::NotifyOfCompletion() {
   if (--outstanding_tasks_ == 0) {
+    Mutex::ScopedLock scoped_lock(drain_lock_);
     tasks_drained_.Broadcast(scoped_lock);
   }
 }
 
-template <class T>
-void TaskQueue<T>::BlockingDrain() {
-  Mutex::ScopedLock scoped_lock(lock_);
+void WorkerTaskQueue::BlockingDrain() {
+  Mutex::ScopedLock scoped_lock(drain_lock_);
   while (outstanding_tasks_ > 0) {
     tasks_drained_.Wait(scoped_lock);
   }
 }
 
-template <class T>
-void TaskQueue<T>::Stop() {
-  Mutex::ScopedLock scoped_lock(lock_);
+void WorkerTaskQueue::Stop() {
   stopped_ = true;
-  tasks_available_.Broadcast(scoped_lock);
-}
-
-template <class T>
-std::queue<std::unique_ptr<T>> TaskQueue<T>::PopAll() {
-  Mutex::ScopedLock scoped_lock(lock_);
-  std::queue<std::unique_ptr<T>> result;
-  result.swap(task_queue_);
-  return result;
+  for (const auto& shard : shards_) {
+    Mutex::ScopedLock scoped_lock(shard->lock);
+    shard->tasks_available.Broadcast(scoped_lock);
+  }
 }
 
 }  // namespace node
@@ -3,6 +3,8 @@
 
 #if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
 
+#include <atomic>
+#include <deque>
 #include <queue>
 #include <unordered_map>
 #include <vector>
@@ -20,27 +22,80 @@ class NodePlatform;
 class IsolateData;
 class PerIsolatePlatformData;
 
+// A multi-producer, single-consumer queue. Push() is lock-free and may be
+// called from any thread, Pop() and PopAll() only from the thread that owns
+// the queue.
 template <class T>
 class TaskQueue {
  public:
-  TaskQueue();
-  ~TaskQueue() {}
+  TaskQueue() = default;
+  ~TaskQueue();
 
   void Push(std::unique_ptr<T> task);
   std::unique_ptr<T> Pop();
-  std::unique_ptr<T> BlockingPop();
   std::queue<std::unique_ptr<T>> PopAll();
+
+ private:
+  struct Node {
+    std::unique_ptr<T> task;
+    Node* next;
+  };
+
+  // Moves everything that was pushed so far to |popped_|, in FIFO order.
+  void TakePushed();
+
+  // Newest first; reversed by the consumer.
+  std::atomic<Node*> pushed_ {nullptr};
+  std::queue<std::unique_ptr<T>> popped_;
+
+  DISALLOW_COPY_AND_ASSIGN(TaskQueue);
+};
+
+// The queue that feeds the platform's worker threads. It is split into one
+// queue per thread so that V8 threads posting tasks and workers taking them
+// don't all contend for a single lock. A task is handed to an idle thread
+// when there is one and otherwise spread round-robin over the queues; a thread
+// that runs out of work steals from the others before it goes to sleep.
+class WorkerTaskQueue {
+ public:
+  explicit WorkerTaskQueue(int thread_count);
+
+  void Push(std::unique_ptr<v8::Task> task);
+  // Blocks until there is a task for |thread|, or returns nullptr once the
+  // queue has been stopped.
+  std::unique_ptr<v8::Task> BlockingPop(int thread);
   void NotifyOfCompletion();
   void BlockingDrain();
   void Stop();
 
  private:
-  Mutex lock_;
-  ConditionVariable tasks_available_;
+  struct Shard {
+    Mutex lock;
+    ConditionVariable tasks_available;
+    std::deque<std::unique_ptr<v8::Task>> tasks;
+    // Set to have the owner look for work in the other queues.
+    bool wakeup = false;
+  };
+
+  std::unique_ptr<v8::Task> Pop(int shard);
+  std::unique_ptr<v8::Task> Steal(int thief);
+  int PopIdleThread();
+  void SetIdle(int thread, bool idle);
+  void Wake(int thread);
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<unsigned int> next_shard_ {0};
+  std::atomic<bool> stopped_ {false};
+
+  Mutex idle_lock_;
+  std::vector<int> idle_threads_;
+  std::atomic<int> idle_count_ {0};
+
+  std::atomic<int> outstanding_tasks_ {0};
+  Mutex drain_lock_;
   ConditionVariable tasks_drained_;
-  int outstanding_tasks_;
-  bool stopped_;
-  std::queue<std::unique_ptr<T>> task_queue_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerTaskQueue);
 };
 
 struct DelayedTask {
@@ -62,7 +117,7 @@ class PerIsolatePlatformData :
   void PostIdleTask(std::unique_ptr<v8::IdleTask> task) override;
   void PostDelayedTask(std::unique_ptr<v8::Task> task,
                        double delay_in_seconds) override;
-  bool IdleTasksEnabled() override { return false; };
+  bool IdleTasksEnabled() override { return true; };
 
   void Shutdown();
 
@@ -83,12 +138,17 @@ class PerIsolatePlatformData :
   static void FlushTasks(uv_async_t* handle);
   static void RunForegroundTask(std::unique_ptr<v8::Task> task);
   static void RunForegroundTask(uv_timer_t* timer);
+  // Runs idle tasks right before the loop blocks for I/O, for as long as it
+  // would otherwise sleep.
+  static void RunIdleTasks(uv_prepare_t* handle);
 
   int ref_count_ = 1;
   uv_loop_t* const loop_;
   uv_async_t* flush_tasks_ = nullptr;
+  uv_prepare_t* idle_tasks_prepare_ = nullptr;
   TaskQueue<v8::Task> foreground_tasks_;
   TaskQueue<DelayedTask> foreground_delayed_tasks_;
+  TaskQueue<v8::IdleTask> idle_tasks_;
 
   // Use a custom deleter because libuv needs to close the handle first.
   typedef std::unique_ptr<DelayedTask, std::function<void(DelayedTask*)>>
@@ -111,7 +171,7 @@ class WorkerThreadsTaskRunner {
   int NumberOfWorkerThreads() const;
 
  private:
-  TaskQueue<v8::Task> pending_worker_tasks_;
+  WorkerTaskQueue pending_worker_tasks_;
 
   class DelayedTaskScheduler;
   std::unique_ptr<DelayedTaskScheduler> delayed_task_scheduler_;
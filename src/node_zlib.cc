@@ -227,7 +227,7 @@ class CompressionStream : public AsyncWrap, public ThreadPoolWork {
  public:
   CompressionStream(Environment* env, Local<Object> wrap)
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_ZLIB),
-        ThreadPoolWork(env),
+        ThreadPoolWork(env, ThreadPoolKind::kCompression, "zlib"),
         write_result_(nullptr) {
     MakeWeak();
   }
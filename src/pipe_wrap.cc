@@ -84,6 +84,9 @@ void PipeWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "listen", Listen);
   env->SetProtoMethod(t, "connect", Connect);
   env->SetProtoMethod(t, "open", Open);
+  env->SetProtoMethod(t, "pauseAccepting", PauseAccepting);
+  env->SetProtoMethod(t, "resumeAccepting", ResumeAccepting);
+  env->SetProtoMethod(t, "setAcceptBudget", SetAcceptBudget);
 
 #ifdef _WIN32
   env->SetProtoMethod(t, "setPendingInstances", SetPendingInstances);
@@ -0,0 +1,127 @@
+#include "read_buffer_pool.h"
+#include "node_persistent.h"
+#include "util-inl.h"
+
+#include <algorithm>
+
+namespace node {
+
+using v8::ArrayBuffer;
+using v8::Isolate;
+using v8::Local;
+using v8::WeakCallbackInfo;
+
+const size_t ReadBufferPool::kSlabSize;
+const size_t ReadBufferPool::kMinReadSize;
+
+class ReadBufferPool::Chunk {
+ public:
+  Chunk(Isolate* isolate, Local<ArrayBuffer> object, Slab* slab)
+      : persistent_(isolate, object), slab_(slab) {
+    slab_->refs++;
+    persistent_.SetWeak(this, WeakCallback, v8::WeakCallbackType::kParameter);
+  }
+
+ private:
+  static void WeakCallback(const WeakCallbackInfo<Chunk>& data) {
+    Chunk* self = data.GetParameter();
+    self->persistent_.Reset();
+    Unref(data.GetIsolate(), self->slab_);
+    delete self;
+  }
+
+  Persistent<ArrayBuffer> persistent_;
+  Slab* const slab_;
+};
+
+ReadBufferPool::ReadBufferPool(Isolate* isolate) : isolate_(isolate) {}
+
+ReadBufferPool::~ReadBufferPool() {
+  // Requests are done by now, nothing reads into the slab anymore.
+  pending_ = nullptr;
+  if (slab_ != nullptr)
+    Unref(isolate_, slab_);
+  // Chunks that are still alive free their slabs without the pool.
+  while (!slabs_.IsEmpty())
+    slabs_.PopFront()->pool = nullptr;
+}
+
+uv_buf_t ReadBufferPool::Allocate(size_t suggested_size) {
+  if (pending_ != nullptr || suggested_size > kSlabSize) {
+    stats_[kFallbacks]++;
+    return uv_buf_init(Malloc(suggested_size), suggested_size);
+  }
+
+  // No chunk points into the current slab anymore, start over.
+  if (slab_ != nullptr && slab_->refs == 1)
+    slab_->used = 0;
+
+  const size_t wanted = std::min(suggested_size, kMinReadSize);
+  if (slab_ == nullptr || kSlabSize - slab_->used < wanted) {
+    if (slab_ != nullptr) {
+      Unref(isolate_, slab_);
+      slab_ = nullptr;
+    }
+    if (!NewSlab()) {
+      stats_[kFallbacks]++;
+      return uv_buf_init(Malloc(suggested_size), suggested_size);
+    }
+  }
+
+  stats_[kAllocations]++;
+  pending_ = slab_->data + slab_->used;
+  return uv_buf_init(pending_,
+                     std::min(suggested_size, kSlabSize - slab_->used));
+}
+
+Local<ArrayBuffer> ReadBufferPool::Commit(size_t nread) {
+  CHECK_NOT_NULL(pending_);
+  CHECK_LE(nread, kSlabSize - slab_->used);
+  char* data = pending_;
+  pending_ = nullptr;
+  stats_[kBytes] += nread;
+
+  // The ArrayBuffer is external, its Chunk lets go of the slab once it has
+  // been garbage collected.
+  Local<ArrayBuffer> ab = ArrayBuffer::New(isolate_, data, nread);
+  new Chunk(isolate_, ab, slab_);
+
+  // Keep the next read aligned, TypedArrays on top of it may need that.
+  slab_->used =
+      std::min((slab_->used + nread + 15) & ~size_t{15}, kSlabSize);
+  return ab;
+}
+
+void ReadBufferPool::Release() {
+  CHECK_NOT_NULL(pending_);
+  pending_ = nullptr;
+}
+
+bool ReadBufferPool::NewSlab() {
+  char* data = UncheckedMalloc(kSlabSize);
+  if (data == nullptr)
+    return false;
+  slab_ = new Slab();
+  slab_->pool = this;
+  slab_->data = data;
+  slab_->used = 0;
+  slab_->refs = 1;
+  slabs_.PushBack(slab_);
+  stats_[kSlabs]++;
+  isolate_->AdjustAmountOfExternalAllocatedMemory(kSlabSize);
+  return true;
+}
+
+void ReadBufferPool::Unref(Isolate* isolate, Slab* slab) {
+  CHECK_GT(slab->refs, 0);
+  if (--slab->refs > 0)
+    return;
+  if (slab->pool != nullptr)
+    slab->pool->stats_[kSlabFrees]++;
+  free(slab->data);
+  delete slab;
+  isolate->AdjustAmountOfExternalAllocatedMemory(
+      -static_cast<int64_t>(kSlabSize));
+}
+
+}  // namespace node
@@ -0,0 +1,91 @@
+#ifndef SRC_READ_BUFFER_POOL_H_
+#define SRC_READ_BUFFER_POOL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include "util.h"
+#include "uv.h"
+#include "v8.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace node {
+
+// Carves the buffers that sockets, pipes and TTYs read into out of slabs that
+// all streams of an Environment share, instead of allocating 64 KiB for every
+// read and shrinking it to the number of bytes that were actually read.
+//
+// Every read is handed to JS as an ArrayBuffer of its own that covers just
+// the bytes read, so that a chunk never exposes the data of other
+// connections. A slab counts the chunks that point into it. It is freed once
+// the last of them has been garbage collected and reads have moved on to the
+// next slab, and it is reused from the start once no chunk is left. Idle
+// streams hold no memory at all.
+class ReadBufferPool {
+ public:
+  // Cumulative counters, also exposed to JS through the stream_wrap binding.
+  enum Fields {
+    kAllocations,   // Buffers handed out from slabs.
+    kFallbacks,     // Buffers allocated with Malloc() instead.
+    kSlabs,         // Slabs allocated.
+    kBytes,         // Bytes read into slabs.
+    kSlabFrees,     // Slabs freed once no chunk pointed into them anymore.
+    kNumFields
+  };
+
+  explicit ReadBufferPool(v8::Isolate* isolate);
+  ~ReadBufferPool();
+
+  ReadBufferPool(const ReadBufferPool&) = delete;
+  ReadBufferPool& operator=(const ReadBufferPool&) = delete;
+
+  // Returns a buffer for a read of up to |suggested_size| bytes. It may be
+  // shorter than that, but not shorter than a few kilobytes.
+  uv_buf_t Allocate(size_t suggested_size);
+  // Whether |buf| is the outstanding buffer of the pool. Otherwise it was
+  // allocated with Malloc().
+  inline bool Owns(const uv_buf_t& buf) const {
+    return buf.base != nullptr && buf.base == pending_;
+  }
+  // Keeps the first |nread| bytes of the outstanding buffer and returns an
+  // ArrayBuffer for exactly them.
+  v8::Local<v8::ArrayBuffer> Commit(size_t nread);
+  // Takes back the outstanding buffer unused.
+  void Release();
+
+  inline uint64_t stat(Fields field) const { return stats_[field]; }
+
+ private:
+  static const size_t kSlabSize = 64 * 1024;
+  // Reads into less than this are not worth the syscall.
+  static const size_t kMinReadSize = 8 * 1024;
+
+  struct Slab {
+    ReadBufferPool* pool;
+    char* data;
+    size_t used;
+    // The chunks that point into the slab, plus one while it is the pool's
+    // current slab.
+    size_t refs;
+    ListNode<Slab> pool_node;
+  };
+  // Ties a chunk's ArrayBuffer to its slab.
+  class Chunk;
+
+  bool NewSlab();
+  static void Unref(v8::Isolate* isolate, Slab* slab);
+
+  v8::Isolate* const isolate_;
+  Slab* slab_ = nullptr;
+  char* pending_ = nullptr;
+  // All slabs that are still alive, so that they outlive the pool safely.
+  ListHead<Slab, &Slab::pool_node> slabs_;
+  uint64_t stats_[kNumFields] = {};
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_READ_BUFFER_POOL_H_
@@ -47,6 +47,27 @@ int StreamBase::ReadStopJS(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+int StreamBase::UseUserBuffers(const FunctionCallbackInfo<Value>& args) {
+  CHECK(args[0]->IsArray());
+  Local<Array> buffers = args[0].As<Array>();
+  CHECK_GT(buffers->Length(), 0);
+
+  std::vector<uv_buf_t> bufs(buffers->Length());
+  for (size_t i = 0; i < bufs.size(); i++) {
+    Local<Value> buffer = buffers->Get(env_->context(), i).ToLocalChecked();
+    CHECK(buffer->IsArrayBufferView());
+    SPREAD_BUFFER_ARG(buffer, view);
+    CHECK_GT(view_length, 0);
+    bufs[i] = uv_buf_init(view_data, view_length);
+  }
+
+  PushStreamListener(new UserBufferStreamListener(env_->isolate(),
+                                                  buffers,
+                                                  std::move(bufs)));
+  return 0;
+}
+
+
 int StreamBase::Shutdown(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsObject());
   Local<Object> req_wrap_obj = args[0].As<Object>();
@@ -351,6 +372,23 @@ uv_buf_t StreamListener::OnStreamAlloc(size_t suggested_size) {
 }
 
 
+uv_buf_t EmitToJSStreamListener::OnStreamAlloc(size_t suggested_size) {
+  CHECK_NOT_NULL(stream_);
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  // Only data read from the OS is pooled. In particular, the cleartext of
+  // TLS connections always gets a buffer of its own.
+  switch (stream->GetAsyncWrap()->provider_type()) {
+    case AsyncWrap::PROVIDER_TCPWRAP:
+    case AsyncWrap::PROVIDER_PIPEWRAP:
+    case AsyncWrap::PROVIDER_TTYWRAP:
+      return stream->stream_env()->read_buffer_pool()->Allocate(
+          suggested_size);
+    default:
+      return StreamListener::OnStreamAlloc(suggested_size);
+  }
+}
+
+
 void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   CHECK_NOT_NULL(stream_);
   StreamBase* stream = static_cast<StreamBase*>(stream_);
@@ -358,14 +396,25 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  ReadBufferPool* pool = env->read_buffer_pool();
   if (nread <= 0)  {
-    free(buf.base);
+    if (pool->Owns(buf))
+      pool->Release();
+    else
+      free(buf.base);
     if (nread < 0)
       stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
     return;
   }
 
   CHECK_LE(static_cast<size_t>(nread), buf.len);
+
+  // Commit before calling into JS, which may start the next read.
+  if (pool->Owns(buf)) {
+    stream->CallJSOnreadMethod(nread, pool->Commit(nread));
+    return;
+  }
+
   char* base = Realloc(buf.base, nread);
 
   Local<ArrayBuffer> obj = ArrayBuffer::New(
@@ -377,6 +426,64 @@ void EmitToJSStreamListener::OnStreamRead(ssize_t nread, const uv_buf_t& buf) {
 }
 
 
+UserBufferStreamListener::UserBufferStreamListener(
+    v8::Isolate* isolate,
+    Local<Array> buffers,
+    std::vector<uv_buf_t>&& bufs)
+    : buffers_(isolate, buffers),
+      bufs_(std::move(bufs)) {}
+
+
+uv_buf_t UserBufferStreamListener::OnStreamAlloc(size_t suggested_size) {
+  const uv_buf_t& current = bufs_[index_];
+  return uv_buf_init(current.base + offset_, current.len - offset_);
+}
+
+
+void UserBufferStreamListener::OnStreamRead(ssize_t nread,
+                                            const uv_buf_t& buf) {
+  CHECK_NOT_NULL(stream_);
+  StreamBase* stream = static_cast<StreamBase*>(stream_);
+  Environment* env = stream->stream_env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  if (nread == 0)
+    return;
+
+  if (nread < 0) {
+    stream->CallJSOnreadMethod(nread, Local<ArrayBuffer>());
+    return;
+  }
+
+  const uint32_t index = index_;
+  const size_t offset = offset_;
+  CHECK_EQ(buf.base, bufs_[index].base + offset);
+  CHECK_LE(offset + nread, bufs_[index].len);
+
+  // Move on before calling into JS, which may start the next read.
+  offset_ += nread;
+  if (offset_ == bufs_[index_].len) {
+    offset_ = 0;
+    index_ = (index_ + 1) % bufs_.size();
+  }
+
+  env->stream_base_state()[StreamBase::kReadBytesOrError] = nread;
+  env->stream_base_state()[StreamBase::kArrayBufferOffset] = offset;
+
+  Local<Value> argv[] = { Integer::NewFromUnsigned(env->isolate(), index) };
+
+  AsyncWrap* wrap = stream->GetAsyncWrap();
+  CHECK_NOT_NULL(wrap);
+  wrap->MakeCallback(env->onread_string(), arraysize(argv), argv);
+}
+
+
+void UserBufferStreamListener::OnStreamDestroy() {
+  delete this;
+}
+
+
 void ReportWritesToJSStreamListener::OnStreamAfterReqFinished(
     StreamReq* req_wrap, int status) {
   StreamBase* stream = static_cast<StreamBase*>(stream_);
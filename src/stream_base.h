@@ -10,6 +10,8 @@
 
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 
 // Forward declarations
@@ -178,13 +180,41 @@ class ReportWritesToJSStreamListener : public StreamListener {
 
 
 // A default emitter that just pushes data chunks as Buffer instances to
-// JS land via the handle’s .ondata method.
+// JS land via the handle’s .ondata method. For sockets, pipes and TTYs, the
+// data is read into the Environment's ReadBufferPool.
 class EmitToJSStreamListener : public ReportWritesToJSStreamListener {
  public:
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
   void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
 };
 
 
+// A listener that reads into a fixed ring of caller-provided buffers instead
+// of allocating memory for each read. The JS .onread method receives the
+// index of the buffer that was filled; the offset into it and the number of
+// bytes read are passed through the shared stream state fields.
+// Reads are appended to the current buffer until it is full, after which
+// the next buffer in the ring is used. It is up to JS to consume the data
+// (or to stop reading) before the ring wraps around.
+class UserBufferStreamListener : public ReportWritesToJSStreamListener {
+ public:
+  UserBufferStreamListener(v8::Isolate* isolate,
+                           v8::Local<v8::Array> buffers,
+                           std::vector<uv_buf_t>&& bufs);
+
+  uv_buf_t OnStreamAlloc(size_t suggested_size) override;
+  void OnStreamRead(ssize_t nread, const uv_buf_t& buf) override;
+  void OnStreamDestroy() override;
+
+ private:
+  // Keeps the backing stores of `bufs_` alive.
+  v8::Global<v8::Array> buffers_;
+  std::vector<uv_buf_t> bufs_;
+  size_t index_ = 0;
+  size_t offset_ = 0;
+};
+
+
 // A generic stream, comparable to JS land’s `Duplex` streams.
 // A stream is always controlled through one `StreamListener` instance.
 class StreamResource {
@@ -250,6 +280,7 @@ class StreamResource {
   uint64_t bytes_written_ = 0;
 
   friend class StreamListener;
+  friend class StreamPipe;  // Updates the counters for spliced data.
 };
 
 
@@ -305,6 +336,7 @@ class StreamBase : public StreamResource {
   // JS Methods
   int ReadStartJS(const v8::FunctionCallbackInfo<v8::Value>& args);
   int ReadStopJS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  int UseUserBuffers(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Shutdown(const v8::FunctionCallbackInfo<v8::Value>& args);
   int Writev(const v8::FunctionCallbackInfo<v8::Value>& args);
   int WriteBuffer(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -346,6 +378,7 @@ class StreamBase : public StreamResource {
   friend class WriteWrap;
   friend class ShutdownWrap;
   friend class Environment;  // For kNumStreamBaseStateFields.
+  friend class UserBufferStreamListener;  // For the stream state fields.
 };
 
 
@@ -1,18 +1,239 @@
 #include "stream_pipe.h"
 #include "stream_base-inl.h"
+#include "stream_wrap.h"
 #include "node_buffer.h"
+#include "node_file.h"
 #include "node_internals.h"
 
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using v8::Context;
 using v8::External;
+using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Integer;
 using v8::Local;
+using v8::Number;
 using v8::Object;
 using v8::Value;
 
 namespace node {
 
+#ifdef __linux__
+// Moves data from one socket to another through a kernel pipe with splice(),
+// so that it never has to be copied to user space. The sockets are watched
+// through duplicates of their descriptors, because libuv allows only one
+// watcher per descriptor. Reading stops while data is waiting to be written,
+// so that a slow sink also slows down the source, and nothing is spliced
+// while writes from JS are queued on the sink, so that the two never mix.
+class StreamPipe::Splicer {
+ public:
+  static Splicer* Create(StreamPipe* pipe, uv_loop_t* loop,
+                         int in_fd, int out_fd);
+
+  void ReadStart();
+  void ReadStop();
+  size_t buffered() const { return buffered_; }
+  // Writes what is buffered to the sink, unless its write queue is not empty.
+  void Flush();
+  // Detaches the splicer from its StreamPipe and frees it asynchronously.
+  void Close();
+
+  ~Splicer();
+
+ private:
+  Splicer() = default;
+
+  static void OnReadable(uv_poll_t* handle, int status, int events);
+  static void OnWritable(uv_poll_t* handle, int status, int events);
+  static void OnClose(uv_handle_t* handle);
+
+  StreamPipe* pipe_ = nullptr;
+  int in_fd_ = -1;
+  int out_fd_ = -1;
+  int pipe_fds_[2] = { -1, -1 };
+  size_t capacity_ = 0;
+  size_t buffered_ = 0;
+  int handles_open_ = 0;
+  uv_poll_t in_poll_;
+  uv_poll_t out_poll_;
+};
+
+StreamPipe::Splicer* StreamPipe::Splicer::Create(StreamPipe* pipe,
+                                                 uv_loop_t* loop,
+                                                 int in_fd,
+                                                 int out_fd) {
+  std::unique_ptr<Splicer> splicer(new Splicer());
+  splicer->in_fd_ = fcntl(in_fd, F_DUPFD_CLOEXEC, 0);
+  splicer->out_fd_ = fcntl(out_fd, F_DUPFD_CLOEXEC, 0);
+  if (splicer->in_fd_ == -1 || splicer->out_fd_ == -1 ||
+      pipe2(splicer->pipe_fds_, O_CLOEXEC | O_NONBLOCK) == -1) {
+    return nullptr;
+  }
+
+  int capacity = fcntl(splicer->pipe_fds_[1], F_GETPIPE_SZ);
+  splicer->capacity_ = capacity > 0 ? capacity : 65536;
+
+  if (uv_poll_init(loop, &splicer->in_poll_, splicer->in_fd_) != 0)
+    return nullptr;
+  splicer->in_poll_.data = splicer.get();
+  splicer->handles_open_++;
+  if (uv_poll_init(loop, &splicer->out_poll_, splicer->out_fd_) != 0) {
+    // The descriptors are closed once the first handle is.
+    splicer.release()->Close();
+    return nullptr;
+  }
+  splicer->handles_open_++;
+
+  splicer->out_poll_.data = splicer.get();
+  splicer->pipe_ = pipe;
+  return splicer.release();
+}
+
+StreamPipe::Splicer::~Splicer() {
+  CHECK_EQ(handles_open_, 0);
+  for (int fd : { in_fd_, out_fd_, pipe_fds_[0], pipe_fds_[1] }) {
+    if (fd != -1)
+      close(fd);
+  }
+}
+
+void StreamPipe::Splicer::ReadStart() {
+  uv_poll_start(&in_poll_, UV_READABLE, OnReadable);
+}
+
+void StreamPipe::Splicer::ReadStop() {
+  uv_poll_stop(&in_poll_);
+}
+
+void StreamPipe::Splicer::Close() {
+  pipe_ = nullptr;
+  if (handles_open_ == 0) {
+    delete this;
+    return;
+  }
+  // uv_poll_init() failed for the second handle if only one is open.
+  bool both = handles_open_ == 2;
+  uv_close(reinterpret_cast<uv_handle_t*>(&in_poll_), OnClose);
+  if (both)
+    uv_close(reinterpret_cast<uv_handle_t*>(&out_poll_), OnClose);
+}
+
+void StreamPipe::Splicer::OnClose(uv_handle_t* handle) {
+  Splicer* splicer = static_cast<Splicer*>(handle->data);
+  if (--splicer->handles_open_ == 0)
+    delete splicer;
+}
+
+void StreamPipe::Splicer::Flush() {
+  while (buffered_ > 0) {
+    if (pipe_->SinkWriteQueueSize() != 0) {
+      // Data written from JS is still waiting in libuv and goes first. The
+      // pipe goes on once that write has finished.
+      ReadStop();
+      uv_poll_stop(&out_poll_);
+      return;
+    }
+
+    ssize_t n;
+    do {
+      n = splice(pipe_fds_[0], nullptr, out_fd_, nullptr, buffered_,
+                 SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    } while (n == -1 && errno == EINTR);
+
+    if (n == -1 && errno == EAGAIN) {
+      // Wait for the sink to drain before reading anything else.
+      ReadStop();
+      uv_poll_start(&out_poll_, UV_WRITABLE, OnWritable);
+      return;
+    }
+    if (n == -1) {
+      pipe_->OnSpliceWrite(uv_translate_sys_error(errno));
+      return;
+    }
+    buffered_ -= n;
+    pipe_->OnSpliceWrite(n);
+    // Unpiping from the callback closes the splicer.
+    if (pipe_ == nullptr)
+      return;
+  }
+  uv_poll_stop(&out_poll_);
+  pipe_->OnSpliceDrained();
+}
+
+void StreamPipe::Splicer::OnReadable(uv_poll_t* handle,
+                                     int status,
+                                     int events) {
+  Splicer* splicer = ContainerOf(&Splicer::in_poll_, handle);
+  CHECK_EQ(splicer->buffered_, 0);
+  ssize_t n = status;
+  if (status == 0) {
+    do {
+      n = splice(splicer->in_fd_, nullptr, splicer->pipe_fds_[1], nullptr,
+                 splicer->capacity_, SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    } while (n == -1 && errno == EINTR);
+    if (n == -1 && errno == EAGAIN)
+      return;
+    if (n == -1)
+      n = uv_translate_sys_error(errno);
+  }
+
+  if (n > 0)
+    splicer->buffered_ = n;
+  else
+    splicer->ReadStop();
+  splicer->pipe_->OnSpliceRead(n == 0 ? static_cast<ssize_t>(UV_EOF) : n);
+  if (n > 0 && splicer->pipe_ != nullptr)
+    splicer->Flush();
+}
+
+void StreamPipe::Splicer::OnWritable(uv_poll_t* handle,
+                                     int status,
+                                     int events) {
+  Splicer* splicer = ContainerOf(&Splicer::out_poll_, handle);
+  if (status < 0) {
+    splicer->pipe_->OnSpliceWrite(status);
+    return;
+  }
+  splicer->Flush();
+}
+
+void StreamPipe::OnSpliceRead(ssize_t nread) {
+  if (nread > 0) {
+    source()->bytes_read_ += nread;
+    return;
+  }
+  // EOF or error, handled just like a failed read. The pipe is closed once
+  // everything that is still buffered has been written.
+  is_writing_ = splicer_->buffered() > 0;
+  readable_listener_.OnStreamRead(nread, uv_buf_init(nullptr, 0));
+}
+
+void StreamPipe::OnSpliceDrained() {
+  OnIdle();
+  MaybeResume();
+}
+
+void StreamPipe::OnSpliceWrite(ssize_t nwritten) {
+  if (nwritten < 0) {
+    sink_error_ = nwritten;
+    Unpipe();
+    return;
+  }
+  bytes_piped_ += nwritten;
+  sink()->bytes_written_ += nwritten;
+  if (is_eof_ && splicer_->buffered() == 0) {
+    is_writing_ = false;
+    Unpipe();
+  }
+}
+#endif  // __linux__
+
 StreamPipe::StreamPipe(StreamBase* source,
                        StreamBase* sink,
                        Local<Object> obj)
@@ -25,7 +246,34 @@ StreamPipe::StreamPipe(StreamBase* source,
   source->PushStreamListener(&readable_listener_);
   sink->PushStreamListener(&writable_listener_);
 
-  CHECK(sink->HasWantsWrite());
+  wants_write_ = sink->HasWantsWrite();
+  if (!wants_write_)
+    wanted_data_ = 65536;
+
+#ifndef _WIN32
+  AsyncWrap::ProviderType source_type =
+      source->GetAsyncWrap()->provider_type();
+  AsyncWrap::ProviderType sink_type = sink->GetAsyncWrap()->provider_type();
+  if (sink_type == PROVIDER_TCPWRAP || sink_type == PROVIDER_PIPEWRAP) {
+    LibuvStreamWrap* sink_wrap = static_cast<LibuvStreamWrap*>(sink);
+    if (source_type == PROVIDER_FILEHANDLE) {
+      sendfile_fd_ = sink_wrap->GetFD();
+    }
+#ifdef __linux__
+    if (source_type == PROVIDER_TCPWRAP || source_type == PROVIDER_PIPEWRAP) {
+      LibuvStreamWrap* source_wrap = static_cast<LibuvStreamWrap*>(source);
+      int source_fd = source_wrap->GetFD();
+      int sink_fd = sink_wrap->GetFD();
+      if (source_fd >= 0 && sink_fd >= 0 &&
+          !source_wrap->is_named_pipe_ipc() &&
+          !sink_wrap->is_named_pipe_ipc()) {
+        splicer_ = Splicer::Create(this, env()->event_loop(),
+                                   source_fd, sink_fd);
+      }
+    }
+#endif
+  }
+#endif
 
   // Set up links between this object and the source/sink objects.
   // In particular, this makes sure that they are garbage collected as a group,
@@ -57,14 +305,38 @@ void StreamPipe::Unpipe() {
   if (is_closed_)
     return;
 
+  if (sendfile_fd_ != -1 && !source_destroyed_ && !sink_destroyed_ &&
+      static_cast<fs::FileHandle*>(source())->sendfile_pending()) {
+    // Wait for the sendfile() in flight, so that the bytes it sends are
+    // counted and its result does not reach the source's next listener.
+    unpipe_pending_ = true;
+    is_reading_ = false;
+    source()->ReadStop();
+    return;
+  }
+
+  // A write from JS that waits for the pipe can go ahead now.
+  OnIdle();
+
   // Note that we possibly cannot use virtual methods on `source` and `sink`
   // here, because this function can be called from their destructors via
   // `OnStreamDestroy()`.
-  if (!source_destroyed_)
+  if (!source_destroyed_) {
     source()->ReadStop();
+    // The result of a sendfile() that is still in flight because the sink
+    // went away has nobody to go to.
+    if (sendfile_fd_ != -1)
+      static_cast<fs::FileHandle*>(source())->StopSendFile();
+  }
 
   is_closed_ = true;
   is_reading_ = false;
+#ifdef __linux__
+  if (splicer_ != nullptr) {
+    splicer_->Close();
+    splicer_ = nullptr;
+  }
+#endif
   source()->RemoveStreamListener(&readable_listener_);
   sink()->RemoveStreamListener(&writable_listener_);
 
@@ -79,7 +351,13 @@ void StreamPipe::Unpipe() {
     Local<Object> object = pipe->object();
 
     if (object->Has(env->context(), env->onunpipe_string()).FromJust()) {
-      pipe->MakeCallback(env->onunpipe_string(), 0, nullptr).ToLocalChecked();
+      Local<Value> argv[] = {
+        Integer::New(env->isolate(), pipe->error_),
+        Integer::New(env->isolate(), pipe->sink_error_),
+        Number::New(env->isolate(), static_cast<double>(pipe->bytes_piped_))
+      };
+      pipe->MakeCallback(env->onunpipe_string(), arraysize(argv), argv)
+          .ToLocalChecked();
     }
 
     // Set all the links established in the constructor to `null`.
@@ -116,11 +394,39 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
                                                 const uv_buf_t& buf) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::readable_listener_, this);
   AsyncScope async_scope(pipe);
+  if (pipe->sendfile_fd_ != -1 && buf.base == nullptr) {
+    if (nread > 0)
+      pipe->bytes_piped_ += nread;
+    if (pipe->unpipe_pending_) {
+      // JS reads the rest of the file and sees EOF and errors itself.
+      pipe->Unpipe();
+      return;
+    }
+    if (nread > 0) {
+      // The data went straight to the sink. Check again whether the next
+      // read may do the same before the FileHandle dispatches it.
+      pipe->UpdateSendFile();
+      pipe->OnIdle();
+      return;
+    }
+    if (nread < 0 && nread != UV_EOF && !pipe->source_destroyed_) {
+      // The socket is full (or sendfile() does not work for this pair of
+      // descriptors). Go on with a regular read, whose write waits for the
+      // socket to become writable and tells apart read and write errors.
+      if (nread != UV_EAGAIN)
+        pipe->sendfile_failed_ = true;
+      static_cast<fs::FileHandle*>(stream())->set_sendfile_fd(-1);
+      pipe->OnIdle();
+      return;
+    }
+  }
   if (nread < 0) {
     // EOF or error; stop reading and pass the error to the previous listener
     // (which might end up in JS).
     free(buf.base);
     pipe->is_eof_ = true;
+    if (nread != UV_EOF)
+      pipe->error_ = nread;
     stream()->ReadStop();
     CHECK_NOT_NULL(previous_listener_);
     previous_listener_->OnStreamRead(nread, uv_buf_init(nullptr, 0));
@@ -134,9 +440,11 @@ void StreamPipe::ReadableListener::OnStreamRead(ssize_t nread,
   }
 
   pipe->ProcessData(nread, buf);
+  pipe->OnIdle();
 }
 
 void StreamPipe::ProcessData(size_t nread, const uv_buf_t& buf) {
+  bytes_piped_ += nread;
   uv_buf_t buffer = uv_buf_init(buf.base, nread);
   StreamWriteResult res = sink()->Write(&buffer, 1);
   if (!res.async) {
@@ -145,6 +453,7 @@ void StreamPipe::ProcessData(size_t nread, const uv_buf_t& buf) {
   } else {
     is_writing_ = true;
     is_reading_ = false;
+    pending_write_ = res.wrap;
     res.wrap->SetAllocatedStorage(buf.base, buf.len);
     if (source() != nullptr)
       source()->ReadStop();
@@ -152,12 +461,114 @@ void StreamPipe::ProcessData(size_t nread, const uv_buf_t& buf) {
 }
 
 void StreamPipe::ShutdownWritable() {
-  sink()->Shutdown();
+  // Sockets are ended from JS, which also knows about the writes that
+  // did not go through this pipe.
+  if (wants_write_)
+    sink()->Shutdown();
+}
+
+size_t StreamPipe::SinkWriteQueueSize() {
+  return uv_stream_get_write_queue_size(
+      static_cast<LibuvStreamWrap*>(sink())->stream());
+}
+
+void StreamPipe::UpdateSendFile() {
+  if (sendfile_fd_ == -1)
+    return;
+  bool enable = !sendfile_failed_ && SinkWriteQueueSize() == 0;
+  static_cast<fs::FileHandle*>(source())->set_sendfile_fd(
+      enable ? sendfile_fd_ : -1);
+}
+
+bool StreamPipe::Hold() {
+  holds_++;
+  if (hold_pending_ || unpipe_pending_) {
+    // Data is still in flight, `onhold` is called once it has been written.
+    hold_pending_ = true;
+    return false;
+  }
+  if (is_closed_ || wants_write_ || !is_reading_)
+    return true;
+#ifdef __linux__
+  if (splicer_ != nullptr) {
+    // Data in the kernel pipe has been read, but not written yet.
+    splicer_->ReadStop();
+    if (splicer_->buffered() == 0)
+      return true;
+    hold_pending_ = true;
+    return false;
+  }
+#endif
+
+  // Everything that was read so far went through the sink's write queue,
+  // except for data that a read in flight sends with sendfile().
+  is_reading_ = false;
+  source()->ReadStop();
+  if (sendfile_fd_ == -1)
+    return true;
+  hold_pending_ = true;
+  return false;
+}
+
+void StreamPipe::Release() {
+  CHECK_GT(holds_, 0);
+  holds_--;
+  MaybeResume();
+}
+
+void StreamPipe::OnIdle() {
+  if (!hold_pending_)
+    return;
+  hold_pending_ = false;
+
+  env()->SetImmediate([](Environment* env, void* data) {
+    StreamPipe* pipe = static_cast<StreamPipe*>(data);
+
+    HandleScope handle_scope(env->isolate());
+    Context::Scope context_scope(env->context());
+    Local<Value> onhold;
+    if (!pipe->object()->Get(env->context(), env->onhold_string())
+            .ToLocal(&onhold) || !onhold->IsFunction()) {
+      return;
+    }
+    pipe->MakeCallback(onhold.As<Function>(), 0, nullptr);
+  }, static_cast<void*>(this), object());
+}
+
+void StreamPipe::MaybeResume() {
+  if (is_closed_ || wants_write_)
+    return;
+#ifdef __linux__
+  if (splicer_ != nullptr) {
+    if (SinkWriteQueueSize() != 0)
+      return;
+    if (splicer_->buffered() > 0)
+      splicer_->Flush();
+    else if (!is_eof_ && holds_ == 0)
+      splicer_->ReadStart();
+    return;
+  }
+#endif
+  UpdateSendFile();
+  if (is_eof_ || is_writing_ || is_reading_ || holds_ > 0)
+    return;
+  AsyncScope async_scope(this);
+  is_reading_ = true;
+  source()->ReadStart();
 }
 
 void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
                                                       int status) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
+  if (w != nullptr && w != pipe->pending_write_) {
+    // A write from JS, which may have held up the pipe.
+    CHECK_NOT_NULL(previous_listener_);
+    previous_listener_->OnStreamAfterWrite(w, status);
+    pipe->MaybeResume();
+    return;
+  }
+
+  pipe->pending_write_ = nullptr;
   pipe->is_writing_ = false;
   if (pipe->is_eof_) {
     AsyncScope async_scope(pipe);
@@ -167,12 +578,21 @@ void StreamPipe::WritableListener::OnStreamAfterWrite(WriteWrap* w,
   }
 
   if (status != 0) {
+    if (!pipe->wants_write_) {
+      // Nobody in JS waits for this write, report the error when unpiping.
+      pipe->sink_error_ = status;
+      pipe->Unpipe();
+      return;
+    }
     CHECK_NOT_NULL(previous_listener_);
     StreamListener* prev = previous_listener_;
     pipe->Unpipe();
     prev->OnStreamAfterWrite(w, status);
     return;
   }
+
+  // The write that stopped reading has finished.
+  pipe->MaybeResume();
 }
 
 void StreamPipe::WritableListener::OnStreamAfterShutdown(ShutdownWrap* w,
@@ -202,10 +622,11 @@ void StreamPipe::WritableListener::OnStreamDestroy() {
 void StreamPipe::WritableListener::OnStreamWantsWrite(size_t suggested_size) {
   StreamPipe* pipe = ContainerOf(&StreamPipe::writable_listener_, this);
   pipe->wanted_data_ = suggested_size;
-  if (pipe->is_reading_ || pipe->is_closed_)
+  if (pipe->is_reading_ || pipe->is_closed_ || pipe->holds_ > 0)
     return;
   AsyncScope async_scope(pipe);
   pipe->is_reading_ = true;
+  pipe->UpdateSendFile();
   pipe->source()->ReadStart();
 }
 
@@ -234,6 +655,16 @@ void StreamPipe::Start(const FunctionCallbackInfo<Value>& args) {
   StreamPipe* pipe;
   ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
   pipe->is_closed_ = false;
+#ifdef __linux__
+  if (pipe->splicer_ != nullptr) {
+    // The source is read through the splicer only.
+    pipe->source()->ReadStop();
+    pipe->is_reading_ = true;
+    if (pipe->holds_ == 0)
+      pipe->splicer_->ReadStart();
+    return;
+  }
+#endif
   if (pipe->wanted_data_ > 0)
     pipe->writable_listener_.OnStreamWantsWrite(pipe->wanted_data_);
 }
@@ -244,6 +675,18 @@ void StreamPipe::Unpipe(const FunctionCallbackInfo<Value>& args) {
   pipe->Unpipe();
 }
 
+void StreamPipe::Hold(const FunctionCallbackInfo<Value>& args) {
+  StreamPipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  args.GetReturnValue().Set(pipe->Hold());
+}
+
+void StreamPipe::Release(const FunctionCallbackInfo<Value>& args) {
+  StreamPipe* pipe;
+  ASSIGN_OR_RETURN_UNWRAP(&pipe, args.Holder());
+  pipe->Release();
+}
+
 namespace {
 
 void InitializeStreamPipe(Local<Object> target,
@@ -258,6 +701,8 @@ void InitializeStreamPipe(Local<Object> target,
       FIXED_ONE_BYTE_STRING(env->isolate(), "StreamPipe");
   env->SetProtoMethod(pipe, "unpipe", StreamPipe::Unpipe);
   env->SetProtoMethod(pipe, "start", StreamPipe::Start);
+  env->SetProtoMethod(pipe, "hold", StreamPipe::Hold);
+  env->SetProtoMethod(pipe, "release", StreamPipe::Release);
   pipe->Inherit(AsyncWrap::GetConstructorTemplate(env));
   pipe->SetClassName(stream_pipe_string);
   pipe->InstanceTemplate()->SetInternalFieldCount(1);
@@ -17,6 +17,8 @@ class StreamPipe : public AsyncWrap {
   static void New(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Start(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Unpipe(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Hold(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void Release(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(StreamPipe)
@@ -28,6 +30,30 @@ class StreamPipe : public AsyncWrap {
 
   inline void ShutdownWritable();
   inline void FlushToWritable();
+  // Lets the source send its data with sendfile() if both ends support it
+  // and nothing is queued on the sink that the data would overtake.
+  void UpdateSendFile();
+  size_t SinkWriteQueueSize();
+
+  // Writes to the sink by JS and data that the pipe sends outside of the
+  // sink's write queue must not overlap. While the pipe is held, it sends
+  // nothing new. Hold() returns false if data is still in flight, the
+  // `onhold` JS callback is called once it has been written.
+  bool Hold();
+  void Release();
+  // Calls `onhold` if Hold() returned false.
+  void OnIdle();
+  // Starts reading again after a hold or after the sink's write queue has
+  // drained.
+  void MaybeResume();
+
+  // Moves data between two sockets with splice() on Linux.
+  class Splicer;
+  Splicer* splicer_ = nullptr;
+  void OnSpliceRead(ssize_t nread);
+  void OnSpliceWrite(ssize_t nwritten);
+  // Called once everything the splicer has read has been written.
+  void OnSpliceDrained();
 
   bool is_reading_ = false;
   bool is_writing_ = false;
@@ -35,11 +61,27 @@ class StreamPipe : public AsyncWrap {
   bool is_closed_ = true;
   bool sink_destroyed_ = false;
   bool source_destroyed_ = false;
+  size_t holds_ = 0;
+  bool hold_pending_ = false;
+  // Unpipe() waits for a sendfile() in flight to finish.
+  bool unpipe_pending_ = false;
+  // The write the pipe itself is waiting for. Other writes to the sink come
+  // from JS and are passed on to the sink's previous listener.
+  WriteWrap* pending_write_ = nullptr;
+
+  // Sinks without `OnStreamWantsWrite()` support, like sockets, are written
+  // to whenever data is read and reading stops while a write is pending.
+  bool wants_write_ = true;
+  // The socket descriptor of the sink if the source is a FileHandle that can
+  // sendfile() to it, otherwise -1.
+  int sendfile_fd_ = -1;
+  bool sendfile_failed_ = false;
+  uint64_t bytes_piped_ = 0;
+  int error_ = 0;
+  int sink_error_ = 0;
 
   // Set a default value so that when we’re coming from Start(), we know
   // that we don’t want to read just yet.
-  // This will likely need to be changed when supporting streams without
-  // `OnStreamWantsWrite()` support.
   size_t wanted_data_ = 0;
 
   void ProcessData(size_t nread, const uv_buf_t& buf);
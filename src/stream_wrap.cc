@@ -40,9 +40,11 @@ namespace node {
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
+using v8::Float64Array;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
 using v8::HandleScope;
+using v8::Integer;
 using v8::Local;
 using v8::Object;
 using v8::ReadOnly;
@@ -50,6 +52,19 @@ using v8::Signature;
 using v8::Value;
 
 
+// Fills the Float64Array argument with the ReadBufferPool counters.
+static void GetReadBufferPoolStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), static_cast<size_t>(ReadBufferPool::kNumFields));
+  double* fields = static_cast<double*>(array->Buffer()->GetContents().Data());
+  ReadBufferPool* pool = env->read_buffer_pool();
+  for (int i = 0; i < ReadBufferPool::kNumFields; i++)
+    fields[i] = static_cast<double>(pool->stat(ReadBufferPool::Fields(i)));
+}
+
+
 void LibuvStreamWrap::Initialize(Local<Object> target,
                                  Local<Value> unused,
                                  Local<Context> context,
@@ -91,6 +106,12 @@ void LibuvStreamWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(target, kLastWriteWasAsync);
   target->Set(context, FIXED_ONE_BYTE_STRING(env->isolate(), "streamBaseState"),
               env->stream_base_state().GetJSArray()).FromJust();
+
+  env->SetMethod(target, "getReadBufferPoolStats", GetReadBufferPoolStats);
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "kReadBufferPoolFields"),
+              Integer::New(env->isolate(),
+                           ReadBufferPool::kNumFields)).FromJust();
 }
 
 
@@ -126,6 +147,7 @@ Local<FunctionTemplate> LibuvStreamWrap::GetConstructorTemplate(
         Local<FunctionTemplate>(),
         static_cast<PropertyAttribute>(ReadOnly | DontDelete));
     env->SetProtoMethod(tmpl, "setBlocking", SetBlocking);
+    env->SetProtoMethod(tmpl, "setExclusiveAccept", SetExclusiveAccept);
     StreamBase::AddMethods<LibuvStreamWrap>(env, tmpl);
     env->set_libuv_stream_wrap_ctor_template(tmpl);
   }
@@ -287,6 +309,21 @@ void LibuvStreamWrap::SetBlocking(const FunctionCallbackInfo<Value>& args) {
   args.GetReturnValue().Set(uv_stream_set_blocking(wrap->stream(), enable));
 }
 
+
+void LibuvStreamWrap::SetExclusiveAccept(
+    const FunctionCallbackInfo<Value>& args) {
+  LibuvStreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK_GT(args.Length(), 0);
+  if (!wrap->IsAlive())
+    return args.GetReturnValue().Set(UV_EINVAL);
+
+  bool enable = args[0]->IsTrue();
+  args.GetReturnValue().Set(
+      uv_stream_set_exclusive_accept(wrap->stream(), enable));
+}
+
 typedef SimpleShutdownWrap<ReqWrap<uv_shutdown_t>> LibuvShutdownWrap;
 typedef SimpleWriteWrap<ReqWrap<uv_write_t>> LibuvWriteWrap;
 
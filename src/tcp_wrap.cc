@@ -103,6 +103,14 @@ void TCPWrap::Initialize(Local<Object> target,
                       GetSockOrPeerName<TCPWrap, uv_tcp_getpeername>);
   env->SetProtoMethod(t, "setNoDelay", SetNoDelay);
   env->SetProtoMethod(t, "setKeepAlive", SetKeepAlive);
+  env->SetProtoMethod(t, "setZeroCopy", SetZeroCopy);
+  env->SetProtoMethod(t, "setFastOpen", SetFastOpen);
+  env->SetProtoMethod(t, "setFastOpenConnect", SetFastOpenConnect);
+  env->SetProtoMethod(t, "setDeferAccept", SetDeferAccept);
+  env->SetProtoMethod(t, "pauseAccepting", PauseAccepting);
+  env->SetProtoMethod(t, "resumeAccepting", ResumeAccepting);
+  env->SetProtoMethod(t, "setAcceptBudget", SetAcceptBudget);
+  env->SetProtoMethod(t, "getAcceptBacklog", GetAcceptBacklog);
 
 #ifdef _WIN32
   env->SetProtoMethod(t, "setSimultaneousAccepts", SetSimultaneousAccepts);
@@ -129,6 +137,7 @@ void TCPWrap::Initialize(Local<Object> target,
   NODE_DEFINE_CONSTANT(constants, SOCKET);
   NODE_DEFINE_CONSTANT(constants, SERVER);
   NODE_DEFINE_CONSTANT(constants, UV_TCP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_TCP_REUSEPORT);
   target->Set(context,
               env->constants_string(),
               constants).FromJust();
@@ -195,6 +204,67 @@ void TCPWrap::SetKeepAlive(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Writes of at least args[1] bytes are sent from the JS buffers with
+// MSG_ZEROCOPY. libuv reports them done only once the kernel releases the
+// buffers, so the WriteWrap (and with it the buffers) stays alive until then.
+void TCPWrap::SetZeroCopy(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  bool enable = args[0]->IsTrue();
+  unsigned int min_size = args[1].As<Uint32>()->Value();
+  int err = uv_tcp_zerocopy(&wrap->handle_, enable, min_size);
+  args.GetReturnValue().Set(err);
+}
+
+
+void TCPWrap::SetFastOpen(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  unsigned int qlen = args[0].As<Uint32>()->Value();
+  int err = uv_tcp_fastopen(&wrap->handle_, qlen);
+  args.GetReturnValue().Set(err);
+}
+
+
+void TCPWrap::SetFastOpenConnect(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  bool enable = args[0]->IsTrue();
+  int err = uv_tcp_fastopen_connect(&wrap->handle_, enable);
+  args.GetReturnValue().Set(err);
+}
+
+
+void TCPWrap::SetDeferAccept(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  unsigned int timeout = args[0].As<Uint32>()->Value();
+  int err = uv_tcp_defer_accept(&wrap->handle_, timeout);
+  args.GetReturnValue().Set(err);
+}
+
+
+void TCPWrap::GetAcceptBacklog(const FunctionCallbackInfo<Value>& args) {
+  TCPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  unsigned int count;
+  int err = uv_tcp_accept_backlog(&wrap->handle_, &count);
+  if (err != 0)
+    return args.GetReturnValue().Set(err);
+  args.GetReturnValue().Set(count);
+}
+
+
 #ifdef _WIN32
 void TCPWrap::SetSimultaneousAccepts(const FunctionCallbackInfo<Value>& args) {
   TCPWrap* wrap;
@@ -239,10 +309,10 @@ void TCPWrap::Bind(
   int port;
   unsigned int flags = 0;
   if (!args[1]->Int32Value(env->context()).To(&port)) return;
-  if (family == AF_INET6 &&
-      !args[2]->Uint32Value(env->context()).To(&flags)) {
-    return;
-  }
+  if (!args[2]->Uint32Value(env->context()).To(&flags)) return;
+  // IPv6-only is meaningless for an IPv4 address, libuv rejects it.
+  if (family == AF_INET)
+    flags &= ~UV_TCP_IPV6ONLY;
 
   T addr;
   int err = uv_ip_addr(*ip_address, port, &addr);
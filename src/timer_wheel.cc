@@ -0,0 +1,217 @@
+#include "timer_wheel.h"
+#include "util.h"
+
+#include <algorithm>
+
+namespace node {
+
+namespace {
+
+// Index of the lowest set bit of |bits|, which must not be 0.
+inline int CountTrailingZeros(uint64_t bits) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(bits);
+#else
+  int count = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    count++;
+  }
+  return count;
+#endif
+}
+
+// The first set bit in the 256 bit map |words| at or after |from|, or -1.
+int FindFirstSet(const uint64_t* words, int from) {
+  for (int word = from / 64; word < 4; word++) {
+    uint64_t bits = words[word];
+    if (word == from / 64)
+      bits &= ~uint64_t{0} << (from % 64);
+    if (bits != 0)
+      return word * 64 + CountTrailingZeros(bits);
+  }
+  return -1;
+}
+
+}  // anonymous namespace
+
+const uint32_t TimerWheel::kNone;
+
+TimerWheel::TimerWheel(uint64_t now) : now_(now) {
+  std::fill(std::begin(heads_), std::end(heads_), kNone);
+  std::fill(std::begin(tails_), std::end(tails_), kNone);
+}
+
+void TimerWheel::Start(uint32_t id, uint64_t now, uint64_t duration) {
+  CHECK_NE(id, kNone);
+  if (id >= timers_.size())
+    timers_.resize(id + 1, Timer { 0, 0, kNone, kNone, kNoList });
+  Timer& timer = timers_[id];
+  CHECK_EQ(timer.list, kNoList);
+
+  // Nothing was due while the wheel was empty, and catching up now saves
+  // Advance() from cascading the new timer through every level.
+  if (armed_count_ == 0)
+    now_ = std::max(now_, now);
+
+  timer.duration = static_cast<uint32_t>(
+      std::min<uint64_t>(std::max<uint64_t>(duration, 1), UINT32_MAX));
+  timer.expiry = std::max(now, now_) + timer.duration;
+  Insert(id);
+}
+
+void TimerWheel::Refresh(uint32_t id, uint64_t now) {
+  CHECK(IsActive(id));
+  Timer& timer = timers_[id];
+  timer.expiry = std::max(now, now_) + timer.duration;
+  // Timers in the wheel stay where they are; the expiry only ever moves
+  // forward, so their slot comes up before they are due. Expired timers
+  // that have not been popped yet go back into the wheel.
+  if (timer.list == kExpiredList) {
+    Unlink(id);
+    Insert(id);
+  }
+}
+
+void TimerWheel::Stop(uint32_t id) {
+  if (!IsActive(id))
+    return;
+  if (timers_[id].list != kExpiredList)
+    armed_count_--;
+  Unlink(id);
+}
+
+bool TimerWheel::IsActive(uint32_t id) const {
+  return id < timers_.size() && timers_[id].list != kNoList;
+}
+
+void TimerWheel::Advance(uint64_t now) {
+  while (now_ < now) {
+    const uint64_t next = NextEventTime();
+    if (next > now) {
+      now_ = now;
+      break;
+    }
+    now_ = next;
+
+    // Cascade first, so that the timers that are due right now end up in
+    // the first level slot that is processed next.
+    if ((now_ & (kSlots - 1)) == 0) {
+      for (int level = 1; level < kLevels; level++) {
+        const int slot = (now_ >> (level * kSlotBits)) & (kSlots - 1);
+        ProcessSlot(level * kSlots + slot);
+        if (slot != 0)
+          break;
+      }
+    }
+    ProcessSlot(now_ & (kSlots - 1));
+  }
+}
+
+uint32_t TimerWheel::PopExpired() {
+  const uint32_t id = expired_head_;
+  if (id != kNone)
+    Unlink(id);
+  return id;
+}
+
+uint64_t TimerWheel::NextEventTime() const {
+  if (armed_count_ == 0)
+    return UINT64_MAX;
+  uint64_t next = UINT64_MAX;
+  for (int level = 0; level < kLevels; level++)
+    next = std::min(next, NextSlotTime(level));
+  return next;
+}
+
+size_t TimerWheel::GetMemorySize() const {
+  return sizeof(*this) + timers_.capacity() * sizeof(timers_[0]);
+}
+
+void TimerWheel::Insert(uint32_t id) {
+  const uint64_t expiry = timers_[id].expiry;
+  const uint64_t delta = expiry > now_ ? expiry - now_ : 0;
+  int level = 0;
+  while (level < kLevels - 1 &&
+         delta >= uint64_t{1} << ((level + 1) * kSlotBits)) {
+    level++;
+  }
+  const int slot = (expiry >> (level * kSlotBits)) & (kSlots - 1);
+  Link(level * kSlots + slot, id);
+  armed_count_++;
+}
+
+void TimerWheel::Link(uint16_t list, uint32_t id) {
+  Timer& timer = timers_[id];
+  uint32_t* head = &expired_head_;
+  uint32_t* tail = &expired_tail_;
+  if (list != kExpiredList) {
+    head = &heads_[list];
+    tail = &tails_[list];
+    occupied_[list / 64] |= uint64_t{1} << (list % 64);
+  }
+  timer.list = list;
+  timer.prev = *tail;
+  timer.next = kNone;
+  if (*tail != kNone)
+    timers_[*tail].next = id;
+  else
+    *head = id;
+  *tail = id;
+}
+
+void TimerWheel::Unlink(uint32_t id) {
+  Timer& timer = timers_[id];
+  const uint16_t list = timer.list;
+  uint32_t* head = &expired_head_;
+  uint32_t* tail = &expired_tail_;
+  if (list != kExpiredList) {
+    head = &heads_[list];
+    tail = &tails_[list];
+  }
+  if (timer.prev != kNone)
+    timers_[timer.prev].next = timer.next;
+  else
+    *head = timer.next;
+  if (timer.next != kNone)
+    timers_[timer.next].prev = timer.prev;
+  else
+    *tail = timer.prev;
+  if (list != kExpiredList && *head == kNone)
+    occupied_[list / 64] &= ~(uint64_t{1} << (list % 64));
+  timer.list = kNoList;
+}
+
+void TimerWheel::ProcessSlot(uint16_t list) {
+  uint32_t id = heads_[list];
+  heads_[list] = kNone;
+  tails_[list] = kNone;
+  occupied_[list / 64] &= ~(uint64_t{1} << (list % 64));
+
+  while (id != kNone) {
+    const uint32_t next = timers_[id].next;
+    armed_count_--;
+    if (timers_[id].expiry <= now_)
+      Link(kExpiredList, id);
+    else
+      Insert(id);
+    id = next;
+  }
+}
+
+uint64_t TimerWheel::NextSlotTime(int level) const {
+  const int shift = level * kSlotBits;
+  // Slots are visited in order starting with the one after the current one,
+  // wrapping around at the end of the level.
+  const uint64_t base = (now_ >> shift) + 1;
+  const int from = base & (kSlots - 1);
+  const uint64_t* words = &occupied_[level * kSlots / 64];
+  int slot = FindFirstSet(words, from);
+  if (slot == -1)
+    slot = FindFirstSet(words, 0);
+  if (slot == -1)
+    return UINT64_MAX;
+  return (base + ((slot - from) & (kSlots - 1))) << shift;
+}
+
+}  // namespace node
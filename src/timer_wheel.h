@@ -0,0 +1,86 @@
+#ifndef SRC_TIMER_WHEEL_H_
+#define SRC_TIMER_WHEEL_H_
+
+#if defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+namespace node {
+
+// A hierarchical timing wheel for timeouts that are re-armed far more often
+// than they fire, like the idle timeouts of sockets. Times are in
+// milliseconds, timers are identified by small integers chosen by the caller.
+//
+// There are four levels of 256 slots. The first level has a slot for every
+// millisecond of the next 256, each slot of a higher level spans a whole
+// rotation of the level below it. When a lower level wraps around, the next
+// slot of the level above is cascaded into it. Starting, refreshing and
+// stopping a timer take constant time. Refresh() only updates the expiry;
+// the timer is moved when its old slot comes up, so re-arming a timer
+// thousands of times before it fires costs no more than doing it once.
+class TimerWheel {
+ public:
+  static const uint32_t kNone = UINT32_MAX;
+
+  explicit TimerWheel(uint64_t now);
+
+  // Arms timer |id| to expire at |now + duration|. |id| must not be armed.
+  void Start(uint32_t id, uint64_t now, uint64_t duration);
+  // Pushes the expiry of armed timer |id| back to |now| plus its duration.
+  void Refresh(uint32_t id, uint64_t now);
+  // Disarms timer |id|, which may be armed or expired but not yet popped.
+  void Stop(uint32_t id);
+  bool IsActive(uint32_t id) const;
+
+  // Moves every timer that expires at or before |now| to the expired list.
+  void Advance(uint64_t now);
+  // Removes and returns the timer that expired first, or kNone.
+  uint32_t PopExpired();
+  bool HasExpired() const { return expired_head_ != kNone; }
+
+  // The time at which Advance() has work to do next, either expiring or
+  // cascading timers, or UINT64_MAX if nothing is armed.
+  uint64_t NextEventTime() const;
+
+  size_t size() const { return armed_count_; }
+  size_t GetMemorySize() const;
+
+ private:
+  static const int kLevels = 4;
+  static const int kSlotBits = 8;
+  static const int kSlots = 1 << kSlotBits;
+  static const uint16_t kExpiredList = kLevels * kSlots;
+  static const uint16_t kNoList = kExpiredList + 1;
+
+  struct Timer {
+    uint64_t expiry;
+    uint32_t duration;
+    uint32_t prev;
+    uint32_t next;
+    uint16_t list;
+  };
+
+  void Insert(uint32_t id);
+  void Link(uint16_t list, uint32_t id);
+  void Unlink(uint32_t id);
+  void ProcessSlot(uint16_t list);
+  uint64_t NextSlotTime(int level) const;
+
+  uint64_t now_;
+  std::vector<Timer> timers_;
+  uint32_t heads_[kLevels * kSlots];
+  uint32_t tails_[kLevels * kSlots];
+  // One bit per slot that has timers in it.
+  uint64_t occupied_[kLevels * kSlots / 64] = {};
+  uint32_t expired_head_ = kNone;
+  uint32_t expired_tail_ = kNone;
+  size_t armed_count_ = 0;
+};
+
+}  // namespace node
+
+#endif  // defined(NODE_WANT_INTERNALS) && NODE_WANT_INTERNALS
+
+#endif  // SRC_TIMER_WHEEL_H_
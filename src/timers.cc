@@ -12,15 +12,18 @@ using v8::FunctionCallbackInfo;
 using v8::Integer;
 using v8::Local;
 using v8::Object;
+using v8::Uint32;
 using v8::Value;
 
 void SetupTimers(const FunctionCallbackInfo<Value>& args) {
   CHECK(args[0]->IsFunction());
   CHECK(args[1]->IsFunction());
+  CHECK(args[2]->IsFunction());
   auto env = Environment::GetCurrent(args);
 
   env->set_immediate_callback_function(args[0].As<Function>());
   env->set_timers_callback_function(args[1].As<Function>());
+  env->set_timer_wheel_callback_function(args[2].As<Function>());
 }
 
 void GetLibuvNow(const FunctionCallbackInfo<Value>& args) {
@@ -33,6 +36,43 @@ void ScheduleTimer(const FunctionCallbackInfo<Value>& args) {
   env->ScheduleTimer(args[0]->IntegerValue(env->context()).FromJust());
 }
 
+// The timer wheel is for unrefed timeouts that are refreshed often. Timer ids
+// are allocated by the JS side; start and refresh return the start time, in
+// the same clock as getLibuvNow().
+void StartWheelTimer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  CHECK(args[1]->IsNumber());
+  const uint32_t id = args[0].As<Uint32>()->Value();
+  const int64_t duration = args[1]->IntegerValue(env->context()).FromJust();
+  Local<Value> now = env->GetNow();
+  env->timer_wheel()->Start(id, uv_now(env->event_loop()), duration);
+  env->ScheduleTimerWheel();
+  args.GetReturnValue().Set(now);
+}
+
+void RefreshWheelTimer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  Local<Value> now = env->GetNow();
+  env->timer_wheel()->Refresh(args[0].As<Uint32>()->Value(),
+                              uv_now(env->event_loop()));
+  args.GetReturnValue().Set(now);
+}
+
+void StopWheelTimer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsUint32());
+  env->timer_wheel()->Stop(args[0].As<Uint32>()->Value());
+}
+
+void PopExpiredWheelTimer(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  const uint32_t id = env->timer_wheel()->PopExpired();
+  args.GetReturnValue().Set(
+      id == TimerWheel::kNone ? -1 : static_cast<int32_t>(id));
+}
+
 void ToggleTimerRef(const FunctionCallbackInfo<Value>& args) {
   Environment::GetCurrent(args)->ToggleTimerRef(args[0]->IsTrue());
 }
@@ -51,6 +91,10 @@ void Initialize(Local<Object> target,
   env->SetMethod(target, "setupTimers", SetupTimers);
   env->SetMethod(target, "scheduleTimer", ScheduleTimer);
   env->SetMethod(target, "toggleTimerRef", ToggleTimerRef);
+  env->SetMethod(target, "startWheelTimer", StartWheelTimer);
+  env->SetMethod(target, "refreshWheelTimer", RefreshWheelTimer);
+  env->SetMethod(target, "stopWheelTimer", StopWheelTimer);
+  env->SetMethod(target, "popExpiredWheelTimer", PopExpiredWheelTimer);
   env->SetMethod(target, "toggleImmediateRef", ToggleImmediateRef);
 
   target->Set(env->context(),
@@ -26,21 +26,43 @@
 #include "node_crypto_bio.h"  // NodeBIO
 // ClientHelloParser
 #include "node_crypto_clienthello-inl.h"
+#include "node_errors.h"
 #include "node_internals.h"
 #include "stream_base-inl.h"
 #include "util-inl.h"
 
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/tls.h>)
+#define NODE_HAVE_KERNEL_TLS 1
+#include <linux/tls.h>  // TLS_TX, tls12_crypto_info_aes_gcm_*
+#include <netinet/in.h>  // IPPROTO_TCP
+#include <netinet/tcp.h>  // TCP_ULP
+#include <openssl/kdf.h>  // EVP_PKEY_TLS1_PRF
+#include <sys/socket.h>  // setsockopt(), sendmsg()
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#endif  // __has_include(<linux/tls.h>)
+#endif  // defined(__linux__) && defined(__has_include)
+
 namespace node {
 
+using crypto::BIOBufferPool;
 using crypto::SecureContext;
 using crypto::SSLWrap;
+using v8::Boolean;
 using v8::Context;
 using v8::DontDelete;
 using v8::EscapableHandleScope;
 using v8::Exception;
+using v8::Float64Array;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Integer;
 using v8::Isolate;
 using v8::Local;
 using v8::Object;
@@ -49,6 +71,150 @@ using v8::Signature;
 using v8::String;
 using v8::Value;
 
+#ifdef NODE_HAVE_KERNEL_TLS
+namespace {
+
+// Derives the TLS 1.2 key block from the master secret, as described in
+// RFC 5246, section 6.3.
+bool DeriveKeyBlock(SSL* ssl,
+                    const EVP_MD* md,
+                    unsigned char* out,
+                    size_t len) {
+  unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+  const size_t master_len =
+      SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+
+  unsigned char seed[2 * SSL3_RANDOM_SIZE];
+  SSL_get_server_random(ssl, seed, SSL3_RANDOM_SIZE);
+  SSL_get_client_random(ssl, seed + SSL3_RANDOM_SIZE, SSL3_RANDOM_SIZE);
+
+  static const unsigned char label[] = "key expansion";
+  crypto::EVPKeyCtxPointer ctx(EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr));
+  const bool ok =
+      ctx &&
+      EVP_PKEY_derive_init(ctx.get()) > 0 &&
+      EVP_PKEY_CTX_set_tls1_prf_md(ctx.get(), md) > 0 &&
+      EVP_PKEY_CTX_set1_tls1_prf_secret(ctx.get(), master, master_len) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(ctx.get(), label,
+                                      sizeof(label) - 1) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(ctx.get(), seed, sizeof(seed)) > 0 &&
+      EVP_PKEY_derive(ctx.get(), out, &len) > 0;
+
+  OPENSSL_cleanse(master, sizeof(master));
+  return ok;
+}
+
+
+template <typename CryptoInfo, uint16_t cipher_type>
+bool SetTransmitKey(int fd,
+                    const unsigned char* key,
+                    const unsigned char* salt) {
+  CryptoInfo info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, salt, sizeof(info.salt));
+
+  // The Finished message was record 0 in this direction, and nothing has
+  // been sent since. The explicit nonce only has to be unique, so it is the
+  // sequence number as well, like RFC 5288 suggests.
+  info.rec_seq[sizeof(info.rec_seq) - 1] = 1;
+  memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+
+  const int err = setsockopt(fd, SOL_TLS, TLS_TX, &info, sizeof(info));
+  OPENSSL_cleanse(&info, sizeof(info));
+  return err == 0;
+}
+
+
+// Configures the kernel to encrypt the records written to `fd` with the
+// keys negotiated by `ssl`. Only TLS 1.2 with AES-GCM is supported.
+bool StartKernelTLS(SSL* ssl, int fd, bool is_server) {
+  if (fd < 0 || SSL_version(ssl) != TLS1_2_VERSION)
+    return false;
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (cipher == nullptr)
+    return false;
+
+  // All TLS 1.2 AES-GCM suites use SHA-256 for the PRF with 128 bit keys
+  // and SHA-384 with 256 bit keys.
+  size_t key_len;
+  const EVP_MD* md;
+  bool (*set_transmit_key)(int, const unsigned char*, const unsigned char*);
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      md = EVP_sha256();
+      set_transmit_key = SetTransmitKey<tls12_crypto_info_aes_gcm_128,
+                                        TLS_CIPHER_AES_GCM_128>;
+      break;
+#ifdef TLS_CIPHER_AES_GCM_256
+    case NID_aes_256_gcm:
+      key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      md = EVP_sha384();
+      set_transmit_key = SetTransmitKey<tls12_crypto_info_aes_gcm_256,
+                                        TLS_CIPHER_AES_GCM_256>;
+      break;
+#endif
+    default:
+      return false;
+  }
+
+  // AEAD suites have no MAC keys, so the key block is made of the client
+  // and server write keys followed by the client and server implicit IVs.
+  static const size_t kSaltLength = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+  unsigned char block[2 * 32 + 2 * kSaltLength];
+  if (!DeriveKeyBlock(ssl, md, block, 2 * key_len + 2 * kSaltLength))
+    return false;
+
+  const unsigned char* key = block + (is_server ? key_len : 0);
+  const unsigned char* salt =
+      block + 2 * key_len + (is_server ? kSaltLength : 0);
+
+  // If the module is not loaded, attaching the ULP fails. If only setting
+  // the key fails, the ULP stays attached but passes data through as is.
+  const bool ok =
+      setsockopt(fd, IPPROTO_TCP, TCP_ULP, "tls", sizeof("tls")) == 0 &&
+      set_transmit_key(fd, key, salt);
+
+  OPENSSL_cleanse(block, sizeof(block));
+  return ok;
+}
+
+
+// Sends a close_notify alert through the kernel, which has to be told
+// that the record is not application data.
+void SendKernelTLSCloseNotify(int fd) {
+  unsigned char alert[] = { 1 /* warning */, 0 /* close_notify */ };
+  char control[CMSG_SPACE(sizeof(unsigned char))];
+  memset(control, 0, sizeof(control));
+
+  iovec iov;
+  iov.iov_base = alert;
+  iov.iov_len = sizeof(alert);
+
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_TLS;
+  cmsg->cmsg_type = TLS_SET_RECORD_TYPE;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(unsigned char));
+  *CMSG_DATA(cmsg) = 21;  // alert
+
+  // Like SSL_shutdown() on the regular path, this is best effort.
+  sendmsg(fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+}
+
+}  // anonymous namespace
+#endif  // NODE_HAVE_KERNEL_TLS
+
 TLSWrap::TLSWrap(Environment* env,
                  Kind kind,
                  StreamBase* stream,
@@ -256,8 +422,33 @@ void TLSWrap::EncOut() {
   if (ssl_ == nullptr)
     return;
 
+  if (kernel_tls_ == kKernelTLSActive) {
+    // OpenSSL's state for outgoing records is stale once the kernel
+    // encrypts them, so anything it produced cannot be sent. The peer
+    // would never see a renegotiation handshake, a KeyUpdate or an alert
+    // that OpenSSL sends on its own, so the socket must fail instead.
+    if (BIO_pending(enc_out_) != 0) {
+      crypto::NodeBIO::FromBIO(enc_out_)->Reset();
+      if (!shutdown_) {
+        HandleScope handle_scope(env()->isolate());
+        Context::Scope context_scope(env()->context());
+        Local<Value> arg;
+        if (SSL_in_init(ssl_.get())) {
+          arg = ERR_TLS_RENEGOTIATION_DISABLED(
+              env()->isolate(),
+              "TLS session renegotiation disabled for this socket");
+        } else {
+          arg = ERR_TLS_KERNEL_RECORD_DROPPED(env()->isolate());
+        }
+        MakeCallback(env()->onerror_string(), 1, &arg);
+      }
+    }
+    return;
+  }
+
   // No data to write
   if (BIO_pending(enc_out_) == 0) {
+    MaybeStartKernelTLS();
     if (pending_cleartext_input_.empty())
       InvokeQueued(0);
     return;
@@ -315,6 +506,12 @@ void TLSWrap::OnStreamAfterWrite(WriteWrap* req_wrap, int status) {
     return;
   }
 
+  // Data is written as is with kernel TLS, there is nothing to commit.
+  if (kernel_tls_ == kKernelTLSActive) {
+    InvokeQueued(0);
+    return;
+  }
+
   // Commit
   crypto::NodeBIO::FromBIO(enc_out_)->Read(nullptr, write_size_);
 
@@ -604,6 +801,17 @@ int TLSWrap::DoWrite(WriteWrap* w,
       empty = false;
       break;
     }
+
+  if (kernel_tls_ == kKernelTLSPending) {
+    MaybeStartKernelTLS();
+    // OpenSSL's sequence number for outgoing records cannot be read back,
+    // so the kernel can only take over before it has encrypted any data.
+    if (kernel_tls_ == kKernelTLSPending && !empty)
+      kernel_tls_ = kKernelTLSOff;
+  }
+  if (kernel_tls_ == kKernelTLSActive)
+    return DoKernelTLSWrite(w, bufs, count);
+
   if (empty) {
     ClearOut();
     // However, if there is any data that should be written to the socket,
@@ -663,6 +871,50 @@ int TLSWrap::DoWrite(WriteWrap* w,
 }
 
 
+// Hands the encryption of outgoing records to the kernel once the handshake
+// is done and OpenSSL's records have all been written to the socket. If the
+// kernel or the negotiated cipher does not support it, OpenSSL keeps
+// encrypting records as before.
+void TLSWrap::MaybeStartKernelTLS() {
+  if (kernel_tls_ != kKernelTLSPending ||
+      !established_ ||
+      ssl_ == nullptr ||
+      write_size_ != 0 ||
+      BIO_pending(enc_out_) != 0 ||
+      !pending_cleartext_input_.empty()) {
+    return;
+  }
+
+#ifdef NODE_HAVE_KERNEL_TLS
+  if (StartKernelTLS(ssl_.get(), GetFD(), is_server())) {
+    kernel_tls_ = kKernelTLSActive;
+    return;
+  }
+#endif  // NODE_HAVE_KERNEL_TLS
+  kernel_tls_ = kKernelTLSOff;
+}
+
+
+int TLSWrap::DoKernelTLSWrite(WriteWrap* w, uv_buf_t* bufs, size_t count) {
+  CHECK_NULL(current_write_);
+
+  StreamWriteResult res = underlying_stream()->Write(bufs, count);
+  if (res.err != 0)
+    return res.err;
+
+  current_write_ = w;
+  write_callback_scheduled_ = true;
+
+  if (!res.async) {
+    env()->SetImmediate([](Environment* env, void* data) {
+      static_cast<TLSWrap*>(data)->OnStreamAfterWrite(nullptr, 0);
+    }, this, object());
+  }
+
+  return 0;
+}
+
+
 uv_buf_t TLSWrap::OnStreamAlloc(size_t suggested_size) {
   CHECK_NOT_NULL(ssl_);
 
@@ -719,8 +971,15 @@ ShutdownWrap* TLSWrap::CreateShutdownWrap(Local<Object> req_wrap_object) {
 int TLSWrap::DoShutdown(ShutdownWrap* req_wrap) {
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
-  if (ssl_ && SSL_shutdown(ssl_.get()) == 0)
+  if (ssl_ && kernel_tls_ == kKernelTLSActive) {
+#ifdef NODE_HAVE_KERNEL_TLS
+    SendKernelTLSCloseNotify(GetFD());
+#endif  // NODE_HAVE_KERNEL_TLS
+    SSL_set_shutdown(ssl_.get(),
+                     SSL_get_shutdown(ssl_.get()) | SSL_SENT_SHUTDOWN);
+  } else if (ssl_ && SSL_shutdown(ssl_.get()) == 0) {
     SSL_shutdown(ssl_.get());
+  }
 
   shutdown_ = true;
   EncOut();
@@ -792,6 +1051,22 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TLSWrap::EnableKernelTLS(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  CHECK_NOT_NULL(wrap->ssl_);
+  CHECK(!wrap->established_);
+  wrap->kernel_tls_ = kKernelTLSPending;
+}
+
+
+void TLSWrap::IsKernelTLSActive(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+  args.GetReturnValue().Set(wrap->kernel_tls_ == kKernelTLSActive);
+}
+
+
 void TLSWrap::EnableCertCb(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -905,6 +1180,18 @@ void TLSWrap::MemoryInfo(MemoryTracker* tracker) const {
 }
 
 
+static void GetBIOBufferPoolStats(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  CHECK(args[0]->IsFloat64Array());
+  Local<Float64Array> array = args[0].As<Float64Array>();
+  CHECK_EQ(array->Length(), static_cast<size_t>(BIOBufferPool::kNumFields));
+  double* fields = static_cast<double*>(array->Buffer()->GetContents().Data());
+  BIOBufferPool* pool = env->bio_buffer_pool();
+  for (int i = 0; i < BIOBufferPool::kNumFields; i++)
+    fields[i] = static_cast<double>(pool->stat(BIOBufferPool::Fields(i)));
+}
+
+
 void TLSWrap::Initialize(Local<Object> target,
                          Local<Value> unused,
                          Local<Context> context,
@@ -912,6 +1199,19 @@ void TLSWrap::Initialize(Local<Object> target,
   Environment* env = Environment::GetCurrent(context);
 
   env->SetMethod(target, "wrap", TLSWrap::Wrap);
+  env->SetMethod(target, "getBIOBufferPoolStats", GetBIOBufferPoolStats);
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "kBIOBufferPoolFields"),
+              Integer::New(env->isolate(),
+                           BIOBufferPool::kNumFields)).FromJust();
+#ifdef NODE_HAVE_KERNEL_TLS
+  const bool have_kernel_tls = true;
+#else
+  const bool have_kernel_tls = false;
+#endif  // NODE_HAVE_KERNEL_TLS
+  target->Set(context,
+              FIXED_ONE_BYTE_STRING(env->isolate(), "haveKernelTLS"),
+              Boolean::New(env->isolate(), have_kernel_tls)).FromJust();
 
   Local<FunctionTemplate> t = BaseObject::MakeLazilyInitializedJSTemplate(env);
   Local<String> tlsWrapString =
@@ -936,6 +1236,8 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
+  env->SetProtoMethod(t, "enableKernelTLS", EnableKernelTLS);
+  env->SetProtoMethod(t, "isKernelTLSActive", IsKernelTLSActive);
 
   StreamBase::AddMethods<TLSWrap>(env, t);
   SSLWrap<TLSWrap>::AddMethods(env, t);
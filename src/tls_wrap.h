@@ -108,6 +108,8 @@ class TLSWrap : public AsyncWrap,
   void EncOut();
   bool ClearIn();
   void ClearOut();
+  void MaybeStartKernelTLS();
+  int DoKernelTLSWrite(WriteWrap* w, uv_buf_t* bufs, size_t count);
   bool InvokeQueued(int status, const char* error_str = nullptr);
 
   inline void Cycle() {
@@ -142,6 +144,9 @@ class TLSWrap : public AsyncWrap,
   static void EnableCertCb(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void EnableKernelTLS(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void IsKernelTLSActive(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
   static int SelectSNIContextCallback(SSL* s, int* ad, void* arg);
@@ -160,6 +165,15 @@ class TLSWrap : public AsyncWrap,
   std::string error_;
   int cycle_depth_ = 0;
 
+  // Encryption of outgoing records can be handed to the kernel (kTLS) once
+  // the handshake is done. Received records are still decrypted by OpenSSL.
+  enum KernelTLSState {
+    kKernelTLSOff,
+    kKernelTLSPending,
+    kKernelTLSActive
+  };
+  KernelTLSState kernel_tls_ = kKernelTLSOff;
+
   // If true - delivered EOF to the js-land, either after `close_notify`, or
   // after the `UV_EOF` on socket.
   bool eof_ = false;
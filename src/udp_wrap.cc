@@ -27,6 +27,10 @@
 #include "req_wrap-inl.h"
 #include "util-inl.h"
 
+#include <string.h>
+#include <algorithm>
+#include <memory>
+
 namespace node {
 
 using v8::Array;
@@ -53,6 +57,11 @@ class SendWrap : public ReqWrap<uv_udp_send_t> {
   SendWrap(Environment* env, Local<Object> req_wrap_obj, bool have_callback);
   inline bool have_callback() const;
   size_t msg_size;
+  // The requests for all but the first datagram of a batch, which req()
+  // sends, and how many datagrams of the batch are still in flight.
+  std::unique_ptr<uv_udp_send_t[]> batch_reqs;
+  size_t pending = 1;
+  int status = 0;
 
   SET_NO_MEMORY_INFO()
   SET_MEMORY_INFO_NAME(SendWrap)
@@ -81,7 +90,11 @@ UDPWrap::UDPWrap(Environment* env, Local<Object> object)
                  object,
                  reinterpret_cast<uv_handle_t*>(&handle_),
                  AsyncWrap::PROVIDER_UDPWRAP) {
-  int r = uv_udp_init(env->event_loop(), &handle_);
+  // recvmmsg() is only used when OnAlloc() hands out room for more than one
+  // datagram, i.e. after setRecvBatchSize().
+  int r = uv_udp_init_ex(env->event_loop(),
+                         &handle_,
+                         AF_UNSPEC | UV_UDP_RECVMMSG);
   CHECK_EQ(r, 0);  // can't fail anyway
 }
 
@@ -119,6 +132,9 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "send", Send);
   env->SetProtoMethod(t, "bind6", Bind6);
   env->SetProtoMethod(t, "send6", Send6);
+  env->SetProtoMethod(t, "sendBatch", SendBatch);
+  env->SetProtoMethod(t, "sendBatch6", SendBatch6);
+  env->SetProtoMethod(t, "setRecvBatchSize", SetRecvBatchSize);
   env->SetProtoMethod(t, "recvStart", RecvStart);
   env->SetProtoMethod(t, "recvStop", RecvStop);
   env->SetProtoMethod(t, "getsockname",
@@ -130,6 +146,8 @@ void UDPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "setMulticastLoopback", SetMulticastLoopback);
   env->SetProtoMethod(t, "setBroadcast", SetBroadcast);
   env->SetProtoMethod(t, "setTTL", SetTTL);
+  env->SetProtoMethod(t, "setGSO", SetGSO);
+  env->SetProtoMethod(t, "setGRO", SetGRO);
   env->SetProtoMethod(t, "bufferSize", BufferSize);
 
   t->Inherit(HandleWrap::GetConstructorTemplate(env));
@@ -153,6 +171,7 @@ void UDPWrap::Initialize(Local<Object> target,
 
   Local<Object> constants = Object::New(env->isolate());
   NODE_DEFINE_CONSTANT(constants, UV_UDP_IPV6ONLY);
+  NODE_DEFINE_CONSTANT(constants, UV_UDP_REUSEPORT);
   target->Set(context,
               env->constants_string(),
               constants).FromJust();
@@ -292,6 +311,8 @@ X(SetTTL, uv_udp_set_ttl)
 X(SetBroadcast, uv_udp_set_broadcast)
 X(SetMulticastTTL, uv_udp_set_multicast_ttl)
 X(SetMulticastLoopback, uv_udp_set_multicast_loop)
+X(SetGSO, uv_udp_set_gso)
+X(SetGRO, uv_udp_set_gro)
 
 #undef X
 
@@ -434,6 +455,151 @@ void UDPWrap::Send6(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void UDPWrap::DoSendBatch(const FunctionCallbackInfo<Value>& args,
+                          int family) {
+  Environment* env = Environment::GetCurrent(args);
+
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+
+  // sendBatch(req, list, ports, addresses, list.length, hasCallback)
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsArray());
+  CHECK(args[2]->IsArray());
+  CHECK(args[3]->IsArray());
+  CHECK(args[4]->IsUint32());
+  CHECK(args[5]->IsBoolean());
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  Local<Array> messages = args[1].As<Array>();
+  Local<Array> ports = args[2].As<Array>();
+  Local<Array> addresses = args[3].As<Array>();
+  const size_t count = args[4].As<Uint32>()->Value();
+  const bool have_callback = args[5]->IsTrue();
+  CHECK_GT(count, 0);
+
+  MaybeStackBuffer<uv_buf_t, 16> bufs(count);
+  MaybeStackBuffer<sockaddr_storage, 16> addrs(count);
+  MaybeStackBuffer<uv_buf_t*, 16> buf_ptrs(count);
+  MaybeStackBuffer<unsigned int, 16> nbufs(count);
+  MaybeStackBuffer<sockaddr*, 16> addr_ptrs(count);
+  size_t msg_size = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    Local<Value> message = messages->Get(env->context(), i).ToLocalChecked();
+    Local<Value> port = ports->Get(env->context(), i).ToLocalChecked();
+    Local<Value> address =
+        addresses->Get(env->context(), i).ToLocalChecked();
+    CHECK(port->IsUint32());
+    CHECK(address->IsString());
+
+    size_t length = Buffer::Length(message);
+    bufs[i] = uv_buf_init(Buffer::Data(message), length);
+    msg_size += length;
+
+    node::Utf8Value ip(env->isolate(), address);
+    const uint16_t port_value = port.As<Uint32>()->Value();
+    int err;
+    switch (family) {
+    case AF_INET:
+      err = uv_ip4_addr(*ip,
+                        port_value,
+                        reinterpret_cast<sockaddr_in*>(&addrs[i]));
+      break;
+    case AF_INET6:
+      err = uv_ip6_addr(*ip,
+                        port_value,
+                        reinterpret_cast<sockaddr_in6*>(&addrs[i]));
+      break;
+    default:
+      CHECK(0 && "unexpected address family");
+      ABORT();
+    }
+    if (err != 0)
+      return args.GetReturnValue().Set(err);
+
+    buf_ptrs[i] = &bufs[i];
+    nbufs[i] = 1;
+    addr_ptrs[i] = reinterpret_cast<sockaddr*>(&addrs[i]);
+  }
+
+  // Send what the socket takes right away with as few system calls as
+  // possible, only the rest is queued.
+  int sent = uv_udp_try_send2(&wrap->handle_,
+                              count,
+                              *buf_ptrs,
+                              *nbufs,
+                              *addr_ptrs,
+                              0);
+  if (sent < 0)
+    sent = 0;
+  if (static_cast<size_t>(sent) == count)
+    return args.GetReturnValue().Set(0);
+
+  SendWrap* req_wrap;
+  {
+    AsyncHooks::DefaultTriggerAsyncIdScope trigger_scope(wrap);
+    req_wrap = new SendWrap(env, req_wrap_obj, have_callback);
+  }
+  req_wrap->msg_size = msg_size;
+
+  int err = req_wrap->Dispatch(uv_udp_send,
+                               &wrap->handle_,
+                               &bufs[sent],
+                               1,
+                               addr_ptrs[sent],
+                               OnSend);
+  if (err) {
+    delete req_wrap;
+    return args.GetReturnValue().Set(err);
+  }
+
+  const size_t queued = count - sent;
+  if (queued > 1)
+    req_wrap->batch_reqs.reset(new uv_udp_send_t[queued - 1]);
+  for (size_t i = 1; i < queued; i++) {
+    uv_udp_send_t* req = &req_wrap->batch_reqs[i - 1];
+    req->data = req_wrap;
+    err = uv_udp_send(req,
+                      &wrap->handle_,
+                      &bufs[sent + i],
+                      1,
+                      addr_ptrs[sent + i],
+                      OnSend);
+    if (err == 0)
+      req_wrap->pending++;
+    else if (req_wrap->status == 0)
+      req_wrap->status = err;
+  }
+
+  args.GetReturnValue().Set(static_cast<uint32_t>(queued));
+}
+
+
+void UDPWrap::SendBatch(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET);
+}
+
+
+void UDPWrap::SendBatch6(const FunctionCallbackInfo<Value>& args) {
+  DoSendBatch(args, AF_INET6);
+}
+
+
+void UDPWrap::SetRecvBatchSize(const FunctionCallbackInfo<Value>& args) {
+  UDPWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap,
+                          args.Holder(),
+                          args.GetReturnValue().Set(UV_EBADF));
+  CHECK(args[0]->IsUint32());
+  wrap->recv_batch_size_ = std::max(
+      std::min(args[0].As<Uint32>()->Value(), kMaxRecvBatch), 1u);
+  args.GetReturnValue().Set(wrap->recv_batch_size_);
+}
+
+
 void UDPWrap::RecvStart(const FunctionCallbackInfo<Value>& args) {
   UDPWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap,
@@ -459,6 +625,13 @@ void UDPWrap::RecvStop(const FunctionCallbackInfo<Value>& args) {
 
 void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
   SendWrap* req_wrap = static_cast<SendWrap*>(req->data);
+  // Every datagram of a batch completes on its own, the callback runs once
+  // with the first error, if any.
+  if (status < 0 && req_wrap->status == 0)
+    req_wrap->status = status;
+  if (--req_wrap->pending > 0)
+    return;
+  status = req_wrap->status;
   if (req_wrap->have_callback()) {
     Environment* env = req_wrap->env();
     HandleScope handle_scope(env->isolate());
@@ -476,46 +649,137 @@ void UDPWrap::OnSend(uv_udp_send_t* req, int status) {
 void UDPWrap::OnAlloc(uv_handle_t* handle,
                       size_t suggested_size,
                       uv_buf_t* buf) {
+  UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
+  Environment* env = wrap->env();
+
+  // Batches are received into a buffer that all sockets of the Environment
+  // share; the datagrams are copied out of it before it is handed back.
+  if (wrap->recv_batch_size_ > 1 && !env->udp_recv_buffer_in_use()) {
+    if (env->udp_recv_buffer() == nullptr)
+      env->set_udp_recv_buffer(new char[kMaxRecvBatch * kRecvSlotSize]);
+    env->set_udp_recv_buffer_in_use(true);
+    buf->base = env->udp_recv_buffer();
+    buf->len = wrap->recv_batch_size_ * kRecvSlotSize;
+    return;
+  }
+
   buf->base = node::Malloc(suggested_size);
   buf->len = suggested_size;
 }
 
 
+void UDPWrap::ReleaseRecvBuffer(const uv_buf_t* buf) {
+  if (buf->base == nullptr)
+    return;
+  if (buf->base == env()->udp_recv_buffer())
+    env()->set_udp_recv_buffer_in_use(false);
+  else
+    free(buf->base);
+}
+
+
+void UDPWrap::EmitBatch(const uv_buf_t* buf) {
+  const size_t count = recv_batch_.size();
+  if (count == 0)
+    return ReleaseRecvBuffer(buf);
+
+  size_t total = 0;
+  for (const BatchedMessage& message : recv_batch_)
+    total += message.length;
+
+  // One allocation for the whole batch, JS hands out slices of it.
+  char* data = node::Malloc(std::max<size_t>(total, 1));
+  Local<Array> lengths = Array::New(env()->isolate(), count);
+  Local<Array> rinfos = Array::New(env()->isolate(), count);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    const BatchedMessage& message = recv_batch_[i];
+    memcpy(data + offset, buf->base + message.offset, message.length);
+    offset += message.length;
+    lengths->Set(env()->context(),
+                 i,
+                 Integer::New(env()->isolate(), message.length)).FromJust();
+    rinfos->Set(env()->context(),
+                i,
+                AddressToJS(env(), reinterpret_cast<const sockaddr*>(
+                    &message.address))).FromJust();
+  }
+  recv_batch_.clear();
+  ReleaseRecvBuffer(buf);
+
+  Local<Value> argv[] = {
+    Integer::New(env()->isolate(), count),
+    object(),
+    Buffer::New(env(), data, total).ToLocalChecked(),
+    lengths,
+    rinfos
+  };
+  MakeCallback(env()->onmessagebatch_string(), arraysize(argv), argv);
+}
+
+
 void UDPWrap::OnRecv(uv_udp_t* handle,
                      ssize_t nread,
                      const uv_buf_t* buf,
                      const struct sockaddr* addr,
                      unsigned int flags) {
-  if (nread == 0 && addr == nullptr) {
-    if (buf->base != nullptr)
-      free(buf->base);
-    return;
-  }
-
   UDPWrap* wrap = static_cast<UDPWrap*>(handle->data);
   Environment* env = wrap->env();
 
+  // The datagrams of a batch are collected and delivered to JS together,
+  // once libuv is done with the buffer.
+  if (flags & UV_UDP_MMSG_CHUNK) {
+    if (addr == nullptr)
+      return;
+    BatchedMessage message;
+    message.offset = buf->base - env->udp_recv_buffer();
+    message.length = nread;
+    memcpy(&message.address,
+           addr,
+           addr->sa_family == AF_INET6 ? sizeof(sockaddr_in6) :
+                                         sizeof(sockaddr_in));
+    wrap->recv_batch_.push_back(message);
+    return;
+  }
+
   HandleScope handle_scope(env->isolate());
   Context::Scope context_scope(env->context());
 
+  if (flags & UV_UDP_MMSG_FREE)
+    return wrap->EmitBatch(buf);
+
+  if (nread == 0 && addr == nullptr)
+    return wrap->ReleaseRecvBuffer(buf);
+
   Local<Object> wrap_obj = wrap->object();
   Local<Value> argv[] = {
     Integer::New(env->isolate(), nread),
     wrap_obj,
     Undefined(env->isolate()),
+    Undefined(env->isolate()),
     Undefined(env->isolate())
   };
 
   if (nread < 0) {
-    if (buf->base != nullptr)
-      free(buf->base);
+    wrap->ReleaseRecvBuffer(buf);
     wrap->MakeCallback(env->onmessage_string(), arraysize(argv), argv);
     return;
   }
 
-  char* base = node::UncheckedRealloc(buf->base, nread);
+  char* base;
+  if (buf->base == env->udp_recv_buffer()) {
+    // A single datagram in the shared buffer, without recvmmsg().
+    base = node::Malloc(nread);
+    memcpy(base, buf->base, nread);
+    wrap->ReleaseRecvBuffer(buf);
+  } else {
+    base = node::UncheckedRealloc(buf->base, nread);
+  }
   argv[2] = Buffer::New(env, base, nread).ToLocalChecked();
   argv[3] = AddressToJS(env, addr);
+  // With GRO, several datagrams of this size may be coalesced in |base|.
+  argv[4] = Integer::NewFromUnsigned(
+      env->isolate(), uv_udp_get_gro_segment_size(handle));
   wrap->MakeCallback(env->onmessage_string(), arraysize(argv), argv);
 }
 
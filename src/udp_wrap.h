@@ -30,6 +30,8 @@
 #include "uv.h"
 #include "v8.h"
 
+#include <vector>
+
 namespace node {
 
 class UDPWrap: public HandleWrap {
@@ -48,6 +50,10 @@ class UDPWrap: public HandleWrap {
   static void Send(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Bind6(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void Send6(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendBatch6(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetRecvBatchSize(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStart(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void RecvStop(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void AddMembership(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -59,6 +65,8 @@ class UDPWrap: public HandleWrap {
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetBroadcast(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void SetTTL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetGSO(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetGRO(const v8::FunctionCallbackInfo<v8::Value>& args);
   static void BufferSize(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   static v8::Local<v8::Object> Instantiate(Environment* env,
@@ -71,6 +79,18 @@ class UDPWrap: public HandleWrap {
  private:
   typedef uv_udp_t HandleType;
 
+  // Most datagrams received with one recvmmsg() call, and the size of the
+  // slot each of them gets in the receive buffer.
+  static const unsigned int kMaxRecvBatch = 32;
+  static const size_t kRecvSlotSize = 64 * 1024;
+
+  // A datagram that is part of a batch still being received.
+  struct BatchedMessage {
+    size_t offset;
+    size_t length;
+    sockaddr_storage address;
+  };
+
   template <typename T,
             int (*F)(const typename T::HandleType*, sockaddr*, int*)>
   friend void GetSockOrPeerName(const v8::FunctionCallbackInfo<v8::Value>&);
@@ -81,6 +101,8 @@ class UDPWrap: public HandleWrap {
                      int family);
   static void DoSend(const v8::FunctionCallbackInfo<v8::Value>& args,
                      int family);
+  static void DoSendBatch(const v8::FunctionCallbackInfo<v8::Value>& args,
+                          int family);
   static void SetMembership(const v8::FunctionCallbackInfo<v8::Value>& args,
                             uv_membership membership);
 
@@ -93,8 +115,12 @@ class UDPWrap: public HandleWrap {
                      const uv_buf_t* buf,
                      const struct sockaddr* addr,
                      unsigned int flags);
+  void EmitBatch(const uv_buf_t* buf);
+  void ReleaseRecvBuffer(const uv_buf_t* buf);
 
   uv_udp_t handle_;
+  unsigned int recv_batch_size_ = 1;
+  std::vector<BatchedMessage> recv_batch_;
 };
 
 }  // namespace node
@@ -14,4 +14,6 @@ runBenchmark('dgram', ['address=true',
                        'len=1',
                        'n=1',
                        'num=1',
+                       'offload=none',
+                       'segments=1',
                        'type=send']);
@@ -16,8 +16,11 @@ runBenchmark('http',
                'benchmarker=test-double-http',
                'c=1',
                'e=0',
+               'fields=2',
                'url=long',
                'arg=string',
+               'api=writeHead',
+               'batch=1',
                'chunkedEnc=true',
                'chunks=0',
                'dur=0.1',
@@ -27,6 +30,7 @@ runBenchmark('http',
                'len=1',
                'method=write',
                'n=1',
+               'pipeline=1',
                'res=normal',
                'type=asc',
                'value=X-Powered-By'
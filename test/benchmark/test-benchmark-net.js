@@ -10,8 +10,13 @@ const runBenchmark = require('../common/benchmark');
 
 runBenchmark('net',
              [
+               'concurrency=1',
+               'conns=1',
                'dur=0',
                'len=1024',
-               'type=buf'
+               'n=1',
+               'sockets=1',
+               'type=buf',
+               'workers=1'
              ],
              { NODEJS_BENCHMARK_ZERO_ALLOWED: 1 });
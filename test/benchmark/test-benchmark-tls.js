@@ -18,6 +18,7 @@ runBenchmark('tls',
              [
                'concurrency=1',
                'dur=0.1',
+               'kernel=0',
                'n=1',
                'size=2',
                'securing=SecurePair',
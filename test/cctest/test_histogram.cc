@@ -0,0 +1,108 @@
+#include "histogram.h"
+#include "histogram-inl.h"
+
+#include <math.h>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using node::Histogram;
+
+TEST(HistogramTest, Empty) {
+  Histogram h(3600000000000);
+  EXPECT_EQ(0, h.Count());
+  EXPECT_EQ(0, h.Min());
+  EXPECT_EQ(0, h.Max());
+  EXPECT_TRUE(isnan(h.Mean()));
+  EXPECT_TRUE(isnan(h.Stddev()));
+  EXPECT_EQ(0, h.Percentile(50));
+
+  int calls = 0;
+  h.Percentiles([&](double, int64_t) { calls++; });
+  EXPECT_EQ(0, calls);
+}
+
+TEST(HistogramTest, Statistics) {
+  Histogram h(3600000000000);
+  EXPECT_TRUE(h.Record(1));
+  EXPECT_TRUE(h.Record(2));
+  EXPECT_TRUE(h.Record(3));
+  EXPECT_TRUE(h.Record(4));
+  EXPECT_EQ(4, h.Count());
+  EXPECT_EQ(1, h.Min());
+  EXPECT_EQ(4, h.Max());
+  EXPECT_DOUBLE_EQ(2.5, h.Mean());
+  EXPECT_DOUBLE_EQ(sqrt(1.25), h.Stddev());
+  EXPECT_EQ(2, h.Percentile(50));
+  EXPECT_EQ(4, h.Percentile(100));
+
+  h.Reset();
+  EXPECT_EQ(0, h.Count());
+  EXPECT_EQ(0, h.Max());
+}
+
+TEST(HistogramTest, OutOfRange) {
+  Histogram h(1 << 20);
+  EXPECT_FALSE(h.Record(-1));
+  EXPECT_FALSE(h.Record((1 << 20) + 1));
+  EXPECT_TRUE(h.Record(1 << 20));
+  EXPECT_EQ(1, h.Count());
+}
+
+TEST(HistogramTest, Precision) {
+  Histogram h(3600000000000);
+  for (int64_t i = 1; i <= 1000000; i++)
+    EXPECT_TRUE(h.Record(i * 1000));
+  EXPECT_EQ(1000, h.Min());
+  EXPECT_EQ(1000000000, h.Max());
+
+  // Three significant digits.
+  const int64_t p50 = h.Percentile(50);
+  EXPECT_LE(500000000, p50);
+  EXPECT_GE(500000000 * 1.001, p50);
+  const int64_t p99 = h.Percentile(99);
+  EXPECT_LE(990000000, p99);
+  EXPECT_GE(990000000 * 1.001, p99);
+}
+
+TEST(HistogramTest, LowPrecision) {
+  Histogram coarse(3600000000000, 5);
+  Histogram fine(3600000000000);
+  EXPECT_GT(fine.GetMemorySize(), 16 * coarse.GetMemorySize());
+
+  for (int64_t i = 1; i <= 1000000; i++)
+    EXPECT_TRUE(coarse.Record(i * 1000));
+  EXPECT_EQ(1000, coarse.Min());
+  EXPECT_EQ(1000000000, coarse.Max());
+
+  // Within 1/32 of the exact value.
+  const int64_t p50 = coarse.Percentile(50);
+  EXPECT_LE(500000000, p50);
+  EXPECT_GE(500000000 + 500000000 / 32, p50);
+}
+
+TEST(HistogramTest, Percentiles) {
+  Histogram h(3600000000000);
+  for (int64_t i = 1; i <= 100; i++)
+    h.Record(i);
+
+  std::vector<std::pair<double, int64_t>> seen;
+  h.Percentiles([&](double percentile, int64_t value) {
+    seen.emplace_back(percentile, value);
+  });
+
+  ASSERT_LE(4u, seen.size());
+  EXPECT_EQ(0, seen[0].first);
+  EXPECT_EQ(1, seen[0].second);
+  EXPECT_EQ(50, seen[1].first);
+  EXPECT_EQ(50, seen[1].second);
+  EXPECT_EQ(75, seen[2].first);
+  EXPECT_EQ(75, seen[2].second);
+  EXPECT_EQ(100, seen.back().first);
+  EXPECT_EQ(100, seen.back().second);
+  for (size_t i = 1; i < seen.size(); i++) {
+    EXPECT_LT(seen[i - 1].first, seen[i].first);
+    EXPECT_LE(seen[i - 1].second, seen[i].second);
+  }
+}
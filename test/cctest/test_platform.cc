@@ -1,6 +1,7 @@
 #include "node_internals.h"
 #include "libplatform/libplatform.h"
 
+#include <atomic>
 #include <string>
 #include "gtest/gtest.h"
 #include "node_test_fixture.h"
@@ -35,6 +36,35 @@ class RepostingTask : public v8::Task {
   node::NodePlatform* platform_;
 };
 
+// This task increments the given counter.
+class CountingTask : public v8::Task {
+ public:
+  explicit CountingTask(std::atomic<int>* run_count)
+      : run_count_(run_count) {}
+
+  // v8::Task implementation
+  void Run() final {
+    ++*run_count_;
+  }
+
+ private:
+  std::atomic<int>* run_count_;
+};
+
+// This idle task records the deadline it was given.
+class DeadlineTask : public v8::IdleTask {
+ public:
+  explicit DeadlineTask(double* deadline) : deadline_(deadline) {}
+
+  // v8::IdleTask implementation
+  void Run(double deadline_in_seconds) final {
+    *deadline_ = deadline_in_seconds;
+  }
+
+ private:
+  double* deadline_;
+};
+
 class PlatformTest : public EnvironmentTestFixture {};
 
 TEST_F(PlatformTest, SkipNewTasksInFlushForegroundTasks) {
@@ -53,3 +83,42 @@ TEST_F(PlatformTest, SkipNewTasksInFlushForegroundTasks) {
   EXPECT_EQ(3, run_count);
   EXPECT_FALSE(platform->FlushForegroundTasks(isolate_));
 }
+
+TEST_F(PlatformTest, DrainTasksRunsAllWorkerTasks) {
+  v8::Isolate::Scope isolate_scope(isolate_);
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  std::atomic<int> run_count {0};
+  for (int i = 0; i < 1000; i++) {
+    platform->CallOnWorkerThread(
+        std::unique_ptr<v8::Task>(new CountingTask(&run_count)));
+  }
+  platform->DrainTasks(isolate_);
+  EXPECT_EQ(1000, run_count);
+}
+
+TEST_F(PlatformTest, IdleTasksRunWhileTheLoopWaits) {
+  v8::Isolate::Scope isolate_scope(isolate_);
+  const v8::HandleScope handle_scope(isolate_);
+  const Argv argv;
+  Env env {handle_scope, argv};
+  ASSERT_TRUE(platform->IdleTasksEnabled(isolate_));
+
+  double deadline = 0;
+  platform->GetForegroundTaskRunner(isolate_)->PostIdleTask(
+      std::unique_ptr<v8::IdleTask>(new DeadlineTask(&deadline)));
+  EXPECT_EQ(0, deadline);
+
+  // Give the loop something to wait for.
+  uv_timer_t timer;
+  uv_timer_init(&current_loop, &timer);
+  uv_timer_start(&timer, [](uv_timer_t*) {}, 20, 0);
+  const double start = platform->MonotonicallyIncreasingTime();
+  uv_run(&current_loop, UV_RUN_ONCE);
+  EXPECT_LT(start, deadline);
+  EXPECT_GE(start + 0.05, deadline);
+
+  uv_close(reinterpret_cast<uv_handle_t*>(&timer), nullptr);
+  uv_run(&current_loop, UV_RUN_NOWAIT);
+}
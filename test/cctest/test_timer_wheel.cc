@@ -0,0 +1,165 @@
+#include "timer_wheel.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using node::TimerWheel;
+
+static std::vector<uint32_t> PopAll(TimerWheel* wheel) {
+  std::vector<uint32_t> ids;
+  for (uint32_t id; (id = wheel->PopExpired()) != TimerWheel::kNone;)
+    ids.push_back(id);
+  return ids;
+}
+
+TEST(TimerWheelTest, Empty) {
+  TimerWheel wheel(1000);
+  EXPECT_EQ(0u, wheel.size());
+  EXPECT_EQ(UINT64_MAX, wheel.NextEventTime());
+  wheel.Advance(1000000);
+  EXPECT_FALSE(wheel.HasExpired());
+  EXPECT_EQ(TimerWheel::kNone, wheel.PopExpired());
+}
+
+TEST(TimerWheelTest, ExpiresOnTime) {
+  const uint64_t durations[] = { 1, 255, 256, 257, 65535, 65536, 100000 };
+  for (uint64_t duration : durations) {
+    TimerWheel wheel(1000);
+    wheel.Start(0, 1000, duration);
+    EXPECT_TRUE(wheel.IsActive(0));
+    EXPECT_LE(wheel.NextEventTime(), 1000 + duration);
+    wheel.Advance(1000 + duration - 1);
+    EXPECT_FALSE(wheel.HasExpired()) << duration;
+    wheel.Advance(1000 + duration);
+    EXPECT_EQ(std::vector<uint32_t>({ 0 }), PopAll(&wheel)) << duration;
+    EXPECT_FALSE(wheel.IsActive(0));
+    EXPECT_EQ(0u, wheel.size());
+  }
+}
+
+TEST(TimerWheelTest, ExpiresInOrder) {
+  TimerWheel wheel(0);
+  wheel.Start(0, 0, 300);
+  wheel.Start(1, 0, 10);
+  wheel.Start(2, 0, 70000);
+  wheel.Start(3, 0, 20);
+  EXPECT_EQ(4u, wheel.size());
+  wheel.Advance(100000);
+  EXPECT_EQ(std::vector<uint32_t>({ 1, 3, 0, 2 }), PopAll(&wheel));
+}
+
+TEST(TimerWheelTest, Refresh) {
+  TimerWheel wheel(0);
+  wheel.Start(7, 0, 100);
+  for (uint64_t now = 50; now <= 5000; now += 50) {
+    wheel.Refresh(7, now);
+    wheel.Advance(now);
+    EXPECT_FALSE(wheel.HasExpired());
+  }
+  wheel.Advance(5099);
+  EXPECT_FALSE(wheel.HasExpired());
+  wheel.Advance(5100);
+  EXPECT_EQ(std::vector<uint32_t>({ 7 }), PopAll(&wheel));
+}
+
+TEST(TimerWheelTest, RefreshExpired) {
+  TimerWheel wheel(0);
+  wheel.Start(0, 0, 10);
+  wheel.Start(1, 0, 10);
+  wheel.Advance(10);
+  // Refreshing a timer that expired but was not popped yet re-arms it.
+  wheel.Refresh(1, 10);
+  EXPECT_EQ(std::vector<uint32_t>({ 0 }), PopAll(&wheel));
+  EXPECT_TRUE(wheel.IsActive(1));
+  wheel.Advance(20);
+  EXPECT_EQ(std::vector<uint32_t>({ 1 }), PopAll(&wheel));
+}
+
+TEST(TimerWheelTest, Stop) {
+  TimerWheel wheel(0);
+  wheel.Start(0, 0, 10);
+  wheel.Start(1, 0, 1000);
+  wheel.Start(2, 0, 10);
+  wheel.Stop(1);
+  wheel.Stop(1);
+  EXPECT_FALSE(wheel.IsActive(1));
+  EXPECT_EQ(2u, wheel.size());
+  wheel.Advance(10);
+  wheel.Stop(0);
+  EXPECT_EQ(std::vector<uint32_t>({ 2 }), PopAll(&wheel));
+  EXPECT_EQ(UINT64_MAX, wheel.NextEventTime());
+
+  // Ids can be reused once stopped or popped.
+  wheel.Start(0, 10, 5);
+  wheel.Start(1, 10, 5);
+  wheel.Advance(15);
+  EXPECT_EQ(std::vector<uint32_t>({ 0, 1 }), PopAll(&wheel));
+}
+
+TEST(TimerWheelTest, SkipsIdleTime) {
+  TimerWheel wheel(0);
+  wheel.Start(0, 0, 2000000000);
+  // The next event is a cascade, not every millisecond in between.
+  const uint64_t next = wheel.NextEventTime();
+  EXPECT_GT(next, uint64_t{1} << 24);
+  EXPECT_LE(next, uint64_t{2000000000});
+  wheel.Advance(1999999999);
+  EXPECT_FALSE(wheel.HasExpired());
+  wheel.Advance(2000000000);
+  EXPECT_EQ(std::vector<uint32_t>({ 0 }), PopAll(&wheel));
+}
+
+TEST(TimerWheelTest, MatchesNaiveModel) {
+  std::mt19937 rng(42);
+  auto random = [&]() { return static_cast<uint64_t>(rng()); };
+  TimerWheel wheel(12345);
+  std::map<uint32_t, uint64_t> expiries;
+  std::map<uint32_t, uint64_t> durations;
+  uint64_t now = 12345;
+
+  for (int round = 0; round < 20000; round++) {
+    const uint32_t id = random() % 512;
+    switch (random() % 4) {
+      case 0: {
+        if (expiries.count(id) != 0)
+          break;
+        static const uint64_t kScales[] = { 300, 70000, 20000000 };
+        const uint64_t duration = 1 + random() % kScales[random() % 3];
+        wheel.Start(id, now, duration);
+        expiries[id] = now + duration;
+        durations[id] = duration;
+        break;
+      }
+      case 1:
+        if (expiries.count(id) == 0)
+          break;
+        wheel.Refresh(id, now);
+        expiries[id] = now + durations[id];
+        break;
+      case 2:
+        wheel.Stop(id);
+        expiries.erase(id);
+        break;
+      case 3: {
+        now += random() % ((random() % 10 == 0) ? 5000000 : 500);
+        wheel.Advance(now);
+        std::vector<uint32_t> expected;
+        for (const auto& it : expiries) {
+          if (it.second <= now)
+            expected.push_back(it.first);
+        }
+        std::vector<uint32_t> actual = PopAll(&wheel);
+        std::sort(actual.begin(), actual.end());
+        ASSERT_EQ(expected, actual) << "round " << round;
+        for (uint32_t expired : expected)
+          expiries.erase(expired);
+        EXPECT_EQ(expiries.size(), wheel.size());
+        break;
+      }
+    }
+  }
+}
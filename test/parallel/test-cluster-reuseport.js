@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+if (common.isWindows || common.isOSX || common.isAIX || common.isSunOS ||
+    common.isOpenBSD)
+  common.skip('SO_REUSEPORT load balancing is not supported');
+
+// With the SCHED_REUSEPORT policy every worker listens on a socket of its
+// own. Workers that listen on port 0 still end up on the same port and the
+// connections to it are accepted by the workers, not the master.
+
+const assert = require('assert');
+const cluster = require('cluster');
+const dgram = require('dgram');
+const net = require('net');
+const Countdown = require('../common/countdown');
+
+cluster.schedulingPolicy = cluster.SCHED_REUSEPORT;
+const WORKERS = 2;
+const CONNECTIONS = 16;
+
+if (cluster.isMaster) {
+  const workers = [];
+  const ports = { tcp: null, udp: null };
+  let accepted = 0;
+
+  function connect() {
+    const countdown = new Countdown(CONNECTIONS, () => {
+      assert.strictEqual(accepted, CONNECTIONS);
+      for (const worker of workers)
+        worker.disconnect();
+    });
+    for (let i = 0; i < CONNECTIONS; i++) {
+      net.connect(ports.tcp, common.localhostIPv4)
+        .on('data', common.mustCall((data) => {
+          assert.ok(workers.some((w) => `${w.process.pid}` === `${data}`));
+          accepted++;
+        }))
+        .on('end', common.mustCall(() => countdown.dec()));
+    }
+  }
+
+  const listening = new Countdown(WORKERS, connect);
+  for (let i = 0; i < WORKERS; i++) {
+    const worker = cluster.fork();
+    worker.on('message', common.mustCall((message) => {
+      for (const type of ['tcp', 'udp']) {
+        if (ports[type] === null)
+          ports[type] = message[type];
+        assert.strictEqual(message[type], ports[type]);
+      }
+      listening.dec();
+    }));
+    worker.on('exit', common.mustCall((code) => {
+      assert.strictEqual(code, 0);
+    }));
+    workers.push(worker);
+  }
+} else {
+  const server = net.createServer((socket) => {
+    socket.end(`${process.pid}`);
+  });
+  const socket = dgram.createSocket('udp4');
+
+  server.listen(0, common.localhostIPv4, common.mustCall(() => {
+    socket.bind(0, common.localhostIPv4, common.mustCall(() => {
+      process.send({
+        tcp: server.address().port,
+        udp: socket.address().port
+      });
+    }));
+  }));
+}
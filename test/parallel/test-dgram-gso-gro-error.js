@@ -0,0 +1,27 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+const { kStateSymbol } = require('internal/dgram');
+const { internalBinding } = require('internal/test/binding');
+const { UV_ENOTSUP } = internalBinding('uv');
+
+// Offloads that the kernel doesn't support are reported through 'error'
+// once the socket is bound, not thrown from inside bind().
+
+for (const [options, syscall] of [
+  [{ gsoSegmentSize: 100 }, 'setGSO'],
+  [{ gro: true }, 'setGRO']
+]) {
+  const socket = dgram.createSocket({ type: 'udp4', ...options });
+  socket[kStateSymbol].handle[syscall] = () => UV_ENOTSUP;
+
+  socket.on('listening', common.mustNotCall());
+  socket.on('error', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOTSUP');
+    assert.strictEqual(err.syscall, syscall);
+    socket.close();
+  }));
+  socket.bind(0, common.localhostIPv4);
+}
@@ -0,0 +1,60 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+if (!common.isLinux)
+  common.skip('UDP segmentation offload is Linux only');
+
+const assert = require('assert');
+const dgram = require('dgram');
+const { internalBinding } = require('internal/test/binding');
+const { UDP } = internalBinding('udp_wrap');
+
+// Kernels older than 4.18 (GSO) and 5.0 (GRO) don't have the socket options.
+{
+  const handle = new UDP();
+  assert.strictEqual(handle.bind(common.localhostIPv4, 0, 0), 0);
+  const supported = handle.setGSO(100) === 0 && handle.setGRO(1) === 0;
+  handle.close();
+  if (!supported)
+    common.skip('UDP_SEGMENT or UDP_GRO is not supported');
+}
+
+const segmentSize = 100;
+const segments = 10;
+
+const server = dgram.createSocket({ type: 'udp4', gro: true });
+const client = dgram.createSocket({
+  type: 'udp4',
+  gsoSegmentSize: segmentSize
+});
+
+let received = 0;
+server.on('message', common.mustCallAtLeast((msg, rinfo) => {
+  // The segments arrive one by one or coalesced, as the kernel sees fit.
+  assert.strictEqual(rinfo.size, msg.length);
+  assert.strictEqual(rinfo.segmentSize, segmentSize);
+  assert.strictEqual(msg.length % segmentSize, 0);
+  received += msg.length;
+  if (received < segmentSize * segments)
+    return;
+  assert.strictEqual(received, segmentSize * segments);
+  server.close();
+  client.close();
+}));
+
+server.bind(0, common.localhostIPv4, common.mustCall(() => {
+  const payload = Buffer.alloc(segmentSize * segments, 'x');
+  client.send(payload, server.address().port, common.localhostIPv4,
+              common.mustCall((err, sent) => {
+                assert.ifError(err);
+                assert.strictEqual(sent, payload.length);
+              }));
+}));
+
+common.expectsError(() => {
+  dgram.createSocket({ type: 'udp4', gsoSegmentSize: 65536 });
+}, {
+  code: 'ERR_OUT_OF_RANGE',
+  type: RangeError
+});
@@ -0,0 +1,71 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const dgram = require('dgram');
+
+const count = 50;
+
+const server = dgram.createSocket({ type: 'udp4', recvBatchSize: 8 });
+const client = dgram.createSocket('udp4');
+
+const received = [];
+server.on('message', common.mustCall((msg, rinfo) => {
+  assert.strictEqual(rinfo.size, msg.length);
+  assert.strictEqual(rinfo.port, client.address().port);
+  received.push(msg.toString());
+  if (received.length < count)
+    return;
+  assert.deepStrictEqual(received.sort(),
+                         messages.map((m) => m.msg.toString()).sort());
+  server.close();
+  client.close();
+}, count));
+
+const messages = [];
+for (let i = 0; i < count; i++) {
+  messages.push({
+    msg: i % 2 ? `message ${i}` : Buffer.from(`message ${i}`),
+    port: 0,
+    address: common.localhostIPv4
+  });
+}
+
+server.bind(0, common.mustCall(() => {
+  for (const message of messages)
+    message.port = server.address().port;
+
+  const bytes = messages.reduce((sum, m) => sum + m.msg.length, 0);
+  client.sendBatch(messages, common.mustCall((err, sent) => {
+    assert.ifError(err);
+    assert.strictEqual(sent, bytes);
+  }));
+}));
+
+// An empty batch completes right away.
+client.sendBatch([], common.mustCall((err, sent) => {
+  assert.ifError(err);
+  assert.strictEqual(sent, 0);
+}));
+
+common.expectsError(() => client.sendBatch('foo'), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+common.expectsError(() => client.sendBatch([{ msg: 1, port: 1 }]), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+common.expectsError(() => client.sendBatch([{ msg: 'foo', port: 0 }]), {
+  code: 'ERR_SOCKET_BAD_PORT',
+  type: RangeError
+});
+
+common.expectsError(() => {
+  dgram.createSocket({ type: 'udp4', recvBatchSize: 0 });
+}, {
+  code: 'ERR_OUT_OF_RANGE',
+  type: RangeError
+});
@@ -0,0 +1,56 @@
+'use strict';
+const common = require('../common');
+
+// Exercise the fs operations that libuv can route through io_uring when
+// UV_USE_IO_URING=1. On platforms without io_uring the threadpool is used and
+// the results must be the same.
+
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+const { spawnSync } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  const tmpdir = require('../common/tmpdir');
+  tmpdir.refresh();
+  const filename = path.join(tmpdir.path, 'io-uring.txt');
+  const data = Buffer.from('x'.repeat(65536 + 17));
+
+  fs.open(filename, 'w+', common.mustCall((err, fd) => {
+    assert.ifError(err);
+    fs.write(fd, data, 0, data.length, null, common.mustCall((err, written) => {
+      assert.ifError(err);
+      assert.strictEqual(written, data.length);
+      fs.fsync(fd, common.mustCall((err) => {
+        assert.ifError(err);
+        fs.fstat(fd, common.mustCall((err, stats) => {
+          assert.ifError(err);
+          assert.strictEqual(stats.size, data.length);
+          assert.deepStrictEqual(stats, fs.fstatSync(fd));
+          const buf = Buffer.alloc(data.length);
+          fs.read(fd, buf, 0, buf.length, 0, common.mustCall((err, n) => {
+            assert.ifError(err);
+            assert.strictEqual(n, data.length);
+            assert.deepStrictEqual(buf, data);
+            fs.closeSync(fd);
+          }));
+        }));
+      }));
+    }));
+  }));
+
+  fs.stat(filename + '.missing', common.mustCall((err) => {
+    assert.strictEqual(err.code, 'ENOENT');
+  }));
+
+  fs.promises.readFile(__filename).then(common.mustCall((contents) => {
+    assert.deepStrictEqual(contents, fs.readFileSync(__filename));
+  }));
+  return;
+}
+
+const child = spawnSync(process.execPath, [__filename, 'child'], {
+  env: Object.assign({}, process.env, { UV_USE_IO_URING: '1' })
+});
+assert.strictEqual(child.stderr.toString(), '');
+assert.strictEqual(child.status, 0);
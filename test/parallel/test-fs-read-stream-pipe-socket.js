@@ -0,0 +1,153 @@
+'use strict';
+const common = require('../common');
+
+// Piping a fs.ReadStream into a socket is done natively; check that the
+// data, the byte ranges and the events are the same as for a JS pipe.
+
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+tmpdir.refresh();
+
+const file = path.join(tmpdir.path, 'read-stream-pipe-socket.bin');
+const data = Buffer.allocUnsafe(3 * 1024 * 1024 + 123);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+fs.writeFileSync(file, data);
+
+function pipeTo(listenArgs, streamOptions, expected) {
+  const server = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.ok(Buffer.concat(chunks).equals(expected));
+      socket.end();
+      server.close();
+    }));
+  }));
+
+  server.listen(...listenArgs, common.mustCall(() => {
+    const address = server.address();
+    const socket = net.connect(typeof address === 'string' ?
+      address : address.port);
+    socket.on('connect', common.mustCall(() => {
+      const stream = fs.createReadStream(file, streamOptions);
+      socket.on('pipe', common.mustCall((src) => {
+        assert.strictEqual(src, stream);
+      }));
+      socket.on('unpipe', common.mustCall((src) => {
+        assert.strictEqual(src, stream);
+      }));
+      stream.on('end', common.mustCall(() => {
+        assert.strictEqual(stream.bytesRead, expected.length);
+      }));
+      stream.on('close', common.mustCall());
+      assert.strictEqual(stream.pipe(socket), socket);
+    }));
+    socket.resume();
+  }));
+}
+
+pipeTo([0], undefined, data);
+pipeTo([0], { start: 1000, end: 2 * 1024 * 1024 },
+       data.slice(1000, 2 * 1024 * 1024 + 1));
+pipeTo([0], { start: 0, end: 0 }, data.slice(0, 1));
+pipeTo([common.PIPE], undefined, data);
+
+// The file stream still reports read errors.
+{
+  const server = net.createServer(common.mustCall((socket) => {
+    socket.resume();
+    socket.on('end', common.mustCall(() => {
+      socket.end();
+      server.close();
+    }));
+  }));
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port);
+    socket.on('connect', common.mustCall(() => {
+      const stream = fs.createReadStream(tmpdir.path);
+      stream.on('error', common.mustCall((err) => {
+        assert.strictEqual(err.code, 'EISDIR');
+        socket.end();
+      }));
+      stream.pipe(socket);
+    }));
+  }));
+}
+
+// Writes to the socket go between chunks of the file, and unpipe() and
+// pause() stop the transfer, after which the rest is read from JS.
+{
+  const marker = Buffer.from('--marker--');
+  const server = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      const received = Buffer.concat(chunks);
+      const at = received.indexOf(marker);
+      assert.ok(at >= 0);
+      assert.ok(Buffer.concat([
+        received.slice(0, at),
+        received.slice(at + marker.length)
+      ]).equals(data));
+      server.close();
+    }));
+  }));
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port);
+    socket.on('connect', common.mustCall(() => {
+      const stream = fs.createReadStream(file);
+      stream.once('open', common.mustCall(() => {
+        setImmediate(common.mustCall(() => {
+          stream.pause();
+          socket.write(marker);
+          stream.unpipe(socket);
+          assert.strictEqual(stream.isPaused(), true);
+          const chunks = [];
+          stream.on('data', (chunk) => chunks.push(chunk));
+          stream.on('end', common.mustCall(() => {
+            assert.strictEqual(stream.bytesRead, data.length);
+            socket.end(Buffer.concat(chunks));
+          }));
+          stream.resume();
+        }));
+      }));
+      socket.on('unpipe', common.mustCall());
+      stream.pipe(socket);
+    }));
+  }));
+}
+
+// Destroying the file stream, also after pause(), while a sendfile() is in
+// flight takes the pipe down once it is done and still closes the stream.
+[false, true].forEach((pause) => {
+  const server = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      const received = Buffer.concat(chunks);
+      assert.ok(received.equals(data.slice(0, received.length)));
+      server.close();
+    }));
+  }));
+  server.listen(0, common.mustCall(() => {
+    const socket = net.connect(server.address().port);
+    socket.on('connect', common.mustCall(() => {
+      const stream = fs.createReadStream(file);
+      stream.once('open', common.mustCall(() => {
+        setImmediate(common.mustCall(() => {
+          if (pause)
+            stream.pause();
+          stream.destroy();
+        }));
+      }));
+      stream.on('close', common.mustCall());
+      socket.on('unpipe', common.mustCall(() => socket.end()));
+      stream.pipe(socket);
+    }));
+  }));
+});
@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+
+// Header values are handed to IncomingMessage as a single Buffer and only
+// turned into strings when `headers` or `rawHeaders` is read. Both must look
+// exactly as they did when they were built eagerly.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const server = http.createServer(common.mustCall((req, res) => {
+  if (req.url === '/raw') {
+    assert.deepStrictEqual(req.rawHeaders, [
+      'Host', 'example.com',
+      'content-type', 'text/plain',
+      'X-Custom', 'a',
+      'x-custom', 'b',
+      'Cookie', 'a=1',
+      'cookie', 'b=2',
+      'Set-Cookie', 'c=3',
+      'Accept', '*/*'
+    ]);
+    assert.deepStrictEqual(req.headers, {
+      'host': 'example.com',
+      'content-type': 'text/plain',
+      'x-custom': 'a, b',
+      'cookie': 'a=1; b=2',
+      'set-cookie': ['c=3'],
+      'accept': '*/*'
+    });
+  } else {
+    req.headers = { replaced: 'yes' };
+    assert.deepStrictEqual(req.headers, { replaced: 'yes' });
+    assert.deepStrictEqual(req.rawHeaders, ['HOST', 'example.com']);
+  }
+  res.end();
+}, 2));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    client.end(
+      'GET /raw HTTP/1.1\r\n' +
+      'Host: example.com\r\n' +
+      'content-type: text/plain\r\n' +
+      'X-Custom: a\r\n' +
+      'x-custom: b\r\n' +
+      'Cookie: a=1\r\n' +
+      'cookie: b=2\r\n' +
+      'Set-Cookie: c=3\r\n' +
+      'Accept: */*\r\n' +
+      '\r\n' +
+      'GET /replace HTTP/1.1\r\n' +
+      'HOST: example.com\r\n' +
+      '\r\n');
+  }));
+  client.resume();
+  client.on('end', common.mustCall(() => server.close()));
+}));
@@ -0,0 +1,87 @@
+'use strict';
+const common = require('../common');
+
+// The response header is serialized into a single Buffer in one pass that
+// also validates the header fields. Invalid fields must still throw the same
+// errors, and `_header` must still read as the serialized string.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const server = http.createServer(common.mustCall((req, res) => {
+  common.expectsError(() => {
+    res.writeHead(200, { 'X-Bad Name': 'a' });
+  }, {
+    code: 'ERR_INVALID_HTTP_TOKEN',
+    type: TypeError,
+    message: 'Header name must be a valid HTTP token ["X-Bad Name"]'
+  });
+  common.expectsError(() => {
+    res.writeHead(200, [['X-Good', 'a'], ['', 'b']]);
+  }, {
+    code: 'ERR_INVALID_HTTP_TOKEN',
+    type: TypeError
+  });
+  common.expectsError(() => {
+    res.writeHead(200, { 'X-Good': 'a', 'X-Bad': 'b\r\nc' });
+  }, {
+    code: 'ERR_INVALID_CHAR',
+    type: TypeError,
+    message: 'Invalid character in header content ["X-Bad"]'
+  });
+  common.expectsError(() => {
+    res.writeHead(200, { 'X-Bad': 'Ā' });
+  }, {
+    code: 'ERR_INVALID_CHAR',
+    type: TypeError
+  });
+  // A rejected header must not leave the response chunked, or the body below
+  // would be sent in chunks despite its Content-Length.
+  common.expectsError(() => {
+    res.writeHead(200, { 'Transfer-Encoding': 'chunked', 'X-Bad': '\n' });
+  }, {
+    code: 'ERR_INVALID_CHAR',
+    type: TypeError
+  });
+  assert.strictEqual(res.headersSent, false);
+
+  res.sendDate = false;
+  res.setHeader('X-Number', 42);
+  res.writeHead(200, {
+    'X-Latin1': 'é',
+    'X-List': ['a', 'b'],
+    'Content-Length': 2
+  });
+  assert.strictEqual(res.headersSent, true);
+
+  const expected = 'HTTP/1.1 200 OK\r\n' +
+                   'X-Number: 42\r\n' +
+                   'X-Latin1: é\r\n' +
+                   'X-List: a\r\n' +
+                   'X-List: b\r\n' +
+                   'Content-Length: 2\r\n' +
+                   'Connection: close\r\n' +
+                   '\r\n';
+  assert.strictEqual(res._header, expected);
+  // The decoded string is cached.
+  assert.strictEqual(res._header, expected);
+
+  res.end('ok');
+}));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    client.end('GET / HTTP/1.1\r\nConnection: close\r\n\r\n');
+  }));
+
+  const chunks = [];
+  client.on('data', (chunk) => chunks.push(chunk));
+  client.on('end', common.mustCall(() => {
+    const response = Buffer.concat(chunks);
+    assert.ok(response.includes(Buffer.from('X-Latin1: é\r\n', 'latin1')));
+    assert.ok(response.includes('X-Number: 42\r\n'));
+    assert.ok(response.toString('latin1').endsWith('\r\n\r\nok'));
+    server.close();
+  }));
+}));
@@ -0,0 +1,57 @@
+'use strict';
+const common = require('../common');
+
+// With `batchPipelinedRequests`, body-less requests that arrive in one read
+// are dispatched together. Requests with a body still go through the regular
+// callbacks, and the order of all requests is preserved.
+
+const assert = require('assert');
+const http = require('http');
+const net = require('net');
+
+const expected = [
+  ['GET', '/1', ''],
+  ['GET', '/2', ''],
+  ['POST', '/3', 'hello'],
+  ['DELETE', '/4', ''],
+  ['GET', '/5', '']
+];
+const seen = [];
+
+const server = http.createServer({
+  batchPipelinedRequests: true
+}, common.mustCall((req, res) => {
+  assert.strictEqual(req.httpVersion, '1.1');
+  assert.strictEqual(req.headers.host, 'example.com');
+  assert.strictEqual(req.headers['x-index'], req.url.slice(1));
+  assert.deepStrictEqual(req.rawHeaders.slice(0, 4),
+                         ['Host', 'example.com', 'X-Index', req.url.slice(1)]);
+
+  const entry = [req.method, req.url, ''];
+  seen.push(entry);
+  req.setEncoding('utf8');
+  req.on('data', (chunk) => entry[2] += chunk);
+  req.on('end', common.mustCall(() => res.end(req.url)));
+}, expected.length));
+
+server.listen(0, common.mustCall(() => {
+  const client = net.connect(server.address().port, common.mustCall(() => {
+    client.end(expected.map(([method, url, body], i) => {
+      return `${method} ${url} HTTP/1.1\r\n` +
+             'Host: example.com\r\n' +
+             `X-Index: ${i + 1}\r\n` +
+             (body ? `Content-Length: ${body.length}\r\n` : '') +
+             `\r\n${body}`;
+    }).join(''));
+  }));
+
+  let response = '';
+  client.setEncoding('utf8');
+  client.on('data', (chunk) => response += chunk);
+  client.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(seen, expected);
+    assert.strictEqual(response.match(/HTTP\/1\.1 200 OK/g).length,
+                       expected.length);
+    server.close();
+  }));
+}));
@@ -25,3 +25,15 @@ const ws = new Writable({
 res.assignSocket(ws);
 
 res.end('hello world');
+
+// The request does not have to be an IncomingMessage for HTTP/1.0 either.
+{
+  const res = new ServerResponse({
+    method: 'GET',
+    httpVersionMajor: 1,
+    httpVersionMinor: 0,
+    headers: { te: 'chunked' }
+  });
+  assert.strictEqual(res.useChunkedEncodingByDefault, true);
+  assert.strictEqual(res.shouldKeepAlive, false);
+}
@@ -0,0 +1,45 @@
+'use strict';
+const common = require('../common');
+
+// TCP Fast Open and deferred accepting are hints: they are applied where the
+// platform supports them and ignored elsewhere. Either way a client that
+// asks for Fast Open still talks to a server that offers it.
+
+const assert = require('assert');
+const net = require('net');
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.on('data', common.mustCall((data) => {
+    assert.strictEqual(`${data}`, 'ping');
+    socket.end('pong');
+  }));
+}, 2));
+
+server.listen({ port: 0, fastOpen: 16, deferAccept: 1 }, common.mustCall(() => {
+  const { port } = server.address();
+  // The second connection may use the Fast Open cookie of the first one.
+  connect(port, common.mustCall(() => {
+    connect(port, common.mustCall(() => server.close()));
+  }));
+}));
+
+function connect(port, cb) {
+  const socket = net.connect({ port, fastOpen: true });
+  let response = '';
+  socket.setEncoding('utf8');
+  socket.on('data', (chunk) => response += chunk);
+  socket.on('end', common.mustCall(() => {
+    assert.strictEqual(response, 'pong');
+    cb();
+  }));
+  socket.write('ping');
+}
+
+for (const fastOpen of [-1, 1.5, 2 ** 32]) {
+  common.expectsError(() => net.createServer().listen({ port: 0, fastOpen }), {
+    code: 'ERR_OUT_OF_RANGE'
+  });
+}
+common.expectsError(
+  () => net.createServer().listen({ port: 0, deferAccept: '1' }),
+  { code: 'ERR_INVALID_ARG_TYPE' });
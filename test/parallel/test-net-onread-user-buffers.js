@@ -0,0 +1,69 @@
+'use strict';
+const common = require('../common');
+
+// Data read with the `onread` option lands in the user-supplied buffers,
+// which are used as a ring, and is never emitted as 'data' events.
+
+const assert = require('assert');
+const net = require('net');
+
+const message = Buffer.alloc(1000);
+for (let i = 0; i < message.length; i++)
+  message[i] = i & 0xff;
+
+[
+  null,
+  [],
+  [new Uint8Array(0)],
+  ['abc']
+].forEach((buffers) => {
+  common.expectsError(() => {
+    new net.Socket({ onread: { buffers, callback: common.mustNotCall() } });
+  }, {
+    code: /^ERR_INVALID_ARG_(TYPE|VALUE)$/,
+    type: TypeError
+  });
+});
+
+common.expectsError(() => {
+  new net.Socket({ onread: { buffers: [Buffer.alloc(1)], callback: 1 } });
+}, {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+const server = net.createServer(common.mustCall((socket) => {
+  socket.end(message);
+}));
+
+server.listen(0, common.mustCall(() => {
+  const buffers = [Buffer.alloc(64), new ArrayBuffer(64)];
+  const views = [buffers[0], new Uint8Array(buffers[1])];
+  const chunks = [];
+  let expectedIndex = 0;
+  let expectedOffset = 0;
+
+  const client = net.connect({
+    port: server.address().port,
+    onread: {
+      buffers,
+      callback: common.mustCallAtLeast((index, offset, length) => {
+        assert.strictEqual(index, expectedIndex);
+        assert.strictEqual(offset, expectedOffset);
+        assert.ok(length > 0 && offset + length <= 64);
+        chunks.push(Buffer.from(views[index].slice(offset, offset + length)));
+
+        expectedOffset += length;
+        if (expectedOffset === 64) {
+          expectedOffset = 0;
+          expectedIndex = (expectedIndex + 1) % buffers.length;
+        }
+      })
+    }
+  });
+  client.on('data', common.mustNotCall());
+  client.on('end', common.mustCall(() => {
+    assert.deepStrictEqual(Buffer.concat(chunks), message);
+    server.close();
+  }));
+}));
@@ -0,0 +1,80 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+// Sockets read into shared slabs. Check that the reads of many sockets do not
+// overwrite each other, that no chunk exposes memory beyond its own bytes,
+// and that the pool counts them.
+
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const {
+  getReadBufferPoolStats,
+  kReadBufferPoolFields
+} = internalBinding('stream_wrap');
+
+function getStats() {
+  const fields = new Float64Array(kReadBufferPoolFields);
+  getReadBufferPoolStats(fields);
+  return {
+    allocations: fields[0],
+    fallbacks: fields[1],
+    slabs: fields[2],
+    bytes: fields[3],
+    slabFrees: fields[4]
+  };
+}
+
+const kSockets = 20;
+const kMessages = 50;
+const before = getStats();
+const received = [];
+let ended = 0;
+
+const server = net.createServer(common.mustCall((socket) => {
+  // Keep every chunk, they must still hold what was read into them once
+  // later reads have gone into the same slabs.
+  const chunks = [];
+  socket.on('data', (chunk) => {
+    assert.strictEqual(chunk.byteOffset, 0);
+    assert.strictEqual(chunk.buffer.byteLength, chunk.length);
+    chunks.push(chunk);
+  });
+  socket.on('end', common.mustCall(() => {
+    received.push(Buffer.concat(chunks).toString());
+    socket.end();
+    if (++ended === kSockets)
+      server.close(common.mustCall(check));
+  }));
+}, kSockets));
+
+function check() {
+  const expected = [];
+  for (let i = 0; i < kSockets; i++) {
+    let data = '';
+    for (let j = 0; j < kMessages; j++)
+      data += `socket ${i} message ${j}\n`;
+    expected.push(data);
+  }
+  assert.deepStrictEqual(received.sort(), expected.sort());
+
+  const after = getStats();
+  const bytes = expected.reduce((total, data) => total + data.length, 0);
+  assert.ok(after.allocations > before.allocations);
+  assert.ok(after.slabs > before.slabs);
+  assert.ok(after.bytes - before.bytes >= bytes);
+}
+
+server.listen(0, common.mustCall(() => {
+  for (let i = 0; i < kSockets; i++) {
+    const socket = net.connect(server.address().port);
+    socket.resume();
+    let j = 0;
+    (function send() {
+      if (j === kMessages)
+        return socket.end();
+      socket.write(`socket ${i} message ${j++}\n`, () => setImmediate(send));
+    })();
+  }
+}));
@@ -0,0 +1,44 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { internalBinding } = require('internal/test/binding');
+const { UV_EBUSY, UV_ENOTSUP } = internalBinding('uv');
+
+// A server that only wakes up one of the processes sharing its socket
+// accepts connections like any other.
+const connections = 3;
+const server = net.createServer(common.mustCall((socket) => {
+  socket.end();
+}, connections));
+
+server.listen({ port: 0, exclusiveAccept: true }, common.mustCall(() => {
+  // The mode is fixed once the socket is listening.
+  const err = server._handle.setExclusiveAccept(false);
+  assert.strictEqual(err, common.isLinux ? UV_EBUSY : UV_ENOTSUP);
+
+  let remaining = connections;
+  for (let i = 0; i < connections; i++) {
+    net.connect(server.address().port)
+      .resume()
+      .on('end', common.mustCall(() => {
+        if (--remaining === 0)
+          server.close();
+      }));
+  }
+}));
+
+// Pipe servers support it too.
+{
+  const tmpdir = require('../common/tmpdir');
+  tmpdir.refresh();
+  const pipeServer = net.createServer(common.mustCall((socket) => {
+    socket.end();
+    pipeServer.close();
+  }));
+  pipeServer.listen({ path: common.PIPE, exclusiveAccept: true },
+                    common.mustCall(() => {
+                      net.connect(common.PIPE).resume();
+                    }));
+}
@@ -0,0 +1,64 @@
+'use strict';
+const common = require('../common');
+
+// A paused server leaves connections in the backlog. Once it resumes, the
+// accept budget limits how many of them are accepted per loop iteration.
+
+const assert = require('assert');
+const net = require('net');
+const Countdown = require('../common/countdown');
+
+const CONNECTIONS = 5;
+const BUDGET = 2;
+
+let perTick = 0;
+let maxPerTick = 0;
+let done = false;
+(function tick() {
+  perTick = 0;
+  if (!done)
+    setImmediate(tick);
+})();
+
+const clients = [];
+const accepted = new Countdown(CONNECTIONS, () => {
+  done = true;
+  assert.ok(maxPerTick <= BUDGET, `${maxPerTick} connections in one tick`);
+  server.close();
+  for (const client of clients)
+    client.destroy();
+});
+
+const server = net.createServer((socket) => {
+  perTick++;
+  maxPerTick = Math.max(maxPerTick, perTick);
+  socket.destroy();
+  accepted.dec();
+});
+
+assert.strictEqual(server.getAcceptBacklog(), undefined);
+assert.strictEqual(server.pauseAccepting(), server);
+
+server.listen({ port: 0, acceptBudget: BUDGET }, common.mustCall(() => {
+  const connected = new Countdown(CONNECTIONS, () => {
+    // Give the server a chance to accept, which it must not do.
+    setTimeout(common.mustCall(() => {
+      assert.strictEqual(accepted.remaining, CONNECTIONS);
+      const backlog = server.getAcceptBacklog();
+      if (backlog !== undefined)
+        assert.strictEqual(backlog, CONNECTIONS);
+      assert.strictEqual(server.resumeAccepting(), server);
+    }), common.platformTimeout(50));
+  });
+
+  for (let i = 0; i < CONNECTIONS; i++) {
+    const client = net.connect(server.address().port);
+    client.on('connect', common.mustCall(() => connected.dec()));
+    client.on('error', () => {});
+    clients.push(client);
+  }
+}));
+
+common.expectsError(() => net.createServer().listen({ acceptBudget: -1 }), {
+  code: 'ERR_OUT_OF_RANGE'
+});
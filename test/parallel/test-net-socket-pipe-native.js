@@ -0,0 +1,92 @@
+'use strict';
+const common = require('../common');
+
+// Socket-to-socket pipes bypass JS with `{ native: true }`. Check that a
+// proxy built from them delivers all data in both directions, counts the
+// bytes it moved and ends the destination once the source ends, also while
+// the receiving side is applying backpressure.
+
+const assert = require('assert');
+const net = require('net');
+
+const data = Buffer.allocUnsafe(4 * 1024 * 1024);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 253;
+
+const echo = net.createServer(common.mustCall((socket) => {
+  socket.pipe(socket, { native: true });
+}));
+
+const proxy = net.createServer(common.mustCall((client) => {
+  const upstream = net.connect(echo.address().port);
+  upstream.on('pipe', common.mustCall((src) => {
+    assert.strictEqual(src, client);
+  }));
+  assert.strictEqual(client.pipe(upstream, { native: true }), upstream);
+  upstream.pipe(client, { native: true });
+  client.on('end', common.mustCall());
+  client.on('close', common.mustCall(() => {
+    assert.strictEqual(client.bytesRead, data.length);
+    assert.strictEqual(client.bytesWritten, data.length);
+    proxy.close();
+    echo.close();
+  }));
+}));
+
+echo.listen(0, common.mustCall(() => {
+  proxy.listen(0, common.mustCall(() => {
+    const socket = net.connect(proxy.address().port);
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      assert.ok(Buffer.concat(chunks).equals(data));
+    }));
+    socket.end(data);
+
+    // Let the proxy run into backpressure before reading anything.
+    socket.pause();
+    setTimeout(() => socket.resume(), 100);
+  }));
+}));
+
+// Writes from JS are not mixed with piped data, and after unpipe() and
+// pause() the rest of the data is read from JS again.
+{
+  const marker = Buffer.from('--marker--');
+  const sink = net.createServer(common.mustCall((socket) => {
+    const chunks = [];
+    socket.on('data', (chunk) => chunks.push(chunk));
+    socket.on('end', common.mustCall(() => {
+      const received = Buffer.concat(chunks);
+      const at = received.indexOf(marker);
+      assert.ok(at >= 0);
+      assert.ok(Buffer.concat([
+        received.slice(0, at),
+        received.slice(at + marker.length)
+      ]).equals(data));
+      sink.close();
+    }));
+  }));
+
+  const source = net.createServer(common.mustCall((socket) => {
+    const dest = net.connect(sink.address().port);
+    dest.on('unpipe', common.mustCall());
+    socket.pipe(dest, { native: true });
+    setTimeout(common.mustCall(() => {
+      socket.pause();
+      dest.write(marker);
+      socket.unpipe(dest);
+      socket.on('data', (chunk) => dest.write(chunk));
+      socket.on('end', common.mustCall(() => {
+        dest.end();
+        source.close();
+      }));
+    }), 50);
+  }));
+
+  sink.listen(0, common.mustCall(() => {
+    source.listen(0, common.mustCall(() => {
+      net.connect(source.address().port).end(data);
+    }));
+  }));
+}
@@ -0,0 +1,64 @@
+// Flags: --expose-internals
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const net = require('net');
+const { kTimeout, WheelTimeout } = require('internal/timers');
+
+// Socket idle timeouts live on the native timer wheel, which never keeps the
+// process alive, so every test uses a regular timer for that.
+
+{
+  const socket = new net.Socket();
+  const keepAlive = setTimeout(common.mustNotCall(), 10000);
+  const msecs = common.platformTimeout(500);
+  let refreshes = 0;
+
+  // The timeout only fires once the refreshes have stopped.
+  socket.setTimeout(msecs, common.mustCall(() => {
+    assert.strictEqual(refreshes, 10);
+    clearTimeout(keepAlive);
+  }));
+  assert(socket[kTimeout] instanceof WheelTimeout);
+  assert.strictEqual(socket[kTimeout]._idleTimeout, msecs);
+  assert.strictEqual(socket[kTimeout].hasRef(), false);
+
+  // Keep refreshing the timeout for a while before letting it fire.
+  const interval = setInterval(() => {
+    const idleStart = socket[kTimeout]._idleStart;
+    socket._unrefTimer();
+    assert(socket[kTimeout]._idleStart >= idleStart);
+    if (++refreshes === 10)
+      clearInterval(interval);
+  }, 10);
+}
+
+{
+  const socket = new net.Socket();
+  socket.setTimeout(10, common.mustNotCall());
+  const timeout = socket[kTimeout];
+  socket.setTimeout(0);
+  assert.strictEqual(timeout._idleTimeout, -1);
+  setTimeout(common.mustCall(), 50);
+}
+
+{
+  // Many timeouts with different durations all fire exactly once, in the
+  // order in which they expire.
+  const count = 500;
+  const keepAlive = setTimeout(common.mustNotCall(), 10000);
+  let fired = 0;
+  let lastExpiry = 0;
+  for (let i = 0; i < count; i++) {
+    const socket = new net.Socket();
+    const msecs = 1 + (i * 7) % 300;
+    socket.setTimeout(msecs, common.mustCall(() => {
+      assert(expiry >= lastExpiry);
+      lastExpiry = expiry;
+      if (++fired === count)
+        clearTimeout(keepAlive);
+    }));
+    const expiry = socket[kTimeout]._idleStart + msecs;
+  }
+}
@@ -0,0 +1,42 @@
+'use strict';
+const common = require('../common');
+
+// Large writes on sockets with zero-copy sends enabled complete only once the
+// kernel is done with the buffers. Check that the data arrives intact and
+// that the write callbacks still come in order, also for a small write that
+// is copied as usual between two large ones.
+
+const assert = require('assert');
+const net = require('net');
+
+const data = Buffer.allocUnsafe(2 * 1024 * 1024 + 100);
+for (let i = 0; i < data.length; i++)
+  data[i] = i % 251;
+
+assert.throws(() => new net.Socket().setZeroCopy(true, -1), {
+  code: 'ERR_OUT_OF_RANGE'
+});
+
+const server = net.createServer(common.mustCall((socket) => {
+  const chunks = [];
+  socket.on('data', (chunk) => chunks.push(chunk));
+  socket.on('end', common.mustCall(() => {
+    assert.ok(Buffer.concat(chunks).equals(data));
+    server.close();
+  }));
+}));
+
+server.listen(0, common.mustCall(() => {
+  const socket = net.connect(server.address().port);
+  assert.strictEqual(socket.setZeroCopy(), socket);
+
+  const order = [];
+  const large = 1024 * 1024;
+  socket.write(data.slice(0, large), common.mustCall(() => order.push(0)));
+  socket.write(data.slice(large, large + 100),
+               common.mustCall(() => order.push(1)));
+  socket.write(data.slice(large + 100), common.mustCall(() => order.push(2)));
+  socket.end(common.mustCall(() => {
+    assert.deepStrictEqual(order, [0, 1, 2]);
+  }));
+}));
@@ -0,0 +1,56 @@
+'use strict';
+
+const common = require('../common');
+const assert = require('assert');
+const { performance } = require('perf_hooks');
+
+// The event loop has not started yet.
+assert.deepStrictEqual(performance.eventLoopUtilization(),
+                       { idle: 0, active: 0, utilization: 0 });
+assert.strictEqual(typeof performance.nodeTiming.idleTime, 'number');
+
+[null, 1, 'foo', true].forEach((i) => {
+  common.expectsError(() => performance.eventLoopUtilization(i), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+});
+
+function spin(ms) {
+  const start = Date.now();
+  while (Date.now() - start < ms);
+}
+
+setTimeout(common.mustCall(() => {
+  const elu1 = performance.eventLoopUtilization();
+  assert(elu1.idle >= 0);
+  assert(elu1.active > 0);
+  assert.strictEqual(elu1.utilization, elu1.active / (elu1.idle + elu1.active));
+  assert.strictEqual(performance.nodeTiming.idleTime >= elu1.idle, true);
+
+  // Mostly idle.
+  setTimeout(common.mustCall(() => {
+    const elu2 = performance.eventLoopUtilization(elu1);
+    assert(elu2.idle >= 100, `idle: ${elu2.idle}`);
+    assert(elu2.utilization < 1);
+
+    // Mostly busy.
+    spin(200);
+    setImmediate(common.mustCall(() => {
+      const elu3 = performance.eventLoopUtilization(elu1);
+      assert(elu3.active - elu2.active >= 200,
+             `active: ${elu3.active - elu2.active}`);
+      assert(elu3.utilization > elu2.utilization);
+
+      const phases = performance.eventLoopPhases();
+      assert(phases.iterations > 0);
+      assert.deepStrictEqual(Object.keys(phases), [
+        'iterations', 'timers', 'pending', 'prepare', 'pollWait', 'poll',
+        'check', 'closing'
+      ]);
+      // The spin above ran in a timer callback.
+      assert(phases.timers >= 200, `timers: ${phases.timers}`);
+      assert(Math.abs(phases.pollWait - performance.nodeTiming.idleTime) < 1);
+    }));
+  }), 150);
+}), 10);
@@ -0,0 +1,56 @@
+'use strict';
+
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fs = require('fs');
+const zlib = require('zlib');
+const { threadpoolMetrics } = require('perf_hooks');
+
+[null, 1, 'foo'].forEach((i) => {
+  common.expectsError(() => threadpoolMetrics(i), {
+    code: 'ERR_INVALID_ARG_TYPE',
+    type: TypeError
+  });
+});
+common.expectsError(() => threadpoolMetrics({ reset: 1 }), {
+  code: 'ERR_INVALID_ARG_TYPE',
+  type: TypeError
+});
+
+assert.deepStrictEqual(threadpoolMetrics(), {});
+
+function checkStats(stats) {
+  for (const key of ['min', 'max', 'mean', 'stddev', 'p50', 'p90', 'p99'])
+    assert.strictEqual(typeof stats[key], 'number', key);
+  assert(stats.min >= 0);
+  assert(stats.min <= stats.p50);
+  assert(stats.p50 <= stats.p99);
+  assert(stats.p99 <= stats.max);
+}
+
+let pending = 3;
+const done = common.mustCall(() => {
+  if (--pending > 0)
+    return;
+
+  const metrics = threadpoolMetrics({ reset: true });
+  for (const name of ['open', 'pbkdf2', 'zlib']) {
+    assert(metrics[name], name);
+    assert(metrics[name].count >= 1, name);
+    checkStats(metrics[name].queueWait);
+    checkStats(metrics[name].runTime);
+  }
+  assert.deepStrictEqual(threadpoolMetrics(), {});
+}, 3);
+
+fs.open(__filename, 'r', common.mustCall((err, fd) => {
+  assert.ifError(err);
+  fs.closeSync(fd);
+  done();
+}));
+crypto.pbkdf2('secret', 'salt', 1000, 32, 'sha256', common.mustCall(done));
+zlib.deflate('hello', common.mustCall(done));
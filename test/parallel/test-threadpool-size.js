@@ -0,0 +1,50 @@
+'use strict';
+const common = require('../common');
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// Work in a threadpool of its own must not hold up work in the other pools.
+
+const assert = require('assert');
+const crypto = require('crypto');
+const fs = require('fs');
+const { spawnSync } = require('child_process');
+
+if (process.argv[2] === 'child') {
+  // The crypto jobs are queued before the stat. If they shared the single
+  // thread with it, the stat would only run after all of them.
+  const jobs = 16;
+  let pending = jobs;
+  for (let i = 0; i < jobs; i++) {
+    crypto.pbkdf2('password', 'salt', 1e4, 64, 'sha512', common.mustCall(() => {
+      pending--;
+    }));
+  }
+  fs.stat(__filename, common.mustCall((err) => {
+    assert.ifError(err);
+    assert.ok(pending > 0);
+  }));
+  return;
+}
+
+{
+  const child = spawnSync(process.execPath, [
+    '--threadpool-size=default:1,crypto:1',
+    __filename,
+    'child'
+  ]);
+  assert.strictEqual(child.stderr.toString(), '');
+  assert.strictEqual(child.status, 0);
+}
+
+for (const value of ['crypto', 'crypto:', 'crypto:0', 'crypto:x',
+                     'crypto:1000', 'bogus:2', 'fs:2,dns']) {
+  const child = spawnSync(process.execPath, [
+    `--threadpool-size=${value}`,
+    '-e',
+    '0'
+  ]);
+  assert.strictEqual(child.status, 9);
+  assert.ok(child.stderr.toString().includes(
+    'invalid value for --threadpool-size'));
+}
@@ -0,0 +1,79 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// The buffers of TLS sockets are blocks from a shared pool. Blocks must be
+// given back as soon as a socket has nothing left to read or write, so that
+// idle connections hold none, and they must be reused by later connections.
+
+const assert = require('assert');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+const { internalBinding } = require('internal/test/binding');
+const {
+  getBIOBufferPoolStats,
+  kBIOBufferPoolFields
+} = internalBinding('tls_wrap');
+
+function getStats() {
+  const fields = new Float64Array(kBIOBufferPoolFields);
+  getBIOBufferPoolStats(fields);
+  return {
+    allocations: fields[0],
+    reuses: fields[1],
+    releases: fields[2],
+    frees: fields[3],
+    inUse: fields[4],
+    free: fields[5]
+  };
+}
+
+const kSockets = 10;
+const payload = Buffer.alloc(64 * 1024, 'x');
+const before = getStats();
+const clients = [];
+
+const server = tls.createServer({
+  key: fixtures.readKey('agent2-key.pem'),
+  cert: fixtures.readKey('agent2-cert.pem')
+}, common.mustCall((socket) => {
+  socket.pipe(socket);
+}, kSockets));
+
+server.listen(0, common.mustCall(() => {
+  let echoed = 0;
+  for (let i = 0; i < kSockets; i++) {
+    const client = tls.connect({
+      port: server.address().port,
+      rejectUnauthorized: false
+    }, common.mustCall(() => {
+      client.write(payload);
+    }));
+    clients.push(client);
+
+    let received = 0;
+    client.on('data', (chunk) => {
+      received += chunk.length;
+      if (received === payload.length && ++echoed === kSockets)
+        setImmediate(check);
+    });
+  }
+}));
+
+function check() {
+  // Every connection is open, but idle.
+  const after = getStats();
+  assert.ok(after.allocations > before.allocations);
+  assert.ok(after.reuses > before.reuses);
+  assert.strictEqual(after.allocations - before.allocations,
+                     after.releases - before.releases);
+  assert.strictEqual(after.inUse, before.inUse);
+  assert.ok(after.free <= 64);
+
+  for (const client of clients)
+    client.end();
+  server.close();
+}
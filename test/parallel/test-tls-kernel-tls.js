@@ -0,0 +1,85 @@
+// Flags: --expose-internals
+'use strict';
+const common = require('../common');
+
+if (!common.hasCrypto)
+  common.skip('missing crypto');
+
+// With the `kernelTLS` option, data must flow the same way whether or not the
+// kernel takes over the encryption of outgoing records. The offload is only
+// possible with AES-GCM cipher suites, so it must never be active otherwise.
+
+const assert = require('assert');
+const fs = require('fs');
+const tls = require('tls');
+const fixtures = require('../common/fixtures');
+const { internalBinding } = require('internal/test/binding');
+const { haveKernelTLS } = internalBinding('tls_wrap');
+
+// The `tls` ULP can be attached to sockets once the kernel lists it. Every
+// kernel that does supports AES-128-GCM, AES-256-GCM needs a newer one.
+const kernelHasTLS = (() => {
+  if (!haveKernelTLS)
+    return false;
+  try {
+    return fs.readFileSync('/proc/sys/net/ipv4/tcp_available_ulp', 'latin1')
+      .split(/\s+/).includes('tls');
+  } catch {
+    return false;
+  }
+})();
+
+const payload = Buffer.alloc(256 * 1024);
+for (let i = 0; i < payload.length; i++)
+  payload[i] = i % 251;
+
+// `offload` is 'expected' if the kernel must encrypt the records on hosts
+// that support it, 'possible' if it may, and 'never' otherwise.
+function test(ciphers, offload, next) {
+  const check = (active) => {
+    if (offload === 'never')
+      assert.strictEqual(active, false);
+    else if (offload === 'expected' && kernelHasTLS)
+      assert.strictEqual(active, true);
+    else
+      assert.strictEqual(typeof active, 'boolean');
+  };
+
+  const server = tls.createServer({
+    key: fixtures.readKey('agent2-key.pem'),
+    cert: fixtures.readKey('agent2-cert.pem'),
+    ciphers,
+    kernelTLS: true
+  }, common.mustCall((socket) => {
+    socket.pipe(socket);
+    socket.on('end', common.mustCall(() => {
+      check(socket.isKernelTLSActive());
+    }));
+  }));
+
+  server.listen(0, common.mustCall(() => {
+    const client = tls.connect({
+      port: server.address().port,
+      ciphers,
+      rejectUnauthorized: false,
+      kernelTLS: true
+    }, common.mustCall(() => {
+      assert.strictEqual(client.getCipher().name, ciphers);
+      client.end(payload);
+    }));
+
+    const chunks = [];
+    client.on('data', (chunk) => chunks.push(chunk));
+    client.on('end', common.mustCall(() => {
+      assert.deepStrictEqual(Buffer.concat(chunks), payload);
+      check(client.isKernelTLSActive());
+      server.close(next);
+    }));
+  }));
+}
+
+test('ECDHE-RSA-AES128-GCM-SHA256', 'expected', common.mustCall(() => {
+  test('AES256-GCM-SHA384', 'possible', common.mustCall(() => {
+    test('AES128-SHA256', 'never', common.mustCall());
+  }));
+}));
@@ -0,0 +1,51 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cp = require('child_process');
+const fs = require('fs');
+const path = require('path');
+const tmpdir = require('../common/tmpdir');
+
+const phases = [
+  'timers', 'pending', 'prepare', 'pollWait', 'poll', 'check', 'closing'
+];
+
+if (process.argv[2] === 'child') {
+  let n = 0;
+  const timer = setInterval(() => {
+    if (++n === 5)
+      clearInterval(timer);
+  }, 1);
+} else {
+  tmpdir.refresh();
+
+  const proc = cp.fork(__filename,
+                       [ 'child' ], {
+                         cwd: tmpdir.path,
+                         execArgv: [
+                           '--trace-event-categories',
+                           'node.perf.event_loop'
+                         ]
+                       });
+
+  proc.once('exit', common.mustCall(() => {
+    const file = path.join(tmpdir.path, 'node_trace.1.log');
+
+    assert(fs.existsSync(file));
+    fs.readFile(file, common.mustCall((err, data) => {
+      const traces = JSON.parse(data.toString()).traceEvents
+        .filter((trace) => trace.cat !== '__metadata');
+      assert(traces.length >= 5);
+      let last = 0;
+      traces.forEach((trace) => {
+        assert.strictEqual(trace.pid, proc.pid);
+        assert.strictEqual(trace.name, 'LoopIteration');
+        assert.strictEqual(trace.ph, 'I');
+        const data = trace.args.data;
+        assert(data.iteration > last);
+        last = data.iteration;
+        phases.forEach((phase) => assert(data[phase] >= 0));
+      });
+    }));
+  }));
+}
@@ -100,6 +100,12 @@ function testInitialized(req, ctor_name) {
 }
 
 
+{
+  const { ELDHistogram } = internalBinding('performance');
+  testInitialized(new ELDHistogram(1), 'ELDHistogram');
+}
+
+
 {
   // We don't want to expose getAsyncId for promises but we need to construct
   // one so that the corresponding provider type is removed from the